@@ -0,0 +1,171 @@
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+#include "utils/types.h"
+
+#include "scored_cloud_file.h"
+
+namespace rcsop::bench {
+    using rcsop::common::ScoredPoint;
+    using rcsop::common::ScoredCloudFile;
+    using rcsop::common::SCORED_CLOUD_EXTENSION;
+    using rcsop::common::utils::points::point_id_t;
+
+    const static string OPTION_MAX_DB_ERROR = "--max-db-error=";
+
+    struct cloud_difference {
+        size_t compared = 0;
+        size_t only_in_reference = 0;
+        size_t only_in_candidate = 0;
+        double max_db_error = 0;
+        double sum_db_error = 0;
+        double max_position_error = 0;
+
+        void add(const cloud_difference& other) {
+            compared += other.compared;
+            only_in_reference += other.only_in_reference;
+            only_in_candidate += other.only_in_candidate;
+            max_db_error = std::max(max_db_error, other.max_db_error);
+            sum_db_error += other.sum_db_error;
+            max_position_error = std::max(max_position_error, other.max_position_error);
+        }
+
+        [[nodiscard]] double mean_db_error() const {
+            return compared == 0 ? 0 : sum_db_error / static_cast<double>(compared);
+        }
+    };
+
+    /**
+     * Points are matched by their id and the number of earlier points with the same id, the projected data
+     * points of different labels share ids. Points crossing the dB threshold in only one of the runs are counted
+     * instead of being compared.
+     */
+    static auto compare_clouds(const vector<ScoredPoint>& reference,
+                               const vector<ScoredPoint>& candidate) -> cloud_difference {
+        using point_key = pair<point_id_t, size_t>;
+        auto key_points = [](const vector<ScoredPoint>& points) {
+            std::map<point_id_t, size_t> occurrences;
+            std::map<point_key, const ScoredPoint*> result;
+            for (const auto& point: points) {
+                result.emplace(point_key{point.id(), occurrences[point.id()]++}, &point);
+            }
+            return result;
+        };
+        const auto reference_points = key_points(reference);
+        auto candidate_points = key_points(candidate);
+
+        cloud_difference difference;
+        for (const auto& [key, reference_point]: reference_points) {
+            const auto candidate_point = candidate_points.find(key);
+            if (candidate_point == candidate_points.end()) {
+                difference.only_in_reference++;
+                continue;
+            }
+            const double db_error = std::abs(reference_point->score_to_dB() - candidate_point->second->score_to_dB());
+            const double position_error = (reference_point->position() - candidate_point->second->position()).norm();
+            difference.compared++;
+            difference.sum_db_error += db_error;
+            difference.max_db_error = std::max(difference.max_db_error, db_error);
+            difference.max_position_error = std::max(difference.max_position_error, position_error);
+            candidate_points.erase(candidate_point);
+        }
+        difference.only_in_candidate = candidate_points.size();
+        return difference;
+    }
+
+    static void print_difference(const string& name, const cloud_difference& difference) {
+        std::cout << std::left << std::setw(24) << name << std::right
+                  << std::setw(10) << difference.compared
+                  << std::setw(10) << difference.only_in_reference
+                  << std::setw(10) << difference.only_in_candidate
+                  << std::setw(14) << std::scientific << std::setprecision(3) << difference.max_db_error
+                  << std::setw(14) << difference.mean_db_error()
+                  << std::setw(14) << difference.max_position_error
+                  << std::defaultfloat << std::endl;
+    }
+
+    static auto scored_cloud_files(const path& folder) -> vector<path> {
+        if (!is_directory(folder)) {
+            throw invalid_argument("Scored cloud folder " + folder.string() + " does not exist.");
+        }
+        vector<path> result;
+        for (const auto& entry: std::filesystem::directory_iterator(folder)) {
+            if (entry.is_regular_file() && entry.path().extension() == SCORED_CLOUD_EXTENSION) {
+                result.push_back(entry.path());
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    /**
+     * Compares two folders of scored cloud files, usually written by rcsop-bench --scored-reference from a
+     * default and a RCSOP_FLOAT_STORAGE build, and prints the score and position differences per file.
+     * Fails if a file is missing in the candidate or if the largest dB difference exceeds --max-db-error.
+     */
+    static auto run(int argc, char** argv) -> int {
+        vector<path> folders;
+        optional<double> max_allowed_db_error;
+        for (int i = 1; i < argc; i++) {
+            const string argument{argv[i]};
+            if (argument.starts_with(OPTION_MAX_DB_ERROR)) {
+                max_allowed_db_error = std::stod(argument.substr(OPTION_MAX_DB_ERROR.size()));
+            } else {
+                folders.emplace_back(argument);
+            }
+        }
+        if (folders.size() != 2) {
+            std::cerr << "Usage: " << argv[0] << " <reference folder> <candidate folder> [" << OPTION_MAX_DB_ERROR
+                      << "<dB>]" << std::endl;
+            return 2;
+        }
+        const auto& reference_folder = folders[0];
+        const auto& candidate_folder = folders[1];
+
+        std::cout << std::left << std::setw(24) << "file" << std::right
+                  << std::setw(10) << "compared"
+                  << std::setw(10) << "ref only"
+                  << std::setw(10) << "cand only"
+                  << std::setw(14) << "max |dB|"
+                  << std::setw(14) << "mean |dB|"
+                  << std::setw(14) << "max position" << std::endl;
+
+        cloud_difference total;
+        bool missing_files = false;
+        for (const auto& reference_path: scored_cloud_files(reference_folder)) {
+            const auto name = reference_path.filename();
+            const auto candidate_path = candidate_folder / name;
+            if (!exists(candidate_path)) {
+                std::cerr << "Missing in the candidate: " << name.string() << std::endl;
+                missing_files = true;
+                continue;
+            }
+            const auto reference = ScoredCloudFile(reference_path).points();
+            const auto candidate = ScoredCloudFile(candidate_path).points();
+            const auto difference = compare_clouds(*reference, *candidate);
+            print_difference(name.string(), difference);
+            total.add(difference);
+        }
+        print_difference("total", total);
+
+        if (missing_files) {
+            return 1;
+        }
+        if (max_allowed_db_error.has_value() && total.max_db_error > *max_allowed_db_error) {
+            std::cerr << "Largest dB difference " << total.max_db_error << " exceeds " << *max_allowed_db_error
+                      << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        return rcsop::bench::run(argc, argv);
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,702 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <unistd.h>
+
+#include "utils/types.h"
+#include "utils/gauss.h"
+#include "utils/point_scoring.h"
+#include "utils/task_utils.h"
+#include "utils/memory.h"
+#include "utils/scratch_arena.h"
+#include "utils/executor.h"
+
+#include "colors.h"
+#include "scored_cloud_file.h"
+#include "observer_provider.h"
+#include "data_point_projector.h"
+#include "model_writer.h"
+#include "observer_renderer.h"
+#include "render_pipeline.h"
+
+#include "synthetic_dataset.h"
+
+namespace rcsop::bench {
+    using rcsop::common::Observer;
+    using rcsop::common::ScoredCloud;
+    using rcsop::common::multiple_scored_cloud_payload;
+    using rcsop::common::scored_cloud_payload;
+    using rcsop::common::ScoredPoint;
+    using rcsop::common::ScoredCloudFile;
+    using rcsop::common::write_scored_cloud;
+    using rcsop::common::utils::points::storage_scalar_t;
+    using rcsop::common::coloring::construct_color_map_function;
+    using rcsop::common::coloring::resolve_map_by_name;
+    using rcsop::common::utils::gauss::VerticalGaussKernel;
+    using rcsop::common::utils::gauss::gauss;
+    using rcsop::common::utils::gauss::gauss_options;
+    using rcsop::common::utils::gauss::get_gauss_integral_factor;
+    using rcsop::common::observed_point;
+    using rcsop::common::utils::memory::memory_usage;
+    using rcsop::common::utils::memory::current_memory_usage;
+    using rcsop::common::utils::memory::is_allocation_tracking_available;
+    using rcsop::common::utils::memory::set_scratch_arenas_enabled;
+    using rcsop::common::utils::parallel::configure_executor;
+    using rcsop::common::utils::parallel::nesting_policy;
+    using rcsop::common::utils::parallel::thread_count;
+
+    using rcsop::data::InputDataCollector;
+    using rcsop::data::ObserverProvider;
+    using rcsop::data::DataPointProjector;
+    using rcsop::data::projection_options;
+    using rcsop::data::AzimuthRcsDataCollection;
+    using rcsop::data::SPARSE_POINTS_COLMAP;
+    using rcsop::data::DENSE_MESH_PLY;
+    using rcsop::data::AZIMUTH_RCS_MAT;
+    using rcsop::data::AZIMUTH_RCS_MINIMAP;
+
+    using rcsop::rendering::ObserverRenderer;
+    using rcsop::rendering::texture_rendering_options;
+    using rcsop::rendering::render_job;
+    using rcsop::rendering::render_pipelined;
+
+    using rcsop::launcher::utils::task_options;
+    using rcsop::launcher::utils::data_with_observer_options;
+    using rcsop::launcher::utils::score_points;
+    using rcsop::launcher::utils::score_points_with_peaks;
+    using rcsop::launcher::utils::map_labeled_data;
+    using rcsop::launcher::utils::accumulation_source;
+    using rcsop::launcher::utils::accumulate_scores;
+    using rcsop::launcher::utils::PointGenerator;
+    using rcsop::launcher::utils::OutputFormat;
+
+    const static string OPTION_POINTS = "--synthetic-points=";
+    const static string OPTION_AZIMUTHS = "--synthetic-azimuths=";
+    const static string OPTION_MESH_RINGS = "--synthetic-mesh-rings=";
+    const static string OPTION_IMAGE_SIZE = "--synthetic-image-size=";
+    const static string OPTION_LABELS = "--synthetic-labels=";
+    const static string OPTION_VERBOSE = "--verbose";
+    const static string OPTION_SCORED_REFERENCE = "--scored-reference=";
+
+    const static string DEFAULT_JSON_OUTPUT = "rcsop-bench.json";
+
+    constexpr double SKEWED_WORK_RATIO = 16.;
+    constexpr size_t SKEWED_CHUNK_SIZE = 8192;
+
+    static unique_ptr<SyntheticDataset> dataset = nullptr;
+    static unique_ptr<SyntheticDataset> skewed_dataset = nullptr;
+
+    static auto bench_task_options(PointGenerator point_generator,
+                                   const SyntheticDataset& source) -> task_options {
+        return {
+                .task_name = "bench",
+                .input_path = source.root_path(),
+                .output_path = source.root_path() / "output",
+                .prefilter_data = true,
+                .vertical_options = {
+                        .angle_spread = 5.0,
+                        .normal_variance = M_2_SQRTPI * M_SQRT1_2 / 2,
+                },
+                .point_generator = point_generator,
+                .point_density = 3,
+                .db_range = {.min = -20., .max = 5.},
+                .camera = {
+                        .pitch_correction = 0.,
+                        .distance_to_origin = source.options().camera_distance_cm,
+                        .default_height = source.options().heights.front(),
+                },
+                .rendering = {
+                        .use_gpu_rendering = false,
+                        .color_map = resolve_map_by_name("jet"),
+                        .gradient = {.radius = 15., .center_alpha = 0.3},
+                },
+                .output_format = OutputFormat::BOTH,
+        };
+    }
+
+    static auto bench_task_options(PointGenerator point_generator) -> task_options {
+        return bench_task_options(point_generator, *dataset);
+    }
+
+    static auto collect_inputs(const task_options& options) -> InputDataCollector {
+        return {options.input_path, options.camera};
+    }
+
+    static auto labeled_data(const InputDataCollector& inputs) -> vector<data_with_observer_options> {
+        const auto azimuth_data = inputs.data<AZIMUTH_RCS_MAT, true>();
+        for (const auto& [_, data_set]: azimuth_data) {
+            data_set->use_filtered_peaks();
+        }
+        return map_labeled_data(azimuth_data);
+    }
+
+    /**
+     * Scoring result shared by all writer benchmarks, computed once on first use.
+     */
+    static auto shared_scored_payload() -> const multiple_scored_cloud_payload& {
+        static shared_ptr<multiple_scored_cloud_payload const> payload = nullptr;
+        if (payload == nullptr) {
+            const auto options = bench_task_options(PointGenerator::MODEL_WITH_PROJECTION);
+            const auto inputs = collect_inputs(options);
+            const auto color_map = construct_color_map_function(options.rendering.color_map, options.db_range);
+            payload = score_points(inputs, labeled_data(inputs), options, color_map);
+        }
+        return *payload;
+    }
+
+    static auto point_count(const multiple_scored_cloud_payload& payload) -> int64_t {
+        int64_t result = 0;
+        for (const auto& cloud: payload.point_clouds) {
+            result += static_cast<int64_t>(cloud.points()->size());
+        }
+        return result;
+    }
+
+    static void BM_CollectInputs(benchmark::State& state) {
+        const auto options = bench_task_options(PointGenerator::MODEL_SPARSE);
+        for (auto _: state) {
+            auto inputs = collect_inputs(options);
+            benchmark::DoNotOptimize(inputs.images());
+        }
+    }
+
+    static void BM_LoadSparseModel(benchmark::State& state) {
+        const auto options = bench_task_options(PointGenerator::MODEL_SPARSE);
+        const auto inputs = collect_inputs(options);
+        for (auto _: state) {
+            auto model = inputs.data<SPARSE_POINTS_COLMAP>();
+            benchmark::DoNotOptimize(model->point_count());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(dataset->options().sparse_point_count));
+    }
+
+    static void BM_LoadDenseMesh(benchmark::State& state) {
+        const auto options = bench_task_options(PointGenerator::MODEL_DENSE);
+        const auto inputs = collect_inputs(options);
+        size_t vertices = 0;
+        for (auto _: state) {
+            auto mesh = inputs.data<DENSE_MESH_PLY>();
+            vertices = mesh->point_count();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(vertices));
+    }
+
+    static void BM_LoadAzimuthData(benchmark::State& state) {
+        const auto options = bench_task_options(PointGenerator::DATA_PROJECTION);
+        const auto inputs = collect_inputs(options);
+        for (auto _: state) {
+            auto data = inputs.data<AZIMUTH_RCS_MAT, true>();
+            benchmark::DoNotOptimize(data.size());
+        }
+    }
+
+    static void BM_ObserverProvider(benchmark::State& state) {
+        const auto options = bench_task_options(PointGenerator::MODEL_SPARSE);
+        const auto inputs = collect_inputs(options);
+        for (auto _: state) {
+            ObserverProvider provider(inputs, options.camera, true);
+            benchmark::DoNotOptimize(provider.observers_with_positions());
+        }
+    }
+
+    static void BM_ScorePoints(benchmark::State& state) {
+        const auto options = bench_task_options(static_cast<PointGenerator>(state.range(0)));
+        const auto inputs = collect_inputs(options);
+        const auto data = labeled_data(inputs);
+        const auto color_map = construct_color_map_function(options.rendering.color_map, options.db_range);
+
+        int64_t scored_points = 0;
+        for (auto _: state) {
+            auto payload = score_points(inputs, data, options, color_map);
+            scored_points = point_count(*payload);
+        }
+        state.counters["scored_points"] = static_cast<double>(scored_points);
+        state.counters["payload_bytes"] = static_cast<double>(scored_points * sizeof(ScoredPoint));
+        state.SetItemsProcessed(state.iterations() * scored_points);
+    }
+
+    /**
+     * Raw and peak filtered payloads in one pass, compare with two runs of BM_ScorePoints.
+     */
+    static void BM_ScorePointsWithPeaks(benchmark::State& state) {
+        const auto options = bench_task_options(static_cast<PointGenerator>(state.range(0)));
+        const auto inputs = collect_inputs(options);
+        const auto data = labeled_data(inputs);
+        const auto color_map = construct_color_map_function(options.rendering.color_map, options.db_range);
+
+        int64_t scored_points = 0;
+        for (auto _: state) {
+            auto [raw, peaks] = score_points_with_peaks(inputs, data, options, color_map);
+            scored_points = point_count(*raw) + point_count(*peaks);
+        }
+        state.counters["scored_points"] = static_cast<double>(scored_points);
+        state.SetItemsProcessed(state.iterations() * scored_points);
+    }
+
+    static void BM_AccumulateScores(benchmark::State& state) {
+        const auto options = bench_task_options(PointGenerator::FULL_MODEL);
+        const auto inputs = collect_inputs(options);
+        const auto data = labeled_data(inputs);
+        const ObserverProvider provider(inputs, options.camera, true);
+        const gauss_options distribution{
+                .sigma = 0.2,
+                .integral_factor = get_gauss_integral_factor(0.2),
+                .x_scale = 12.5,
+                .y_scale = 7.5,
+        };
+
+        vector<accumulation_source> sources;
+        for (const auto& observer: provider.observers_with_positions()) {
+            for (const auto& [observer_options, data_collection]: data) {
+                const auto* data_set = data_collection->get_for_exact_position(observer);
+                sources.push_back({
+                        .observer = observer.clone_with_data(observer_options),
+                        .value_func = [data_set](const observed_point& point) {
+                            return data_set->map_to_nearest(point);
+                        },
+                });
+            }
+        }
+
+        int64_t scored_points = 0;
+        for (auto _: state) {
+            scored_points = static_cast<int64_t>(accumulate_scores(inputs, sources, options, distribution)->size());
+        }
+        state.counters["sources"] = static_cast<double>(sources.size());
+        state.counters["scored_points"] = static_cast<double>(scored_points);
+        state.SetItemsProcessed(state.iterations() * scored_points);
+    }
+
+    /**
+     * Vertical weight per observed point, arg 0 evaluates gauss() directly, arg 1 uses the table.
+     */
+    static void BM_VerticalWeights(benchmark::State& state) {
+        const auto options = bench_task_options(PointGenerator::MODEL_SPARSE);
+        const auto spread = options.vertical_options.angle_spread;
+        const auto sigma = options.vertical_options.normal_variance;
+        const VerticalGaussKernel vertical_weights(spread, sigma, spread);
+
+        vector<observed_point> points(1 << 16);
+        for (size_t i = 0; i < points.size(); i++) {
+            points[i].vertical_angle = -spread + 2 * spread * static_cast<double>(i) / static_cast<double>(points.size());
+        }
+
+        const bool tabulated = state.range(0) != 0;
+        for (auto _: state) {
+            double sum = 0;
+            for (const auto& point: points) {
+                sum += tabulated ? vertical_weights(point) : gauss(point.vertical_angle / spread * 2, sigma);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+    }
+
+    static void BM_ProjectData(benchmark::State& state) {
+        const auto options = bench_task_options(PointGenerator::DATA_PROJECTION);
+        const auto inputs = collect_inputs(options);
+        const auto data = labeled_data(inputs);
+        const ObserverProvider provider(inputs, options.camera, true);
+        const auto observer = provider.observers_with_positions().front();
+        const auto* data_set = data.front().data_collection->get_for_exact_position(observer);
+
+        const VerticalGaussKernel vertical_weights(options.vertical_options.angle_spread,
+                                                   options.vertical_options.normal_variance,
+                                                   options.vertical_options.angle_spread);
+        const projection_options projection_params{
+                .db_filter = [](double) { return true; },
+                .vertical_weights = vertical_weights,
+                .vertical_angle_limit = options.vertical_options.angle_spread,
+                .steps_per_angle = static_cast<size_t>(state.range(0)),
+        };
+        const DataPointProjector projector;
+
+        size_t projected_points = 0;
+        for (auto _: state) {
+            auto points = projector.project_data(data_set, observer, projection_params);
+            projected_points = points->size();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(projected_points));
+    }
+
+    /**
+     * Renders the first scored observer, argument 0 selects the cairo and 1 the SFML backend.
+     */
+    static void BM_RenderObserver(benchmark::State& state) {
+        auto options = bench_task_options(PointGenerator::MODEL_WITH_PROJECTION);
+        options.rendering.use_gpu_rendering = state.range(0) != 0;
+        const auto inputs = collect_inputs(options);
+        const auto minimaps = inputs.data<AZIMUTH_RCS_MINIMAP>();
+        const auto& payload = shared_scored_payload();
+        const auto& scored_cloud = payload.point_clouds.front();
+        const texture_rendering_options minimap_position = {
+                .coordinates = {915., 420.},
+                .size = {400., 300.},
+        };
+
+        const path output_path{options.output_path / "render"};
+        create_directories(output_path);
+        for (auto _: state) {
+            ObserverRenderer renderer(scored_cloud, payload.color_map, options.rendering,
+                                      options.camera.distance_to_origin);
+            renderer.add_texture(minimaps->for_position(scored_cloud.observer()), minimap_position);
+            try {
+                renderer.write(output_path, "");
+            } catch (const std::exception& e) {
+                state.SkipWithError(e.what());
+                break;
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(scored_cloud.points()->size()));
+    }
+
+    /**
+     * Renders the images of all scored observers one after the other (0) or through the render pipeline (1),
+     * cairo only.
+     */
+    static void BM_RenderPipeline(benchmark::State& state) {
+        auto options = bench_task_options(PointGenerator::MODEL_WITH_PROJECTION);
+        options.rendering.use_gpu_rendering = false;
+        const auto& payload = shared_scored_payload();
+        const path output_path{options.output_path / "render_pipeline"};
+        create_directories(output_path);
+
+        for (auto _: state) {
+            vector<render_job> jobs;
+            for (const auto& scored_cloud: payload.point_clouds) {
+                jobs.push_back({
+                        .renderer = make_shared<ObserverRenderer>(scored_cloud, payload.color_map, options.rendering,
+                                                                  options.camera.distance_to_origin),
+                        .output_path = output_path,
+                        .log_prefix = "",
+                });
+            }
+            if (state.range(0) != 0) {
+                render_pipelined(jobs);
+            } else {
+                for (const auto& job: jobs) {
+                    job.renderer->write(job.output_path, job.log_prefix);
+                }
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(payload.point_clouds.size()));
+        state.counters["images"] = static_cast<double>(payload.point_clouds.size());
+    }
+
+    static void BM_ModelWriter(benchmark::State& state) {
+        const auto options = bench_task_options(PointGenerator::MODEL_WITH_PROJECTION);
+        const auto inputs = collect_inputs(options);
+        const auto& payload = shared_scored_payload();
+        const auto single_payload = payload.extract_single_payloads().front();
+        const auto& observer = single_payload.point_cloud.observer();
+
+        const path output_path{options.output_path / "model"};
+        create_directories(output_path);
+        for (auto _: state) {
+            auto model_writer = inputs.get_model_writer();
+            model_writer->set_observer_position(observer.position(), observer.native_camera());
+            model_writer->add_points(single_payload);
+            model_writer->write(output_path, "");
+        }
+        state.SetItemsProcessed(state.iterations()
+                                * static_cast<int64_t>(single_payload.point_cloud.points()->size()));
+    }
+
+    /**
+     * Heap allocations per iteration since begin, only available if the bench is built with
+     * RCSOP_TRACK_ALLOCATIONS.
+     */
+    static void report_allocations(benchmark::State& state, const memory_usage& begin) {
+        if (!is_allocation_tracking_available() || state.iterations() == 0) {
+            return;
+        }
+        const auto end = current_memory_usage();
+        const auto iterations = static_cast<double>(state.iterations());
+        state.counters["allocations"] = static_cast<double>(end.allocation_count - begin.allocation_count)
+                                        / iterations;
+        state.counters["allocated_bytes"] = static_cast<double>(end.allocated_bytes - begin.allocated_bytes)
+                                            / iterations;
+    }
+
+    /**
+     * Scores all observers with the per-observer scratch arenas disabled (0) or enabled (1).
+     */
+    static void BM_ScoreAllocations(benchmark::State& state) {
+        const auto options = bench_task_options(PointGenerator::MODEL_WITH_PROJECTION);
+        const auto inputs = collect_inputs(options);
+        const auto data = labeled_data(inputs);
+        const auto color_map = construct_color_map_function(options.rendering.color_map, options.db_range);
+        set_scratch_arenas_enabled(state.range(0) != 0);
+        // the first run grows the arenas of the threads, the steady state is measured
+        benchmark::DoNotOptimize(score_points(inputs, data, options, color_map));
+
+        const auto begin = current_memory_usage();
+        for (auto _: state) {
+            benchmark::DoNotOptimize(score_points(inputs, data, options, color_map));
+        }
+        report_allocations(state, begin);
+        set_scratch_arenas_enabled(true);
+    }
+
+    /**
+     * Dense points scored with all points in memory (0) or streamed in chunks of the given size, the
+     * allocated bytes show the temporaries growing with the chunk size.
+     */
+    static void BM_ScorePointsChunked(benchmark::State& state) {
+        auto options = bench_task_options(PointGenerator::MODEL_DENSE);
+        options.chunk_size = static_cast<size_t>(state.range(0));
+        const auto inputs = collect_inputs(options);
+        const auto data = labeled_data(inputs);
+        const auto color_map = construct_color_map_function(options.rendering.color_map, options.db_range);
+
+        const auto begin = current_memory_usage();
+        int64_t scored_points = 0;
+        for (auto _: state) {
+            auto payload = score_points(inputs, data, options, color_map);
+            scored_points = point_count(*payload);
+        }
+        report_allocations(state, begin);
+        state.counters["scored_points"] = static_cast<double>(scored_points);
+        state.SetItemsProcessed(state.iterations() * scored_points);
+    }
+
+    /**
+     * Same dataset as all other benchmarks, but the data projected per observer falls off by SKEWED_WORK_RATIO
+     * from the first to the last observer. Scored with the nesting policy of the argument: points (0),
+     * observers (1) or tasks (2). The core utilization is the CPU time of the process over the wall time of all
+     * threads, threads idling at the end of unbalanced loops lower it.
+     */
+    static void BM_ScoreSkewed(benchmark::State& state) {
+        if (skewed_dataset == nullptr) {
+            auto skewed_options = dataset->options();
+            skewed_options.work_skew = SKEWED_WORK_RATIO;
+            skewed_dataset = make_unique<SyntheticDataset>(dataset->root_path().string() + "-skewed",
+                                                           skewed_options);
+        }
+        auto options = bench_task_options(PointGenerator::MODEL_WITH_PROJECTION, *skewed_dataset);
+        options.chunk_size = SKEWED_CHUNK_SIZE;
+        const auto inputs = collect_inputs(options);
+        const auto data = labeled_data(inputs);
+        const auto color_map = construct_color_map_function(options.rendering.color_map, options.db_range);
+        configure_executor({.nesting = static_cast<nesting_policy>(state.range(0))});
+
+        const auto cpu_begin = std::clock();
+        const auto wall_begin = std::chrono::steady_clock::now();
+        int64_t scored_points = 0;
+        for (auto _: state) {
+            auto payload = score_points(inputs, data, options, color_map);
+            scored_points = point_count(*payload);
+        }
+        const double cpu_seconds = static_cast<double>(std::clock() - cpu_begin) / CLOCKS_PER_SEC;
+        const std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - wall_begin;
+        state.counters["core_utilization"] = cpu_seconds / (wall_time.count() * static_cast<double>(thread_count()));
+        state.counters["scored_points"] = static_cast<double>(scored_points);
+        state.SetItemsProcessed(state.iterations() * scored_points);
+        configure_executor({});
+    }
+
+    /**
+     * Renders the first scored observer with the scratch arenas disabled (0) or enabled (1), cairo only.
+     */
+    static void BM_RenderAllocations(benchmark::State& state) {
+        auto options = bench_task_options(PointGenerator::MODEL_WITH_PROJECTION);
+        options.rendering.use_gpu_rendering = false;
+        const auto& payload = shared_scored_payload();
+        const auto& scored_cloud = payload.point_clouds.front();
+        const path output_path{options.output_path / "render_allocations"};
+        create_directories(output_path);
+        set_scratch_arenas_enabled(state.range(0) != 0);
+
+        ObserverRenderer renderer(scored_cloud, payload.color_map, options.rendering,
+                                  options.camera.distance_to_origin);
+        renderer.use_background(renderer.decode_background());
+        renderer.write(output_path, "");
+
+        const auto begin = current_memory_usage();
+        for (auto _: state) {
+            renderer.write(output_path, "");
+        }
+        report_allocations(state, begin);
+        set_scratch_arenas_enabled(true);
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(scored_cloud.points()->size()));
+    }
+
+    // parallel algorithms run on worker threads, so only wall time is meaningful
+    BENCHMARK(BM_CollectInputs)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_LoadSparseModel)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_LoadDenseMesh)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_LoadAzimuthData)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_ObserverProvider)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_ScorePoints)
+            ->ArgName("generator")
+            ->Arg(PointGenerator::MODEL_SPARSE)
+            ->Arg(PointGenerator::MODEL_DENSE)
+            ->Arg(PointGenerator::DATA_PROJECTION)
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_ScorePointsChunked)
+            ->ArgName("chunk_size")->Arg(0)->Arg(1024)->Arg(16384)
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_ScoreSkewed)
+            ->ArgName("nesting")
+            ->Arg(static_cast<int64_t>(nesting_policy::INNER_LOOPS))
+            ->Arg(static_cast<int64_t>(nesting_policy::OUTER_LOOPS))
+            ->Arg(static_cast<int64_t>(nesting_policy::TASKS))
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_ScorePointsWithPeaks)
+            ->ArgName("generator")
+            ->Arg(PointGenerator::MODEL_SPARSE)
+            ->Arg(PointGenerator::DATA_PROJECTION)
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_AccumulateScores)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_VerticalWeights)->ArgName("tabulated")->Arg(0)->Arg(1);
+    BENCHMARK(BM_ProjectData)->ArgName("steps_per_angle")->Arg(1)->Arg(3)
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_RenderObserver)->ArgName("sfml")->Arg(0)->Arg(1)
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_RenderPipeline)->ArgName("pipelined")->Arg(0)->Arg(1)
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_ModelWriter)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_ScoreAllocations)->ArgName("scratch")->Arg(0)->Arg(1)
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK(BM_RenderAllocations)->ArgName("scratch")->Arg(0)->Arg(1)
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    static auto parse_list(const string& value) -> vector<string> {
+        vector<string> result;
+        std::stringstream stream(value);
+        string item;
+        while (std::getline(stream, item, ',')) {
+            result.push_back(item);
+        }
+        return result;
+    }
+
+    /**
+     * Scores the synthetic dataset from the model points, which involves no random sampling, and writes one
+     * scored cloud file per observer and label. Written by a default and a RCSOP_FLOAT_STORAGE build, the two
+     * folders are compared with rcsop-accuracy-report.
+     */
+    static void write_scored_reference(const path& output_path) {
+        const auto options = bench_task_options(PointGenerator::MODEL_SPARSE);
+        const auto inputs = collect_inputs(options);
+        const auto color_map = construct_color_map_function(options.rendering.color_map, options.db_range);
+        const auto payload = score_points(inputs, labeled_data(inputs), options, color_map);
+
+        std::filesystem::create_directories(output_path);
+        const auto& clouds = payload->point_clouds;
+        for (size_t index = 0; index < clouds.size(); index++) {
+            const auto& cloud = clouds[index];
+            const auto file_name = std::to_string(index) + "_" + ScoredCloudFile::file_name(cloud.observer().position());
+            write_scored_cloud(output_path / file_name, cloud.observer().position(), *cloud.points());
+        }
+        std::cout << "Wrote " << clouds.size() << " scored clouds to " << output_path.string() << std::endl;
+    }
+
+    /**
+     * Consumes the --synthetic-* options, everything else is left to Google Benchmark.
+     */
+    static auto parse_dataset_options(int argc, char** argv,
+                                      vector<char*>& remaining_arguments,
+                                      bool& verbose,
+                                      optional<path>& scored_reference) -> synthetic_dataset_options {
+        synthetic_dataset_options options;
+        remaining_arguments.push_back(argv[0]);
+        for (int i = 1; i < argc; i++) {
+            const string argument{argv[i]};
+            auto value_of = [&argument](const string& option) {
+                return argument.substr(option.size());
+            };
+            if (argument.starts_with(OPTION_POINTS)) {
+                options.sparse_point_count = std::stoul(value_of(OPTION_POINTS));
+            } else if (argument.starts_with(OPTION_AZIMUTHS)) {
+                options.azimuth_count = std::stoul(value_of(OPTION_AZIMUTHS));
+            } else if (argument.starts_with(OPTION_MESH_RINGS)) {
+                options.mesh_rings = std::stoul(value_of(OPTION_MESH_RINGS));
+            } else if (argument.starts_with(OPTION_IMAGE_SIZE)) {
+                const auto size = value_of(OPTION_IMAGE_SIZE);
+                const auto separator = size.find('x');
+                if (separator == string::npos) {
+                    throw invalid_argument("Image size must be given as <width>x<height>");
+                }
+                options.image_width = std::stoul(size.substr(0, separator));
+                options.image_height = std::stoul(size.substr(separator + 1));
+            } else if (argument.starts_with(OPTION_LABELS)) {
+                options.data_labels = parse_list(value_of(OPTION_LABELS));
+            } else if (argument == OPTION_VERBOSE) {
+                verbose = true;
+            } else if (argument.starts_with(OPTION_SCORED_REFERENCE)) {
+                scored_reference = path(value_of(OPTION_SCORED_REFERENCE));
+            } else {
+                remaining_arguments.push_back(argv[i]);
+            }
+        }
+        return options;
+    }
+
+    static auto has_output_argument(const vector<char*>& arguments) -> bool {
+        return std::any_of(arguments.cbegin(), arguments.cend(), [](const char* argument) {
+            return string(argument).starts_with("--benchmark_out=");
+        });
+    }
+
+    static auto run(int argc, char** argv) -> int {
+        vector<char*> arguments;
+        bool verbose = false;
+        optional<path> scored_reference;
+        const auto options = parse_dataset_options(argc, argv, arguments, verbose, scored_reference);
+
+        // results are always kept as JSON for comparisons across releases, e.g. with benchmark's compare.py
+        static string json_output = "--benchmark_out=" + DEFAULT_JSON_OUTPUT;
+        static string json_format = "--benchmark_out_format=json";
+        if (!has_output_argument(arguments)) {
+            arguments.push_back(json_output.data());
+            arguments.push_back(json_format.data());
+        }
+        arguments.push_back(nullptr);
+
+        int benchmark_argc = static_cast<int>(arguments.size() - 1);
+        benchmark::Initialize(&benchmark_argc, arguments.data());
+        if (benchmark::ReportUnrecognizedArguments(benchmark_argc, arguments.data())) {
+            return 1;
+        }
+
+        const path root_path{std::filesystem::temp_directory_path()
+                             / ("rcsop-bench-" + std::to_string(getpid()))};
+        std::clog << "Generating synthetic dataset in " << root_path.string() << " ..." << std::endl;
+        dataset = make_unique<SyntheticDataset>(root_path, options);
+
+        benchmark::AddCustomContext("synthetic_sparse_points", std::to_string(options.sparse_point_count));
+        benchmark::AddCustomContext("synthetic_observers",
+                                    std::to_string(options.azimuth_count * options.heights.size()));
+        benchmark::AddCustomContext("synthetic_mesh_rings", std::to_string(options.mesh_rings));
+        benchmark::AddCustomContext("synthetic_image_size", std::to_string(options.image_width) + "x"
+                                                            + std::to_string(options.image_height));
+        benchmark::AddCustomContext("synthetic_data_labels", std::to_string(options.data_labels.size()));
+        benchmark::AddCustomContext("storage_scalar", std::is_same_v<storage_scalar_t, float> ? "float" : "double");
+
+        if (scored_reference.has_value()) {
+            write_scored_reference(*scored_reference);
+            dataset = nullptr;
+            return 0;
+        }
+
+        auto* log_buffer = std::clog.rdbuf();
+        if (!verbose) {
+            std::clog.rdbuf(nullptr);
+        }
+        benchmark::RunSpecifiedBenchmarks();
+        benchmark::Shutdown();
+        std::clog.rdbuf(log_buffer);
+        std::clog.clear();
+
+        skewed_dataset = nullptr;
+        dataset = nullptr;
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    return rcsop::bench::run(argc, argv);
+}
@@ -0,0 +1,355 @@
+#include "synthetic_dataset.h"
+
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <iomanip>
+
+#include <Eigen/Geometry>
+#include <cairo.h>
+#include <matio.h>
+
+#include "utils/points.h"
+
+namespace rcsop::bench {
+    using rcsop::common::ObserverPosition;
+    using rcsop::common::utils::points::vec3;
+
+    // SIMPLE_PINHOLE: f, cx, cy
+    const static int32_t CAMERA_MODEL_SIMPLE_PINHOLE = 0;
+    const static uint32_t CAMERA_ID = 1;
+
+    // the reconstruction is scaled in meters, i.e. one world unit are 100cm
+    const static double UNITS_PER_CENTIMETER = 0.01;
+
+    const static double OBJECT_RADIUS = 0.3;
+    const static double OBJECT_CENTER_HEIGHT = 0.3;
+
+    const static double ANGLE_LIMIT_DEGREES = 45.;
+    const static size_t MINIMAP_WIDTH = 400;
+    const static size_t MINIMAP_HEIGHT = 300;
+
+    template<typename T>
+    static void write_value(std::ofstream& output, const T& value) {
+        output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static auto open_binary(const path& file_path) -> std::ofstream {
+        std::ofstream output(file_path, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            throw runtime_error("Could not open " + file_path.string() + " for writing");
+        }
+        return output;
+    }
+
+    static auto image_name(const ObserverPosition& position) -> string {
+        std::stringstream name;
+        name << std::setw(2) << std::setfill('0') << position.height << "cm_"
+             << std::setw(3) << std::setfill('0') << position.azimuth << "°.png";
+        return name.str();
+    }
+
+    static auto camera_center(const ObserverPosition& position, double distance_cm) -> vec3 {
+        const double radius = distance_cm * UNITS_PER_CENTIMETER;
+        const double angle = static_cast<double>(position.azimuth) * M_PI / 180.;
+        return {radius * std::cos(angle),
+                radius * std::sin(angle),
+                static_cast<double>(position.height) * UNITS_PER_CENTIMETER};
+    }
+
+    /**
+     * World-to-camera rotation of a camera looking at the object center, with COLMAP's y axis pointing down.
+     */
+    static auto look_at_object(const vec3& center) -> Eigen::Matrix3d {
+        const vec3 world_up = vec3::UnitZ();
+        const vec3 forward = (vec3(0, 0, OBJECT_CENTER_HEIGHT) - center).normalized();
+        const vec3 right = forward.cross(world_up).normalized();
+        const vec3 down = forward.cross(right);
+
+        Eigen::Matrix3d rotation;
+        rotation.row(0) = right;
+        rotation.row(1) = down;
+        rotation.row(2) = forward;
+        return rotation;
+    }
+
+    static void write_png(const path& file_path, size_t width, size_t height, double hue_shift) {
+        cairo_surface_t* surface = cairo_image_surface_create(
+                CAIRO_FORMAT_RGB24, static_cast<int>(width), static_cast<int>(height));
+        cairo_t* context = cairo_create(surface);
+
+        cairo_pattern_t* gradient = cairo_pattern_create_linear(0, 0, static_cast<double>(width),
+                                                                static_cast<double>(height));
+        cairo_pattern_add_color_stop_rgb(gradient, 0, 0.2 + 0.5 * hue_shift, 0.3, 0.4);
+        cairo_pattern_add_color_stop_rgb(gradient, 1, 0.1, 0.6 - 0.4 * hue_shift, 0.2);
+        cairo_set_source(context, gradient);
+        cairo_paint(context);
+        cairo_pattern_destroy(gradient);
+
+        cairo_set_source_rgb(context, 0.8, 0.8, 0.8);
+        cairo_arc(context, static_cast<double>(width) / 2, static_cast<double>(height) / 2,
+                  static_cast<double>(std::min(width, height)) / 4, 0, 2 * M_PI);
+        cairo_fill(context);
+
+        const auto status = cairo_surface_write_to_png(surface, file_path.c_str());
+        cairo_destroy(context);
+        cairo_surface_destroy(surface);
+        if (status != CAIRO_STATUS_SUCCESS) {
+            throw runtime_error("Could not write " + file_path.string());
+        }
+    }
+
+    static auto create_double_field(const vector<double>& values, size_t rows, size_t columns) -> matvar_t* {
+        size_t dimensions[2] = {rows, columns};
+        return Mat_VarCreate(nullptr, MAT_C_DOUBLE, MAT_T_DOUBLE, 2, dimensions,
+                             const_cast<double*>(values.data()), 0);
+    }
+
+    SyntheticDataset::SyntheticDataset(path root_path, synthetic_dataset_options options)
+            : _root_path(std::move(root_path)),
+              _options(std::move(options)) {
+        if (_options.azimuth_count < 2 || _options.heights.empty() || _options.data_labels.empty()) {
+            throw invalid_argument("Synthetic dataset needs at least two azimuths, one height and one data label");
+        }
+        const path model_path{_root_path / "models" / "0"};
+        const path image_path{_root_path / "images"};
+        const path data_path{_root_path / "data"};
+        create_directories(model_path);
+        create_directories(image_path);
+        create_directories(data_path);
+
+        write_sparse_model(model_path);
+        write_dense_mesh(_root_path / "models" / "mesh.ply");
+        write_azimuth_data(data_path);
+        write_images(image_path);
+    }
+
+    SyntheticDataset::~SyntheticDataset() {
+        std::error_code ignored;
+        std::filesystem::remove_all(_root_path, ignored);
+    }
+
+    auto SyntheticDataset::positions() const -> vector<ObserverPosition> {
+        vector<ObserverPosition> result;
+        const auto azimuth_step = 360 / static_cast<azimuth_t>(_options.azimuth_count);
+        for (const auto height: _options.heights) {
+            for (size_t i = 0; i < _options.azimuth_count; i++) {
+                result.push_back({
+                        .height = height,
+                        .azimuth = static_cast<azimuth_t>(i) * azimuth_step,
+                });
+            }
+        }
+        return result;
+    }
+
+    void SyntheticDataset::write_sparse_model(const path& model_path) const {
+        {
+            auto cameras = open_binary(model_path / "cameras.bin");
+            write_value<uint64_t>(cameras, 1);
+            write_value<uint32_t>(cameras, CAMERA_ID);
+            write_value<int32_t>(cameras, CAMERA_MODEL_SIMPLE_PINHOLE);
+            write_value<uint64_t>(cameras, _options.image_width);
+            write_value<uint64_t>(cameras, _options.image_height);
+            write_value<double>(cameras, static_cast<double>(_options.image_width));
+            write_value<double>(cameras, static_cast<double>(_options.image_width) / 2);
+            write_value<double>(cameras, static_cast<double>(_options.image_height) / 2);
+        }
+        {
+            const auto observer_positions = positions();
+            auto images = open_binary(model_path / "images.bin");
+            write_value<uint64_t>(images, observer_positions.size());
+            uint32_t image_id = 1;
+            for (const auto& position: observer_positions) {
+                const vec3 center = camera_center(position, _options.camera_distance_cm);
+                const Eigen::Matrix3d rotation = look_at_object(center);
+                const Eigen::Quaterniond qvec(rotation);
+                const vec3 tvec = -rotation * center;
+
+                write_value<uint32_t>(images, image_id++);
+                for (const double value: {qvec.w(), qvec.x(), qvec.y(), qvec.z()}) {
+                    write_value<double>(images, value);
+                }
+                for (const double value: {tvec.x(), tvec.y(), tvec.z()}) {
+                    write_value<double>(images, value);
+                }
+                write_value<uint32_t>(images, CAMERA_ID);
+                const auto name = image_name(position);
+                images.write(name.c_str(), static_cast<std::streamsize>(name.size() + 1));
+                write_value<uint64_t>(images, 0);
+            }
+        }
+
+        std::mt19937 generator(_options.seed);
+        std::uniform_real_distribution<double> horizontal(-OBJECT_RADIUS * 2, OBJECT_RADIUS * 2);
+        std::uniform_real_distribution<double> vertical(0, OBJECT_CENTER_HEIGHT * 2);
+        std::uniform_int_distribution<int> color(0, 255);
+
+        auto points = open_binary(model_path / "points3D.bin");
+        write_value<uint64_t>(points, _options.sparse_point_count);
+        for (uint64_t point_id = 1; point_id <= _options.sparse_point_count; point_id++) {
+            write_value<uint64_t>(points, point_id);
+            write_value<double>(points, horizontal(generator));
+            write_value<double>(points, horizontal(generator));
+            write_value<double>(points, vertical(generator));
+            for (int channel = 0; channel < 3; channel++) {
+                write_value<uint8_t>(points, static_cast<uint8_t>(color(generator)));
+            }
+            write_value<double>(points, 0.5); // reprojection error
+            write_value<uint64_t>(points, 0); // track length
+        }
+    }
+
+    /**
+     * Closed UV sphere, so the mesh can also be used for inside tests.
+     */
+    void SyntheticDataset::write_dense_mesh(const path& mesh_path) const {
+        const size_t rings = std::max<size_t>(_options.mesh_rings, 3);
+        const size_t segments = 2 * rings;
+        const size_t vertex_count = 2 + (rings - 1) * segments;
+        const size_t face_count = 2 * segments * (rings - 1);
+
+        auto output = open_binary(mesh_path);
+        std::stringstream header;
+        header << "ply\n"
+               << "format binary_little_endian 1.0\n"
+               << "element vertex " << vertex_count << "\n"
+               << "property float x\n"
+               << "property float y\n"
+               << "property float z\n"
+               << "element face " << face_count << "\n"
+               << "property list uchar int vertex_indices\n"
+               << "end_header\n";
+        const auto header_text = header.str();
+        output.write(header_text.data(), static_cast<std::streamsize>(header_text.size()));
+
+        auto write_vertex = [&output](double x, double y, double z) {
+            write_value<float>(output, static_cast<float>(x));
+            write_value<float>(output, static_cast<float>(y));
+            write_value<float>(output, static_cast<float>(z + OBJECT_CENTER_HEIGHT));
+        };
+        write_vertex(0, 0, OBJECT_RADIUS);
+        for (size_t ring = 1; ring < rings; ring++) {
+            const double polar = M_PI * static_cast<double>(ring) / static_cast<double>(rings);
+            for (size_t segment = 0; segment < segments; segment++) {
+                const double azimuth = 2 * M_PI * static_cast<double>(segment) / static_cast<double>(segments);
+                write_vertex(OBJECT_RADIUS * std::sin(polar) * std::cos(azimuth),
+                             OBJECT_RADIUS * std::sin(polar) * std::sin(azimuth),
+                             OBJECT_RADIUS * std::cos(polar));
+            }
+        }
+        write_vertex(0, 0, -OBJECT_RADIUS);
+
+        auto write_triangle = [&output](size_t a, size_t b, size_t c) {
+            write_value<uint8_t>(output, 3);
+            write_value<int32_t>(output, static_cast<int32_t>(a));
+            write_value<int32_t>(output, static_cast<int32_t>(b));
+            write_value<int32_t>(output, static_cast<int32_t>(c));
+        };
+        auto ring_vertex = [segments](size_t ring, size_t segment) -> size_t {
+            return 1 + (ring - 1) * segments + segment % segments;
+        };
+        const size_t south_pole = vertex_count - 1;
+        for (size_t segment = 0; segment < segments; segment++) {
+            write_triangle(0, ring_vertex(1, segment), ring_vertex(1, segment + 1));
+            for (size_t ring = 1; ring < rings - 1; ring++) {
+                write_triangle(ring_vertex(ring, segment), ring_vertex(ring + 1, segment),
+                               ring_vertex(ring + 1, segment + 1));
+                write_triangle(ring_vertex(ring, segment), ring_vertex(ring + 1, segment + 1),
+                               ring_vertex(ring, segment + 1));
+            }
+            write_triangle(south_pole, ring_vertex(rings - 1, segment + 1), ring_vertex(rings - 1, segment));
+        }
+        if (!output) {
+            throw runtime_error("Could not write " + mesh_path.string());
+        }
+    }
+
+    /**
+     * One DataAuswertung file per position and label, using the layout read by AzimuthRcsDataSet:
+     * ranges in meters (the first one being zero), angles in degrees and the values stored angle by angle.
+     */
+    void SyntheticDataset::write_azimuth_data(const path& data_path) const {
+        const size_t range_count = std::max<size_t>(_options.range_count, 3);
+        const size_t angle_count = std::max<size_t>(_options.angle_count, 2);
+        const double max_range = 2 * _options.camera_distance_cm / 100.;
+        const double object_range = _options.camera_distance_cm / 100.;
+
+        vector<double> ranges(range_count);
+        for (size_t i = 0; i < range_count; i++) {
+            ranges[i] = max_range * static_cast<double>(i) / static_cast<double>(range_count - 1);
+        }
+        vector<double> angles(angle_count);
+        for (size_t i = 0; i < angle_count; i++) {
+            angles[i] = -ANGLE_LIMIT_DEGREES
+                        + 2 * ANGLE_LIMIT_DEGREES * static_cast<double>(i) / static_cast<double>(angle_count - 1);
+        }
+
+        std::mt19937 generator(_options.seed);
+        std::uniform_real_distribution<double> noise(0., 0.05);
+        const char* fields[3] = {"vRangeExt", "vAngDeg", "JOpt_RCS"};
+
+        for (const auto& label: _options.data_labels) {
+            const path label_path{data_path / label};
+            create_directories(label_path);
+
+            const auto label_positions = positions();
+            const auto last_position = static_cast<double>(std::max<size_t>(label_positions.size() - 1, 1));
+            for (size_t position_index = 0; position_index < label_positions.size(); position_index++) {
+                const auto& position = label_positions[position_index];
+                const double echo_width = std::pow(_options.work_skew,
+                                                   -static_cast<double>(position_index) / last_position);
+                vector<double> values(range_count * angle_count);
+                for (size_t angle_i = 0; angle_i < angle_count; angle_i++) {
+                    const double angle_factor = 0.5 + 0.5 * std::cos(
+                            (4 * angles[angle_i] + static_cast<double>(position.azimuth)) * M_PI / 180.);
+                    for (size_t range_i = 0; range_i < range_count; range_i++) {
+                        const double offset = (ranges[range_i] - object_range) / (OBJECT_RADIUS * echo_width);
+                        values[angle_i * range_count + range_i] =
+                                range_i == 0 ? NAN : angle_factor * std::exp(-offset * offset)
+                                                     + echo_width * noise(generator);
+                    }
+                }
+
+                const string name = "DataAuswertung_" + std::to_string(position.height) + "cm_"
+                                    + std::to_string(position.azimuth) + "°";
+                const path mat_path{label_path / (name + ".mat")};
+                mat_t* mat_file = Mat_CreateVer(mat_path.c_str(), nullptr, MAT_FT_MAT5);
+                if (nullptr == mat_file) {
+                    throw runtime_error("Could not create " + mat_path.string());
+                }
+                size_t struct_dimensions[2] = {1, 1};
+                matvar_t* table = Mat_VarCreateStruct("auswertung", 2, struct_dimensions, fields, 3);
+                Mat_VarSetStructFieldByName(table, fields[0], 0, create_double_field(ranges, range_count, 1));
+                Mat_VarSetStructFieldByName(table, fields[1], 0, create_double_field(angles, angle_count, 1));
+                Mat_VarSetStructFieldByName(table, fields[2], 0,
+                                            create_double_field(values, range_count, angle_count));
+                const auto status = Mat_VarWrite(mat_file, table, MAT_COMPRESSION_NONE);
+                Mat_VarFree(table);
+                Mat_Close(mat_file);
+                if (status != 0) {
+                    throw runtime_error("Could not write " + mat_path.string());
+                }
+
+                const path minimap_path{label_path / ("figure_" + std::to_string(position.height) + "cm_"
+                                                      + std::to_string(position.azimuth) + "°_RangevsAzimuth.png")};
+                write_png(minimap_path, MINIMAP_WIDTH, MINIMAP_HEIGHT, 0.5);
+            }
+        }
+    }
+
+    void SyntheticDataset::write_images(const path& image_path) const {
+        for (const auto& position: positions()) {
+            const double hue_shift = static_cast<double>(position.azimuth) / 360.;
+            write_png(image_path / image_name(position), _options.image_width, _options.image_height, hue_shift);
+        }
+    }
+
+    auto SyntheticDataset::root_path() const -> const path& {
+        return this->_root_path;
+    }
+
+    auto SyntheticDataset::options() const -> const synthetic_dataset_options& {
+        return this->_options;
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef RCSOP_BENCH_SYNTHETIC_DATASET_H
+#define RCSOP_BENCH_SYNTHETIC_DATASET_H
+
+#include "utils/types.h"
+#include "observer_position.h"
+
+namespace rcsop::bench {
+    using rcsop::common::height_t;
+    using rcsop::common::azimuth_t;
+
+    struct synthetic_dataset_options {
+        vector<height_t> heights = {40};
+        size_t azimuth_count = 8;
+        vector<string> data_labels = {"0"};
+        size_t sparse_point_count = 50000;
+        size_t mesh_rings = 256;
+        size_t image_width = 1920;
+        size_t image_height = 1080;
+        size_t range_count = 512;
+        size_t angle_count = 91;
+        double camera_distance_cm = 750.;
+        /**
+         * Ratio between the echo widths of the first and the last position. Narrower echos leave fewer cells
+         * above the noise floor, so the data projected per observer falls off from the first to the last one.
+         */
+        double work_skew = 1.;
+        unsigned int seed = 42;
+    };
+
+    /**
+     * Writes a complete, self-consistent input folder (COLMAP model, PLY mesh, azimuth .mat files, minimaps
+     * and source images) into a fresh directory, laid out like a real measurement so the regular
+     * InputDataCollector can pick it up. The directory is removed again when the object is destroyed.
+     */
+    class SyntheticDataset {
+    private:
+        path _root_path;
+        synthetic_dataset_options _options;
+
+        [[nodiscard]] auto positions() const -> vector<rcsop::common::ObserverPosition>;
+
+        void write_sparse_model(const path& model_path) const;
+
+        void write_dense_mesh(const path& mesh_path) const;
+
+        void write_azimuth_data(const path& data_path) const;
+
+        void write_images(const path& image_path) const;
+
+    public:
+        SyntheticDataset(path root_path, synthetic_dataset_options options);
+
+        ~SyntheticDataset();
+
+        SyntheticDataset(const SyntheticDataset&) = delete;
+
+        SyntheticDataset& operator=(const SyntheticDataset&) = delete;
+
+        [[nodiscard]] auto root_path() const -> const path&;
+
+        [[nodiscard]] auto options() const -> const synthetic_dataset_options&;
+    };
+}
+
+#endif //RCSOP_BENCH_SYNTHETIC_DATASET_H
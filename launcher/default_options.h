@@ -16,6 +16,10 @@ namespace rcsop::launcher {
     const string DEFAULT_POINT_GENERATOR = "data-projection";
     const string DEFAULT_OUTPUT_FORMAT = "all";
     const size_t DEFAULT_POINT_DENSITY = 3;
+    constexpr double DEFAULT_POINT_SPACING = 0.;
+    const size_t DEFAULT_CHUNK_SIZE = 0;
+    const size_t DEFAULT_THREADS = 0;
+    const string DEFAULT_NESTING = "points";
 
     constexpr double DEFAULT_CAMERA_DISTANCE = 750.0;
     constexpr height_t DEFAULT_HEIGHT = 40;
@@ -0,0 +1,219 @@
+#include "job_server.h"
+
+#include <iostream>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "utils/chronometer.h"
+#include "utils/memory.h"
+
+#include "launcher.h"
+#include "launcher_options.h"
+
+namespace rcsop::launcher {
+    using std::clog;
+    using std::endl;
+
+    using rcsop::common::utils::time::start_time;
+    using rcsop::common::utils::time::log_and_start_next;
+    using rcsop::common::utils::memory::ScopedMemoryStage;
+    using rcsop::common::utils::memory::take_memory_stages;
+    using rcsop::common::utils::memory::write_memory_summary;
+
+    const static size_t REQUEST_BUFFER_SIZE = 4096;
+    const static size_t MAX_REQUEST_SIZE = 1 << 20;
+    const static int CONNECTION_BACKLOG = 16;
+
+    [[nodiscard]] static auto system_error_message(const string& action) -> string {
+        return action + ": " + std::strerror(errno);
+    }
+
+    /**
+     * Reads the arguments of a request up to the terminating empty line.
+     */
+    [[nodiscard]] static auto read_request(int connection) -> vector<string> {
+        string request;
+        char buffer[REQUEST_BUFFER_SIZE];
+        while (request.find("\n\n") == string::npos) {
+            const auto received = recv(connection, buffer, sizeof(buffer), 0);
+            if (received < 0) {
+                throw runtime_error(system_error_message("Failed to read request"));
+            }
+            if (received == 0) {
+                break;
+            }
+            request.append(buffer, static_cast<size_t>(received));
+            if (request.size() > MAX_REQUEST_SIZE) {
+                throw invalid_argument("Request exceeds " + std::to_string(MAX_REQUEST_SIZE) + " bytes.");
+            }
+        }
+
+        vector<string> arguments;
+        size_t line_start = 0;
+        while (line_start < request.size()) {
+            auto line_end = request.find('\n', line_start);
+            if (line_end == string::npos) {
+                line_end = request.size();
+            }
+            string line = request.substr(line_start, line_end - line_start);
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty()) {
+                break;
+            }
+            arguments.push_back(line);
+            line_start = line_end + 1;
+        }
+        return arguments;
+    }
+
+    static void write_reply(int connection, const string& reply) {
+        size_t written = 0;
+        while (written < reply.size()) {
+            const auto sent = send(connection, reply.data() + written, reply.size() - written, MSG_NOSIGNAL);
+            if (sent <= 0) {
+                clog << system_error_message("Failed to send reply") << endl;
+                return;
+            }
+            written += static_cast<size_t>(sent);
+        }
+    }
+
+    JobServer::JobServer(path socket_path, const map<string, launcher_task>& available_tasks)
+            : _socket_path(std::move(socket_path)), _available_tasks(available_tasks) {}
+
+    auto JobServer::resident_inputs(const task_options& options) -> shared_ptr<const InputDataCollector> {
+        // the collector only depends on the default height of the camera options
+        const auto key = make_pair(options.input_path.string(), options.camera.default_height);
+        shared_ptr<resident_input> entry;
+        {
+            std::lock_guard guard(_lock);
+            auto& stored_entry = _inputs[key];
+            if (stored_entry == nullptr) {
+                stored_entry = make_shared<resident_input>();
+            }
+            entry = stored_entry;
+        }
+        std::lock_guard guard(entry->lock);
+        if (entry->inputs == nullptr) {
+            ScopedMemoryStage input_memory("input_load");
+            auto inputs = make_shared<InputDataCollector>(options.input_path, options.camera);
+            inputs->keep_resident();
+            entry->inputs = std::move(inputs);
+        }
+        return entry->inputs;
+    }
+
+    auto JobServer::run_job(const vector<string>& arguments) -> path {
+        vector<string> argument_storage{"rcs-overlay-plotter"};
+        argument_storage.insert(argument_storage.end(), arguments.cbegin(), arguments.cend());
+        vector<char*> argv;
+        for (auto& argument: argument_storage) {
+            argv.push_back(argument.data());
+        }
+        argv.push_back(nullptr);
+
+        const int argc = static_cast<int>(argument_storage.size());
+        // the executor is configured once for the whole server, a job can't change it for itself
+        if (has_executor_options(argc, argv.data())) {
+            throw invalid_argument("--threads and --nesting apply to the whole server, pass them when starting it.");
+        }
+        auto options = parse_and_validate(argc, argv.data(), _available_tasks);
+        // spans are collected globally, concurrent jobs would mix up their traces
+        options.trace_path = path();
+        if (is_directory(options.output_path) && !options.incremental) {
+            throw invalid_argument("Output folder '" + options.output_path.string()
+                                   + "' exists already, remove it or request an incremental run.");
+        }
+        {
+            std::lock_guard guard(_lock);
+            if (!_active_outputs.insert(options.output_path).second) {
+                throw invalid_argument("Another job is writing to '" + options.output_path.string() + "'.");
+            }
+        }
+        try {
+            create_directories(options.output_path);
+            const auto inputs = resident_inputs(options);
+            run_task(*inputs, options, _available_tasks);
+        } catch (...) {
+            std::lock_guard guard(_lock);
+            _active_outputs.erase(options.output_path);
+            throw;
+        }
+        std::lock_guard guard(_lock);
+        _active_outputs.erase(options.output_path);
+        return options.output_path;
+    }
+
+    void JobServer::serve_connection(int connection) {
+        string reply;
+        try {
+            const auto arguments = read_request(connection);
+            const auto output_path = run_job(arguments);
+            reply = "OK " + output_path.string() + "\n";
+        } catch (const std::exception& e) {
+            string reason = e.what();
+            std::replace(reason.begin(), reason.end(), '\n', ' ');
+            clog << "Job failed: " << reason << endl;
+            reply = "ERROR " + reason + "\n";
+        }
+        write_reply(connection, reply);
+        close(connection);
+
+        // the stages of a serving process would pile up otherwise, concurrent jobs share one summary
+        const auto memory_stages = take_memory_stages();
+        if (!memory_stages.empty()) {
+            write_memory_summary(clog, memory_stages);
+        }
+    }
+
+    void JobServer::run() {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        const auto socket_name = _socket_path.string();
+        if (socket_name.size() >= sizeof(address.sun_path)) {
+            throw invalid_argument("Socket path '" + socket_name + "' is too long.");
+        }
+        std::strncpy(address.sun_path, socket_name.c_str(), sizeof(address.sun_path) - 1);
+
+        // a socket left over by a previous server would make bind fail, any other file is not ours to remove
+        const auto socket_status = symlink_status(_socket_path);
+        if (is_socket(socket_status)) {
+            remove(_socket_path);
+        } else if (exists(socket_status)) {
+            throw invalid_argument("'" + socket_name + "' exists and is not a socket.");
+        }
+
+        const int server_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (server_socket < 0) {
+            throw runtime_error(system_error_message("Failed to create socket"));
+        }
+        if (bind(server_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0
+            || listen(server_socket, CONNECTION_BACKLOG) < 0) {
+            const auto message = system_error_message("Failed to listen on " + socket_name);
+            close(server_socket);
+            throw runtime_error(message);
+        }
+        clog << "Waiting for jobs on " << socket_name << endl;
+
+        while (true) {
+            const int connection = accept(server_socket, nullptr, nullptr);
+            if (connection < 0) {
+                if (errno != EINTR) {
+                    clog << system_error_message("Failed to accept connection") << endl;
+                }
+                continue;
+            }
+            std::thread([this, connection]() {
+                auto job_time = start_time();
+                serve_connection(connection);
+                log_and_start_next(job_time, "Finished job.");
+            }).detach();
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef RCSOP_LAUNCHER_JOB_SERVER_H
+#define RCSOP_LAUNCHER_JOB_SERVER_H
+
+#include <mutex>
+
+#include "utils/types.h"
+#include "utils/task_utils.h"
+
+#include "input_data_collector.h"
+
+namespace rcsop::launcher {
+    using rcsop::data::InputDataCollector;
+    using rcsop::launcher::utils::task_options;
+    using rcsop::launcher::utils::launcher_task;
+    using rcsop::common::height_t;
+
+    /**
+     * Serves task requests over a Unix domain socket. The inputs of every requested input folder stay resident,
+     * so later jobs on the same inputs skip loading the models and data files and reuse the observers and
+     * base points derived from them. Jobs run concurrently, one thread per connection.
+     *
+     * A request sends the command line arguments of a task, one per line, terminated by an empty line.
+     * The reply is a single line, "OK <output path>" or "ERROR <reason>", after which the connection is closed.
+     */
+    class JobServer {
+    private:
+        path _socket_path;
+        const map<string, launcher_task>& _available_tasks;
+
+        struct resident_input {
+            std::mutex lock;
+            shared_ptr<const InputDataCollector> inputs;
+        };
+
+        std::mutex _lock;
+        map<pair<string, height_t>, shared_ptr<resident_input>> _inputs;
+        set<path> _active_outputs;
+
+        /**
+         * Loads the inputs on the first request for them. Concurrent first requests for the same inputs wait for a
+         * single load, jobs on other inputs are not blocked.
+         */
+        [[nodiscard]] auto resident_inputs(const task_options& options) -> shared_ptr<const InputDataCollector>;
+
+        [[nodiscard]] auto run_job(const vector<string>& arguments) -> path;
+
+    public:
+        JobServer(path socket_path, const map<string, launcher_task>& available_tasks);
+
+        /**
+         * Runs the job requested on a connected socket, replies and closes the connection. The executor options
+         * --threads and --nesting are rejected, they are set once for the whole server. Afterwards the memory stages
+         * recorded since the last job are summarized to the log and dropped.
+         */
+        void serve_connection(int connection);
+
+        /**
+         * Accepts connections until the process is terminated, throws if the socket can not be opened or another
+         * kind of file exists at its path.
+         */
+        [[noreturn]] void run();
+    };
+}
+
+#endif //RCSOP_LAUNCHER_JOB_SERVER_H
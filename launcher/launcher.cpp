@@ -4,6 +4,10 @@
 
 #include "utils/types.h"
 #include "utils/task_utils.h"
+#include "utils/tracing.h"
+#include "utils/memory.h"
+#include "utils/sharding.h"
+#include "utils/executor.h"
 
 #include "tasks/test_task.h"
 #include "tasks/rcs_slices.h"
@@ -13,6 +17,7 @@
 
 #include "default_options.h"
 #include "launcher_options.h"
+#include "job_server.h"
 
 namespace rcsop::launcher {
     using std::cin;
@@ -28,9 +33,19 @@ namespace rcsop::launcher {
     using rcsop::common::utils::time::start_time;
     using rcsop::common::utils::time::log_and_start_next;
 
+    using rcsop::common::utils::tracing::ScopedSpan;
+    using rcsop::common::utils::tracing::enable_tracing;
+    using rcsop::common::utils::tracing::write_chrome_trace;
+    using rcsop::common::utils::tracing::write_summary;
+
+    using rcsop::common::utils::memory::ScopedMemoryStage;
+    using rcsop::common::utils::memory::write_memory_summary;
+
     using rcsop::data::InputDataCollector;
 
     using rcsop::launcher::parse_and_validate;
+    using rcsop::launcher::utils::merge_shards;
+    using rcsop::common::utils::parallel::configure_executor;
 
     const static map<string, launcher_task> available_tasks = {
             {"test-task",     rcsop::launcher::tasks::test_task},
@@ -38,14 +53,42 @@ namespace rcsop::launcher {
             {"rcs-sums",      rcsop::launcher::tasks::accumulate_rcs},
             {"azimuth-sums",  rcsop::launcher::tasks::accumulate_azimuth},
             {DEFAULT_TASK,    rcsop::launcher::tasks::azimuth_rcs_plotter},
+            {"render-scored", rcsop::launcher::tasks::render_scored},
             {"sparse-filter", rcsop::launcher::tasks::sparse_filter},
     };
 
+    void run_task(const InputDataCollector& inputs,
+                  const task_options& options,
+                  const map<string, launcher_task>& available_tasks) {
+        ScopedSpan task_span("task", options.task_name);
+        auto total_time = start_time();
+        const auto task_executor = available_tasks.at(options.task_name);
+        task_executor(inputs, options);
+        clog << endl;
+        log_and_start_next(total_time, "Finished task '" + options.task_name + "' in " + options.output_path.string());
+    }
+
     int launcher_main(int argc, char** argv) {
         try {
+            configure_executor(parse_executor_options(argc, argv));
+
+            const auto server_socket = parse_server_socket(argc, argv);
+            if (server_socket.has_value()) {
+                JobServer server(server_socket.value(), available_tasks);
+                server.run();
+            }
+
+            const auto merge_folder = parse_merge_folder(argc, argv);
+            if (merge_folder.has_value()) {
+                merge_shards(merge_folder.value());
+                return EXIT_SUCCESS;
+            }
+
             auto options = parse_and_validate(argc, argv, available_tasks);
             const auto& task_output_path = options.output_path;
-            if (is_directory(task_output_path)) {
+            if (options.incremental && is_directory(task_output_path)) {
+                cout << "Updating the outputs in " << task_output_path.string() << endl;
+            } else if (is_directory(task_output_path)) {
                 cout << "Warning: directory '" << task_output_path.string()
                      << "' exists already and will be removed with ALL of its contents." << endl;
                 cout << "This action is irreversible. Continue with deletion? [y/N] ";
@@ -60,15 +103,27 @@ namespace rcsop::launcher {
             }
             create_directories(task_output_path);
 
-            InputDataCollector input_collector(options.input_path, options.camera);
-
-            const auto task_executor = available_tasks.at(options.task_name);
-
-            auto total_time = start_time();
-            task_executor(input_collector, options);
+            const bool use_tracing = !options.trace_path.empty();
+            if (use_tracing) {
+                enable_tracing();
+            }
+            {
+                const auto input_collector = [&options]() {
+                    ScopedSpan input_span("collect_inputs", options.input_path.string());
+                    ScopedMemoryStage input_memory("input_load");
+                    return InputDataCollector(options.input_path, options.camera);
+                }();
+                run_task(input_collector, options, available_tasks);
+            }
 
             clog << endl;
-            log_and_start_next(total_time, "Finished task '" + options.task_name + "', exiting.");
+            write_memory_summary(clog);
+            if (use_tracing) {
+                write_chrome_trace(options.trace_path);
+                clog << endl;
+                write_summary(clog);
+                clog << "Trace written to " << options.trace_path.string() << endl;
+            }
         } catch (const std::exception& e) {
             cerr << "Failed to execute given task, reason:" << endl;
             cerr << e.what() << endl;
@@ -1,7 +1,20 @@
 #ifndef RCSOP_LAUNCHER_H
 #define RCSOP_LAUNCHER_H
 
+#include "utils/task_utils.h"
+
 namespace rcsop::launcher {
+    using rcsop::data::InputDataCollector;
+    using rcsop::launcher::utils::task_options;
+    using rcsop::launcher::utils::launcher_task;
+
+    /**
+     * Executes the task of the options on the inputs, shared by the command line and the job server.
+     */
+    void run_task(const InputDataCollector& inputs,
+                  const task_options& options,
+                  const map<string, launcher_task>& available_tasks);
+
     int launcher_main(int argc, char* argv[]);
 }
 
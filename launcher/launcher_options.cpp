@@ -1,20 +1,34 @@
 #include "launcher_options.h"
 
 #include <iostream>
+#include <sstream>
 #include <chrono>
 #include "boost/program_options.hpp"
 
 #include "utils/task_utils.h"
+#include "utils/rendering_sweep.h"
+#include "utils/sharding.h"
+#include "utils/executor.h"
 
 #include "default_options.h"
 
 namespace rcsop::launcher {
     using rcsop::launcher::utils::PointGenerator;
     using rcsop::launcher::utils::OutputFormat;
+    using rcsop::launcher::utils::rendering_sweep;
+    using rcsop::launcher::utils::shard_options;
+    using rcsop::launcher::utils::shard_folder_name;
+    using rcsop::launcher::utils::rendering_options;
+    using rcsop::launcher::utils::ScoreRange;
+    using rcsop::common::utils::io::content_hash_t;
+    using rcsop::common::utils::io::hash_string;
+    using rcsop::common::utils::io::CONTENT_HASH_SEED;
+    using rcsop::launcher::utils::expand_rendering_variants;
+    using rcsop::common::utils::parallel::executor_options;
+    using rcsop::common::utils::parallel::nesting_policy;
 
     namespace po = boost::program_options;
     using std::chrono::system_clock;
-    using std::cout;
 
     static const char* PARAM_INPUT_PATH = "input-path";
     static const char* PARAM_TASK = "task";
@@ -34,9 +48,24 @@ namespace rcsop::launcher {
     static const char* PARAM_POINT_GENERATOR = "points";
     static const char* PARAM_OUTPUT_FORMAT = "output-format";
     static const char* PARAM_POINT_DENSITY = "density";
+    static const char* PARAM_POINT_SPACING = "spacing";
+    static const char* PARAM_CHUNK_SIZE = "chunk-size";
     static const char* PARAM_GRADIENT_RADIUS = "gradient-radius";
     static const char* PARAM_COLOR_MAP = "color-map";
     static const char* PARAM_ALPHA = "alpha";
+    static const char* PARAM_TRACE = "trace";
+    static const char* PARAM_INCREMENTAL = "incremental";
+    static const char* PARAM_SWEEP_DB_MIN = "sweep-db-min";
+    static const char* PARAM_SWEEP_DB_MAX = "sweep-db-max";
+    static const char* PARAM_SWEEP_COLOR_MAP = "sweep-color-map";
+    static const char* PARAM_SWEEP_ALPHA = "sweep-alpha";
+    static const char* PARAM_SWEEP_GRADIENT_RADIUS = "sweep-gradient-radius";
+    static const char* PARAM_SERVE = "serve";
+    static const char* PARAM_SCORED_PATH = "scored-path";
+    static const char* PARAM_SHARD = "shard";
+    static const char* PARAM_MERGE = "merge";
+    static const char* PARAM_THREADS = "threads";
+    static const char* PARAM_NESTING = "nesting";
 
     [[nodiscard]] static string get_current_timestamp() {
         const auto now = system_clock::now();
@@ -62,6 +91,20 @@ namespace rcsop::launcher {
         }
     }
 
+    static void validate_rendering_options(const ScoreRange& db_range,
+                                           const rendering_options& rendering) {
+        auto gradient_alpha = rendering.gradient.center_alpha;
+        if (gradient_alpha > 1. || gradient_alpha <= 0.) {
+            throw invalid_argument("Gradient center alpha must be within (0, 1].");
+        }
+        if (rendering.gradient.radius <= 0) {
+            throw invalid_argument("Gradient radius must be larger than 0.");
+        }
+        if (db_range.min >= db_range.max) {
+            throw invalid_argument("dB range must be well defined: lower bound smaller than the upper bound.");
+        }
+    }
+
     static void validate_task_options(const task_options& options) {
         if (options.camera.distance_to_origin <= 0.) {
             throw invalid_argument("Camera distance must be greater than zero.");
@@ -69,25 +112,59 @@ namespace rcsop::launcher {
         if (options.camera.default_height <= 0) {
             throw invalid_argument("Default camera height must be non-negative.");
         }
-        auto gradient_alpha = options.rendering.gradient.center_alpha;
-        if (gradient_alpha > 1. || gradient_alpha <= 0.) {
-            throw invalid_argument("Gradient center alpha must be within (0, 1].");
-        }
-        if (options.rendering.gradient.radius <= 0) {
-            throw invalid_argument("Gradient radius must be larger than 0.");
-        }
-        if (options.db_range.min >= options.db_range.max) {
-            throw invalid_argument("dB range must be well defined: lower bound smaller than the upper bound.");
+        validate_rendering_options(options.db_range, options.rendering);
+        if (options.sweep.enabled()) {
+            for (const auto& variant: expand_rendering_variants(options.sweep, options.rendering)) {
+                validate_rendering_options(variant.db_range, variant.rendering);
+            }
         }
         if (options.point_density <= 0) {
             throw invalid_argument("Point density must be a positive integer.");
         }
+        if (options.point_spacing < 0) {
+            throw invalid_argument("Point spacing must not be negative.");
+        }
+        if (options.chunk_size > 0 && options.point_spacing > 0) {
+            throw invalid_argument("The point spacing needs all base points at once and cannot be combined with chunks.");
+        }
         if (options.vertical_options.angle_spread <= 0) {
             throw invalid_argument("No data to display with a negative vertical angle spread.");
         }
         if (options.vertical_options.normal_variance == 0) {
             throw invalid_argument("Vertical spread variance must not be 0.");
         }
+        if (options.shard.enabled() && options.task_name != DEFAULT_TASK) {
+            throw invalid_argument("Only the task " + DEFAULT_TASK + " can be split into shards.");
+        }
+    }
+
+    static auto parse_shard_option(const string& option) -> shard_options {
+        if (option.empty()) {
+            return {};
+        }
+        const string format_error = string(PARAM_SHARD) + " must be given as <index>/<count>, e.g. 0/4.";
+        const auto separator = option.find('/');
+        if (separator == string::npos) {
+            throw invalid_argument(format_error);
+        }
+        const auto index_value = option.substr(0, separator);
+        const auto count_value = option.substr(separator + 1);
+        shard_options shard;
+        size_t parsed_index_length = 0;
+        size_t parsed_count_length = 0;
+        try {
+            shard.index = std::stoul(index_value, &parsed_index_length);
+            shard.count = std::stoul(count_value, &parsed_count_length);
+        } catch (const std::logic_error&) {
+            throw invalid_argument(format_error);
+        }
+        if (parsed_index_length != index_value.size() || parsed_count_length != count_value.size()) {
+            throw invalid_argument(format_error);
+        }
+        if (shard.count == 0 || shard.index >= shard.count) {
+            throw invalid_argument(string(PARAM_SHARD) + " index must be smaller than the shard count, counting from 0.");
+        }
+        return shard;
     }
 
     static auto parse_point_generator_option(const string& option) -> PointGenerator {
@@ -113,7 +190,7 @@ namespace rcsop::launcher {
                                + " must be one of the following: model, model-sparse, model-dense, bounding-box, data-projection or model-with-projection.");
     }
 
-    static auto parse_output_format_option(const string& option) -> OutputFormat {
+    static auto parse_single_output_format(const string& option) -> OutputFormat {
         if (option == "all") {
             return OutputFormat::BOTH;
         }
@@ -123,11 +200,142 @@ namespace rcsop::launcher {
         if (option == "image") {
             return OutputFormat::RENDERING;
         }
+        if (option == "ply") {
+            return OutputFormat::POINT_CLOUD;
+        }
+        if (option == "scored") {
+            return OutputFormat::SCORED_CLOUD;
+        }
         if (option == "none") {
             return OutputFormat::NONE;
         }
         throw invalid_argument(string(PARAM_OUTPUT_FORMAT)
-                               + " must be one of the following: all, image, model or none.");
+                               + " must be one of the following or a comma-separated list of them: all, image, model, ply, scored or none.");
+    }
+
+    static auto parse_nesting_option(const string& option) -> nesting_policy {
+        if (option == "points") {
+            return nesting_policy::INNER_LOOPS;
+        }
+        if (option == "observers") {
+            return nesting_policy::OUTER_LOOPS;
+        }
+        if (option == "tasks") {
+            return nesting_policy::TASKS;
+        }
+        throw invalid_argument(string(PARAM_NESTING) + " must be one of points, observers or tasks.");
+    }
+
+    static auto parse_output_format_option(const string& option) -> OutputFormat {
+        std::stringstream option_stream(option);
+        string single_option;
+        int result = OutputFormat::NONE;
+        while (std::getline(option_stream, single_option, ',')) {
+            result |= parse_single_output_format(single_option);
+        }
+        return static_cast<OutputFormat>(result);
+    }
+
+    template<typename Value>
+    static auto parse_sweep_list(const po::variables_map& vm,
+                                 const char* param,
+                                 const std::function<Value(const string&)>& parse_value) -> vector<Value> {
+        std::stringstream option_stream(vm.at(param).as<string>());
+        string single_option;
+        vector<Value> result;
+        while (std::getline(option_stream, single_option, ',')) {
+            try {
+                result.push_back(parse_value(single_option));
+            } catch (const std::logic_error&) {
+                throw invalid_argument(string(param) + " must be a comma-separated list, could not parse '"
+                                       + single_option + "'.");
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Reads the swept rendering values. If any list is given, the missing ones fall back to the single value
+     * of the regular option, so each list holds at least one value.
+     */
+    static auto parse_rendering_sweep(const po::variables_map& vm) -> rendering_sweep {
+        rendering_sweep sweep{
+                .db_min = parse_sweep_list<double>(vm, PARAM_SWEEP_DB_MIN, [](const string& value) {
+                    return std::stod(value);
+                }),
+                .db_max = parse_sweep_list<double>(vm, PARAM_SWEEP_DB_MAX, [](const string& value) {
+                    return std::stod(value);
+                }),
+                .color_maps = parse_sweep_list<string>(vm, PARAM_SWEEP_COLOR_MAP, [](const string& value) {
+                    return value;
+                }),
+                .alphas = parse_sweep_list<float>(vm, PARAM_SWEEP_ALPHA, [](const string& value) {
+                    return std::stof(value);
+                }),
+                .gradient_radii = parse_sweep_list<float>(vm, PARAM_SWEEP_GRADIENT_RADIUS, [](const string& value) {
+                    return std::stof(value);
+                }),
+        };
+        if (sweep.db_min.empty() && sweep.db_max.empty() && sweep.color_maps.empty()
+            && sweep.alphas.empty() && sweep.gradient_radii.empty()) {
+            return sweep;
+        }
+        if (sweep.db_min.empty()) {
+            sweep.db_min.push_back(vm.at(PARAM_DB_MIN).as<double>());
+        }
+        if (sweep.db_max.empty()) {
+            sweep.db_max.push_back(vm.at(PARAM_DB_MAX).as<double>());
+        }
+        if (sweep.color_maps.empty()) {
+            sweep.color_maps.push_back(vm.at(PARAM_COLOR_MAP).as<string>());
+        }
+        if (sweep.alphas.empty()) {
+            sweep.alphas.push_back(vm.at(PARAM_ALPHA).as<float>());
+        }
+        if (sweep.gradient_radii.empty()) {
+            sweep.gradient_radii.push_back(vm.at(PARAM_GRADIENT_RADIUS).as<float>());
+        }
+        return sweep;
+    }
+
+    static auto describe_option_value(const po::variable_value& option) -> string {
+        const auto& value = option.value();
+        std::ostringstream description;
+        description << std::setprecision(17);
+        if (const auto* text = boost::any_cast<string>(&value)) {
+            description << *text;
+        } else if (const auto* flag = boost::any_cast<bool>(&value)) {
+            description << *flag;
+        } else if (const auto* double_value = boost::any_cast<double>(&value)) {
+            description << *double_value;
+        } else if (const auto* float_value = boost::any_cast<float>(&value)) {
+            description << *float_value;
+        } else if (const auto* size_value = boost::any_cast<size_t>(&value)) {
+            description << *size_value;
+        } else if (const auto* height_value = boost::any_cast<height_t>(&value)) {
+            description << *height_value;
+        } else {
+            throw std::logic_error("Option of an unknown type, cannot be fingerprinted.");
+        }
+        return description.str();
+    }
+
+    /**
+     * Hash over all options that influence the outputs. The paths are left out, the inputs are hashed by
+     * their content instead, as well as the options that only control the run itself.
+     */
+    static auto hash_output_parameters(const po::variables_map& vm) -> content_hash_t {
+        const set<string> excluded_options{PARAM_INPUT_PATH, PARAM_OUTPUT_PATH, PARAM_OUTPUT_NAME_NO_TIMESTAMP,
+                                           PARAM_INCREMENTAL, PARAM_TRACE, PARAM_SCORED_PATH, PARAM_SHARD,
+                                           PARAM_CHUNK_SIZE, PARAM_THREADS, PARAM_NESTING};
+        content_hash_t hash = CONTENT_HASH_SEED;
+        for (const auto& [name, option]: vm) {
+            if (excluded_options.contains(name)) {
+                continue;
+            }
+            hash = hash_string(name + "=" + describe_option_value(option), hash);
+        }
+        return hash;
     }
 
     [[nodiscard]] po::variables_map parse_arguments(int argc, char* argv[]) {
@@ -139,6 +347,8 @@ namespace rcsop::launcher {
                 ("task,T", po::value<string>()->default_value(DEFAULT_TASK), "task to execute")
                 (PARAM_OUTPUT_NAME_NO_TIMESTAMP, po::bool_switch(),
                  "use current timestamp as output folder name")
+                (PARAM_INCREMENTAL, po::bool_switch(),
+                 "keep an existing output folder and only rescore and rerender the observers whose inputs or options changed since the last run in it (azimuth-rcs only, implies no-timestamp)")
                 (PARAM_SOFTWARE_RENDERING, po::bool_switch(),
                  "enable software rendering instead of GPU")
                 ("camera-distance,R", po::value<double>()->default_value(DEFAULT_CAMERA_DISTANCE),
@@ -167,22 +377,99 @@ namespace rcsop::launcher {
                  "use the legacy point generator (only filtering a bounding box or using the sparse cloud model)")
                 (PARAM_POINT_DENSITY, po::value<size_t>()->default_value(DEFAULT_POINT_DENSITY),
                 "point density, either in points per degree or per meter, depending on point generation strategy")
+                (PARAM_POINT_SPACING, po::value<double>()->default_value(DEFAULT_POINT_SPACING),
+                 "minimum spacing between points in centimeters, thins the points of every generator with a voxel grid (0 keeps all points)")
+                (PARAM_CHUNK_SIZE, po::value<size_t>()->default_value(DEFAULT_CHUNK_SIZE),
+                 "observe and accumulate the base points in chunks of the given number of points, binary PLY meshes and generated clouds are then read chunk by chunk instead of being held in memory (0 keeps all points in memory)")
                 (PARAM_COLOR_MAP, po::value<string>()->default_value(DEFAULT_COLOR_MAP),
                  "default color map to use")
                 (PARAM_ALPHA, po::value<float>()->default_value(DEFAULT_ALPHA),
                  "base alpha value/factor to apply and full color intensity")
                 (PARAM_OUTPUT_FORMAT, po::value<string>()->default_value(DEFAULT_OUTPUT_FORMAT),
-                 "output formats enabled for the processing, defaults to both available ones");
+                 "output formats enabled for the processing (all, image, model, ply, scored, none or a comma-separated combination), defaults to images and sparse models. scored keeps the scored points of every observer for render-scored")
+                (PARAM_SHARD, po::value<string>()->default_value(""),
+                 "only process a part of the observers, given as <index>/<count> with the index counting from 0. Each shard writes into <output>/<task>/shard-<index>-of-<count> (azimuth-rcs only, implies no-timestamp), combine them with --merge <output>/<task>")
+                (PARAM_THREADS, po::value<size_t>()->default_value(DEFAULT_THREADS),
+                 "upper limit of the threads used by all parallel loops, 0 for one per core. Applies to the whole process, for a job server when it is started")
+                (PARAM_NESTING, po::value<string>()->default_value(DEFAULT_NESTING),
+                 "which loops run in parallel: points scores one observer after the other with all threads on its points, observers scores several observers at once with the points of each on a single thread (needs more memory, bound it with chunk-size), tasks splits every observer into one task per label and chunk that idle threads take over from busy ones")
+                (PARAM_SCORED_PATH, po::value<string>()->default_value(""),
+                 "output folder of an earlier run with the scored output format, render-scored renders its scored points without scoring again")
+                (PARAM_TRACE, po::value<string>()->default_value(""),
+                 "write a Chrome trace (chrome://tracing or Perfetto) of all pipeline stages to the given file and print a summary per stage")
+                (PARAM_SWEEP_DB_MIN, po::value<string>()->default_value(""),
+                 "comma-separated lower dB bounds to render images for, scores once and renders every combination of the sweep options into its own folder (azimuth-rcs only)")
+                (PARAM_SWEEP_DB_MAX, po::value<string>()->default_value(""),
+                 "comma-separated upper dB bounds to render images for")
+                (PARAM_SWEEP_COLOR_MAP, po::value<string>()->default_value(""),
+                 "comma-separated color maps to render images for")
+                (PARAM_SWEEP_ALPHA, po::value<string>()->default_value(""),
+                 "comma-separated alpha values to render images for")
+                (PARAM_SWEEP_GRADIENT_RADIUS, po::value<string>()->default_value(""),
+                 "comma-separated gradient radii to render images for");
         po::variables_map vm;
         po::store(po::parse_command_line(argc, argv, desc), vm);
         po::notify(vm);
         if (!vm.count(PARAM_INPUT_PATH) || !vm.count(PARAM_OUTPUT_PATH)) {
-            cout << desc;
-            exit(EXIT_FAILURE);
+            std::ostringstream usage;
+            usage << "Input and output path are required." << std::endl << desc;
+            throw invalid_argument(usage.str());
         }
         return vm;
     }
 
+    optional<path> parse_server_socket(int argc, char* argv[]) {
+        po::options_description desc("Job server");
+        desc.add_options()
+                (PARAM_SERVE, po::value<string>(),
+                 "serve task requests on the given Unix domain socket and keep the inputs of all requests in memory");
+        po::variables_map vm;
+        po::store(po::command_line_parser(argc, argv).options(desc).allow_unregistered().run(), vm);
+        po::notify(vm);
+        if (!vm.count(PARAM_SERVE)) {
+            return std::nullopt;
+        }
+        return path{vm.at(PARAM_SERVE).as<string>()};
+    }
+
+    [[nodiscard]] static po::variables_map parse_executor_arguments(int argc, char* argv[]) {
+        po::options_description desc("Executor");
+        desc.add_options()
+                (PARAM_THREADS, po::value<size_t>()->default_value(DEFAULT_THREADS))
+                (PARAM_NESTING, po::value<string>()->default_value(DEFAULT_NESTING));
+        po::variables_map vm;
+        po::store(po::command_line_parser(argc, argv).options(desc).allow_unregistered().run(), vm);
+        po::notify(vm);
+        return vm;
+    }
+
+    executor_options parse_executor_options(int argc, char* argv[]) {
+        const auto vm = parse_executor_arguments(argc, argv);
+        return {
+                .threads = vm.at(PARAM_THREADS).as<size_t>(),
+                .nesting = parse_nesting_option(vm.at(PARAM_NESTING).as<string>()),
+        };
+    }
+
+    bool has_executor_options(int argc, char* argv[]) {
+        const auto vm = parse_executor_arguments(argc, argv);
+        return !vm.at(PARAM_THREADS).defaulted() || !vm.at(PARAM_NESTING).defaulted();
+    }
+
+    optional<path> parse_merge_folder(int argc, char* argv[]) {
+        po::options_description desc("Shard merging");
+        desc.add_options()
+                (PARAM_MERGE, po::value<string>(),
+                 "combine the finished shard folders below the given task folder into <folder>/merged and exit");
+        po::variables_map vm;
+        po::store(po::command_line_parser(argc, argv).options(desc).allow_unregistered().run(), vm);
+        po::notify(vm);
+        if (!vm.count(PARAM_MERGE)) {
+            return std::nullopt;
+        }
+        return path{vm.at(PARAM_MERGE).as<string>()};
+    }
+
     task_options parse_and_validate(int argc, char* argv[],
                                     const map<string, launcher_task>& available_tasks) {
         auto vm = parse_arguments(argc, argv);
@@ -193,11 +480,18 @@ namespace rcsop::launcher {
         validate_main_task(input_path, output_path, task, available_tasks);
 
         path task_output_path{output_path / task};
-        const bool use_timestamps_as_output_name = !vm.at(PARAM_OUTPUT_NAME_NO_TIMESTAMP).as<bool>();
+        const bool incremental = vm.at(PARAM_INCREMENTAL).as<bool>();
+        const shard_options shard = parse_shard_option(vm.at(PARAM_SHARD).as<string>());
+        // the shards of one run are started separately and have to end up in the same task folder
+        const bool use_timestamps_as_output_name = !vm.at(PARAM_OUTPUT_NAME_NO_TIMESTAMP).as<bool>() && !incremental
+                                                   && !shard.enabled();
         if (use_timestamps_as_output_name) {
             auto output_target_folder = get_current_timestamp();
             task_output_path = output_path / task / output_target_folder;
         }
+        if (shard.enabled()) {
+            task_output_path /= shard_folder_name(shard);
+        }
 
         const double camera_distance{vm.at(PARAM_CAMERA_DISTANCE).as<double>()};
         const height_t default_camera_height{vm.at(PARAM_DEFAULT_HEIGHT).as<height_t>()};
@@ -215,7 +509,12 @@ namespace rcsop::launcher {
         const bool force_use_original_image = vm.at(PARAM_FORCE_ORIGINAL_IMAGE).as<bool>();
         const PointGenerator point_generator = parse_point_generator_option(vm.at(PARAM_POINT_GENERATOR).as<string>());
         const size_t point_density = vm.at(PARAM_POINT_DENSITY).as<size_t>();
+        const double point_spacing = vm.at(PARAM_POINT_SPACING).as<double>();
+        const size_t chunk_size = vm.at(PARAM_CHUNK_SIZE).as<size_t>();
         const OutputFormat output_format = parse_output_format_option(vm.at(PARAM_OUTPUT_FORMAT).as<string>());
+        const path trace_path{vm.at(PARAM_TRACE).as<string>()};
+        const path scored_path{vm.at(PARAM_SCORED_PATH).as<string>()};
+        const rendering_sweep sweep = parse_rendering_sweep(vm);
 
         task_options options{
                 .task_name = task,
@@ -228,6 +527,8 @@ namespace rcsop::launcher {
                 },
                 .point_generator = point_generator,
                 .point_density = point_density,
+                .point_spacing = point_spacing,
+                .chunk_size = chunk_size,
                 .db_range = {
                         .min = min_db,
                         .max = max_db,
@@ -247,7 +548,13 @@ namespace rcsop::launcher {
                                 .center_alpha = base_alpha,
                         },
                 },
+                .sweep = sweep,
                 .output_format = output_format,
+                .scored_path = scored_path,
+                .trace_path = trace_path,
+                .incremental = incremental,
+                .shard = shard,
+                .parameter_hash = hash_output_parameters(vm),
         };
         validate_task_options(options);
         return options;
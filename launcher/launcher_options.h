@@ -2,6 +2,7 @@
 #define RCSOP_LAUNCHER_LAUNCHER_OPTIONS_H
 
 #include "utils/task_utils.h"
+#include "utils/executor.h"
 
 namespace rcsop::launcher {
     using rcsop::launcher::utils::task_options;
@@ -10,5 +11,26 @@ namespace rcsop::launcher {
     [[nodiscard]] task_options parse_and_validate(
             int argc, char* argv[],
             const map<string, launcher_task>& available_tasks);
+
+    /**
+     * Socket path of --serve, if the launcher should run as a job server instead of a single task.
+     */
+    [[nodiscard]] optional<path> parse_server_socket(int argc, char* argv[]);
+
+    /**
+     * Thread limit and nesting policy of --threads and --nesting, they apply to the whole process.
+     */
+    [[nodiscard]] auto parse_executor_options(int argc,
+                                              char* argv[]) -> rcsop::common::utils::parallel::executor_options;
+
+    /**
+     * True if --threads or --nesting are given, as opposed to left at their defaults.
+     */
+    [[nodiscard]] bool has_executor_options(int argc, char* argv[]);
+
+    /**
+     * Task folder of --merge, if the launcher should combine the shards in it instead of running a task.
+     */
+    [[nodiscard]] optional<path> parse_merge_folder(int argc, char* argv[]);
 }
 #endif //RCSOP_LAUNCHER_LAUNCHER_OPTIONS_H
@@ -4,17 +4,26 @@
 #include "utils/mapping.h"
 #include "utils/gauss.h"
 #include "utils/point_scoring.h"
+#include "utils/rendering_sweep.h"
+#include "utils/run_manifest.h"
+#include "utils/sharding.h"
+#include "utils/content_hash.h"
+#include "utils/tracing.h"
 
 #include "colors.h"
 #include "observer.h"
 #include "output_data_writer.h"
 #include "model_writer.h"
+#include "ply_point_cloud_writer.h"
 #include "observer_renderer.h"
 #include "scored_cloud.h"
+#include "scored_cloud_file.h"
 #include "azimuth_minimap_provider.h"
+#include "observer_provider.h"
 
 namespace rcsop::launcher::tasks {
-    using rcsop::common::utils::gauss::rcs_gaussian_vertical;
+    namespace parallel = rcsop::common::utils::parallel;
+
     using rcsop::common::utils::points::vec2;
     using rcsop::common::utils::map_vec;
 
@@ -24,6 +33,11 @@ namespace rcsop::launcher::tasks {
     using rcsop::common::OutputDataWriter;
     using rcsop::common::multiple_scored_cloud_payload;
     using rcsop::common::scored_cloud_payload;
+    using rcsop::common::ScoredPoint;
+    using rcsop::common::ScoredCloudFile;
+    using rcsop::common::ObserverPosition;
+    using rcsop::common::write_scored_cloud;
+    using rcsop::common::SCORED_CLOUD_EXTENSION;
 
     using rcsop::data::AZIMUTH_RCS_MAT;
     using rcsop::data::AZIMUTH_RCS_MINIMAP;
@@ -31,6 +45,7 @@ namespace rcsop::launcher::tasks {
     using rcsop::data::AbstractDataCollection;
     using rcsop::data::AzimuthMinimapProvider;
     using rcsop::data::ModelWriter;
+    using rcsop::data::PlyPointCloudWriter;
 
     using rcsop::rendering::texture_rendering_options;
     using rcsop::rendering::ObserverRenderer;
@@ -39,69 +54,106 @@ namespace rcsop::launcher::tasks {
     using rcsop::common::global_colormap_func;
 
     using rcsop::launcher::utils::data_with_observer_options;
+    using rcsop::launcher::utils::map_labeled_data;
+    using rcsop::launcher::utils::score_points_with_peaks;
     using rcsop::launcher::utils::OutputFormat;
+    using rcsop::launcher::utils::expand_rendering_variants;
+    using rcsop::launcher::utils::lowest_db_min;
+    using rcsop::launcher::utils::drop_points_below;
+    using rcsop::launcher::utils::render_variants;
+    using rcsop::launcher::utils::observer_predicate;
+    using rcsop::launcher::utils::RunManifest;
+    using rcsop::launcher::utils::shard_assignment;
+    using rcsop::launcher::utils::assign_shard;
+    using rcsop::launcher::utils::write_shard_record;
+    using rcsop::launcher::utils::SHARD_RECORD_FILE_NAME;
+
+    using rcsop::common::utils::io::content_hash_t;
+    using rcsop::common::utils::io::hash_string;
+    using rcsop::common::utils::io::to_hex;
+    using rcsop::common::utils::tracing::ScopedSpan;
+    using rcsop::common::Observer;
+    using rcsop::common::height_t;
+    using rcsop::data::InputAssetType;
+    using rcsop::launcher::utils::resident_observer_provider;
 
     using std::clog;
     using std::endl;
 
-    static const regex data_label_pattern("^(\\d{1,3})(°)?$");
-
-    static auto translate_label_to_translation(const string& label) -> data_observer_translation {
-        smatch label_match;
-        if (!regex_match(label, label_match, data_label_pattern)) {
-            std::clog << "Warning: RCS data folder doesn't match expected name pattern, using default rotation value."
-                      << std::endl;
-            return {};
-        }
-        long roll_degrees = std::stoi(label_match[1]);
-        data_observer_translation observer_translation{
-                .roll = static_cast<double>(roll_degrees),
-        };
-        return observer_translation;
-    }
+    const static string SCORED_CLOUD_FOLDER = "scored";
+    const static string SCORED_MODEL_FOLDER = "model";
+    const static string SCORED_IMAGE_FOLDER = "image";
 
-    static auto map_labeled_data(const map<string, shared_ptr<AzimuthRcsDataCollection>>& data) {
-        vector<data_with_observer_options> result;
-        for (auto& [label, data_set]: data) {
-            auto observer_translation = translate_label_to_translation(label);
-            result.push_back(
-                    {
-                            .observer_options = observer_translation,
-                            .data_collection = data_set
-                    });
-        }
-        return result;
-    }
-
-    static void plot_to_images(const multiple_scored_cloud_payload& payload,
-                               const AzimuthMinimapProvider& minimaps,
-                               const global_colormap_func& color_map,
-                               const task_options& options) {
-        texture_rendering_options minimap_position = {
+    static void add_minimap(const AzimuthMinimapProvider& minimaps,
+                            const ScoredCloud& scored_cloud,
+                            ObserverRenderer& renderer) {
+        const texture_rendering_options minimap_position = {
                 .coordinates = vec2(915., 420.),
                 .size = vec2(400., 300.),
         };
+        const auto& minimap = minimaps.for_position(scored_cloud.observer());
+        renderer.add_texture(minimap, minimap_position);
+    }
 
+    static auto create_image_writers(const multiple_scored_cloud_payload& payload,
+                                     const AzimuthMinimapProvider& minimaps,
+                                     const global_colormap_func& color_map,
+                                     const task_options& options) -> vector<shared_ptr<OutputDataWriter>> {
         auto& point_clouds = payload.point_clouds;
-        auto renderers = map_vec<ScoredCloud, shared_ptr<OutputDataWriter>>(
+        return map_vec<ScoredCloud, shared_ptr<OutputDataWriter>>(
                 point_clouds,
-                [&color_map, &options, &minimaps, &minimap_position]
+                [&color_map, &options, &minimaps]
                         (const ScoredCloud& scored_cloud) -> shared_ptr<OutputDataWriter> {
                     auto renderer = make_shared<ObserverRenderer>(scored_cloud, color_map, options.rendering,
                                                                   options.camera.distance_to_origin);
-                    const auto& minimap = minimaps.for_position(scored_cloud.observer());
-
-                    renderer->add_texture(minimap, minimap_position);
+                    add_minimap(minimaps, scored_cloud, *renderer);
                     return renderer;
                 });
-        auto heights = payload.observer_heights();
-        batch_output(renderers, options, heights);
+    }
+
+    static auto create_point_cloud_writers(const multiple_scored_cloud_payload& payload)
+    -> vector<shared_ptr<OutputDataWriter>> {
+        auto point_clouds_exploded = payload.extract_single_payloads();
+        return map_vec<scored_cloud_payload, shared_ptr<OutputDataWriter>>(
+                point_clouds_exploded,
+                [](const scored_cloud_payload& single_payload) -> shared_ptr<OutputDataWriter> {
+                    return make_shared<PlyPointCloudWriter>(single_payload);
+                });
+    }
+
+    static void plot_to_images(const multiple_scored_cloud_payload& payload,
+                               const multiple_scored_cloud_payload& sweep_payload,
+                               const AzimuthMinimapProvider& minimaps,
+                               const global_colormap_func& color_map,
+                               const task_options& options,
+                               const vector<height_t>& heights) {
+        const bool with_rendering = (options.output_format & OutputFormat::RENDERING) != 0;
+        vector<shared_ptr<OutputDataWriter>> output_writers;
+        if (with_rendering && !options.sweep.enabled()) {
+            auto renderers = create_image_writers(payload, minimaps, color_map, options);
+            output_writers.insert(output_writers.end(), renderers.begin(), renderers.end());
+        }
+        if ((options.output_format & OutputFormat::POINT_CLOUD) != 0) {
+            auto point_cloud_writers = create_point_cloud_writers(payload);
+            output_writers.insert(output_writers.end(), point_cloud_writers.begin(), point_cloud_writers.end());
+        }
+        batch_output(output_writers, options, heights);
+
+        if (with_rendering && options.sweep.enabled()) {
+            const auto variants = expand_rendering_variants(options.sweep, options.rendering);
+            clog << endl << "Rendering " << variants.size() << " variants per observer ..." << endl;
+            render_variants(sweep_payload, variants, options, heights,
+                            [&minimaps](const ScoredCloud& scored_cloud, ObserverRenderer& renderer) {
+                                add_minimap(minimaps, scored_cloud, renderer);
+                            });
+        }
     }
 
     static void plot_to_models(const multiple_scored_cloud_payload& payload,
                                const InputDataCollector& inputs,
                                const global_colormap_func& color_map,
-                               const task_options& options) {
+                               const task_options& options,
+                               const vector<height_t>& heights) {
         auto point_clouds_exploded = payload.extract_single_payloads();
         auto model_writers = map_vec<scored_cloud_payload, shared_ptr<OutputDataWriter>>(
                 point_clouds_exploded,
@@ -113,39 +165,364 @@ namespace rcsop::launcher::tasks {
                     return model_writer;
                 });
 
-        auto heights = payload.observer_heights();
         batch_output(model_writers, options, heights);
     }
 
-    void azimuth_rcs_plotter(const InputDataCollector& inputs,
-                             const task_options& options) {
+    /**
+     * Keeps the scored points of every observer in <output>/scored/<kind>, one file per observer.
+     */
+    static void write_scored_payload(const multiple_scored_cloud_payload& payload,
+                                     const task_options& options,
+                                     const string& kind) {
+        if ((options.output_format & OutputFormat::SCORED_CLOUD) == 0) {
+            return;
+        }
+        ScopedSpan span("write_scored_clouds", kind);
+        const path folder = options.output_path / SCORED_CLOUD_FOLDER / kind;
+        create_directories(folder);
+        parallel::for_each<false>(payload.point_clouds.cbegin(), payload.point_clouds.cend(),
+                                  [&folder](const ScoredCloud& cloud) {
+                                      const auto position = cloud.observer().position();
+                                      write_scored_cloud(folder / ScoredCloudFile::file_name(position), position,
+                                                         *cloud.points());
+                                  });
+        clog << "Kept the scored points of " << payload.point_clouds.size() << " observers in "
+             << folder.string() << endl;
+    }
+
+    static void plot_scored_images(const multiple_scored_cloud_payload& payload,
+                                   const multiple_scored_cloud_payload& sweep_payload,
+                                   const AzimuthMinimapProvider& minimaps,
+                                   const global_colormap_func& color_map,
+                                   const task_options& options,
+                                   const vector<height_t>& heights) {
+        if ((options.output_format & (OutputFormat::RENDERING | OutputFormat::POINT_CLOUD)) == 0) {
+            return;
+        }
+        clog << endl << "Rendering to images/point clouds ..." << endl;
+        plot_to_images(payload, sweep_payload, minimaps, color_map, options, heights);
+    }
+
+    static auto output_kinds(const task_options& options) -> vector<string> {
+        vector<string> kinds;
+        if ((options.output_format & OutputFormat::SPARSE_MODEL) != 0) {
+            kinds.emplace_back("model");
+        }
+        if ((options.output_format & OutputFormat::RENDERING) != 0) {
+            kinds.emplace_back("image");
+        }
+        if ((options.output_format & OutputFormat::POINT_CLOUD) != 0) {
+            kinds.emplace_back("ply");
+        }
+        if ((options.output_format & OutputFormat::SCORED_CLOUD) != 0) {
+            kinds.emplace_back("scored");
+        }
+        return kinds;
+    }
+
+    struct observer_fingerprints {
+        vector<height_t> heights;
+        map<string, string> by_position;
+    };
+
+    /**
+     * Fingerprint of everything the outputs of an observer depend on: the options, the models shared by all
+     * observers, its source image, its minimap and its data file of every label. Only the included observers
+     * are fingerprinted, the heights cover all of them.
+     */
+    static auto fingerprint_observers(const InputDataCollector& inputs,
+                                      const vector<data_with_observer_options>& labeled_data,
+                                      const AzimuthMinimapProvider& minimaps,
+                                      const task_options& options,
+                                      const observer_predicate& include_observer,
+                                      RunManifest& manifest) -> observer_fingerprints {
+        ScopedSpan span("fingerprint_inputs");
+        content_hash_t shared_hash = hash_string(options.task_name, options.parameter_hash);
+        for (const auto asset_type: {InputAssetType::SPARSE_CLOUD_COLMAP, InputAssetType::DENSE_MESH_PLY}) {
+            for (const auto& asset_path: inputs.asset_paths(asset_type)) {
+                shared_hash = hash_string(to_hex(manifest.input_hash(asset_path)), shared_hash);
+            }
+        }
+
+        const bool with_minimaps = (options.output_format & OutputFormat::RENDERING) != 0;
+        const auto observer_provider = resident_observer_provider(inputs, options.camera, true);
+        const auto all_observers = observer_provider->observers_with_positions();
+        vector<Observer> observers;
+        for (const auto& observer: all_observers) {
+            if (include_observer == nullptr || include_observer(observer)) {
+                observers.push_back(observer);
+            }
+        }
+        const auto fingerprints = map_vec<Observer, string>(
+                observers,
+                [&labeled_data, &minimaps, &manifest, shared_hash, with_minimaps](const Observer& observer) {
+                    content_hash_t hash = hash_string(observer.position().str(), shared_hash);
+                    hash = hash_string(to_hex(manifest.input_hash(observer.source_image_path())), hash);
+                    if (with_minimaps) {
+                        const auto minimap_path = minimaps.for_position(observer).file_path();
+                        hash = hash_string(to_hex(manifest.input_hash(minimap_path)), hash);
+                    }
+                    for (const auto& [observer_options, data_collection]: labeled_data) {
+                        const auto data_path = data_collection->get_for_exact_position(observer)->source_path();
+                        hash = hash_string(std::to_string(observer_options.roll), hash);
+                        hash = hash_string(to_hex(manifest.input_hash(data_path)), hash);
+                    }
+                    return to_hex(hash);
+                });
+
+        observer_fingerprints result;
+        set<height_t> heights;
+        for (const auto& observer: all_observers) {
+            heights.insert(observer.position().height);
+        }
+        for (size_t index = 0; index < observers.size(); index++) {
+            result.by_position.insert(make_pair(observers[index].position().str(), fingerprints[index]));
+        }
+        result.heights = vector<height_t>(heights.cbegin(), heights.cend());
+        return result;
+    }
+
+    static void score_and_plot(const InputDataCollector& inputs,
+                               const map<string, shared_ptr<AzimuthRcsDataCollection>>& azimuth_data,
+                               const AzimuthMinimapProvider& minimaps,
+                               const task_options& options,
+                               const observer_predicate& include_observer,
+                               const optional<vector<height_t>>& all_heights) {
         ScoreRange range = options.db_range;
         auto color_map = construct_color_map_function(options.rendering.color_map, range);
 
-        auto azimuth_data = inputs.data<AZIMUTH_RCS_MAT, true>();
-        auto minimaps = inputs.data<AZIMUTH_RCS_MINIMAP, false>();
+        // a sweep scores once down to its lowest bound, each variant drops the points below its own
+        task_options scoring_options = options;
+        if (options.sweep.enabled()) {
+            scoring_options.db_range.min = lowest_db_min(options.sweep);
+        }
+        // models, PLY clouds and the regular images keep the points of the regular range, the scored clouds keep
+        // all points, so a sweep can be rendered again from them
+        const auto regular_points = [&options, &scoring_options](
+                const shared_ptr<multiple_scored_cloud_payload const>& payload)
+                -> shared_ptr<multiple_scored_cloud_payload const> {
+            if (scoring_options.db_range.min >= options.db_range.min) {
+                return payload;
+            }
+            return make_shared<multiple_scored_cloud_payload>(drop_points_below(*payload, options.db_range.min));
+        };
 
         auto data_with_translation = map_labeled_data(azimuth_data);
 
-        if ((options.output_format & OutputFormat::SPARSE_MODEL) != 0) {
+        // when only some observers are scored, the outputs still go into the folders of all heights
+        const auto heights_of = [&all_heights](const multiple_scored_cloud_payload& payload) {
+            return all_heights.has_value() ? *all_heights : payload.observer_heights();
+        };
+
+        const bool with_models = (options.output_format & OutputFormat::SPARSE_MODEL) != 0;
+        const bool with_images = (options.output_format
+                                  & (OutputFormat::RENDERING | OutputFormat::POINT_CLOUD | OutputFormat::SCORED_CLOUD)) != 0;
+
+        if (with_models && with_images) {
+            // models always use the unfiltered data, the images the filtered data if prefiltering is enabled
+            shared_ptr<multiple_scored_cloud_payload const> model_payload;
+            shared_ptr<multiple_scored_cloud_payload const> image_payload;
+            if (options.prefilter_data) {
+                clog << endl << "Scoring points with unfiltered and filtered data ..." << endl;
+                auto [raw_payload, peak_payload] = score_points_with_peaks(
+                        inputs, data_with_translation, scoring_options, color_map, include_observer);
+                model_payload = raw_payload;
+                image_payload = peak_payload;
+            } else {
+                clog << endl << "Scoring points with unfiltered data ..." << endl;
+                model_payload = score_points(inputs, data_with_translation, scoring_options, color_map,
+                                             include_observer);
+                image_payload = model_payload;
+            }
+
+            write_scored_payload(*model_payload, options, SCORED_MODEL_FOLDER);
+            write_scored_payload(*image_payload, options, SCORED_IMAGE_FOLDER);
+
+            clog << endl << "Rendering to sparse cloud models ..." << endl;
+            plot_to_models(*regular_points(model_payload), inputs, color_map, options, heights_of(*model_payload));
+
+            plot_scored_images(*regular_points(image_payload), *image_payload, minimaps, color_map, options,
+                               heights_of(*image_payload));
+            return;
+        }
+
+        if (with_models) {
             clog << endl << "Scoring points with unfiltered data ..." << endl;
-            auto scored_payload = score_points(inputs, data_with_translation, options, color_map);
+            auto scored_payload = score_points(inputs, data_with_translation, scoring_options, color_map,
+                                               include_observer);
+            write_scored_payload(*scored_payload, options, SCORED_MODEL_FOLDER);
 
             clog << endl << "Rendering to sparse cloud models ..." << endl;
-            plot_to_models(*scored_payload, inputs, color_map, options);
+            plot_to_models(*regular_points(scored_payload), inputs, color_map, options, heights_of(*scored_payload));
         }
 
-        if ((options.output_format & OutputFormat::RENDERING) != 0) {
+        if (with_images) {
             if (options.prefilter_data) {
                 for (auto& [_, data]: azimuth_data) {
                     data->use_filtered_peaks();
                 }
             }
             clog << endl << "Scoring points with filtered data ..." << endl;
-            auto scored_payload = score_points(inputs, data_with_translation, options, color_map);
+            auto scored_payload = score_points(inputs, data_with_translation, scoring_options, color_map,
+                                               include_observer);
+            write_scored_payload(*scored_payload, options, SCORED_IMAGE_FOLDER);
+
+            plot_scored_images(*regular_points(scored_payload), *scored_payload, minimaps, color_map, options,
+                               heights_of(*scored_payload));
+        }
+    }
+
+    void azimuth_rcs_plotter(const InputDataCollector& inputs,
+                             const task_options& options) {
+        const auto azimuth_data = inputs.data<AZIMUTH_RCS_MAT, true>();
+        const auto minimaps = inputs.data<AZIMUTH_RCS_MINIMAP, false>();
+
+        optional<shard_assignment> shard;
+        observer_predicate in_shard = nullptr;
+        if (options.shard.enabled()) {
+            const auto observer_provider = resident_observer_provider(inputs, options.camera, true);
+            shard = assign_shard(observer_provider->observers_with_positions(), options.shard);
+            in_shard = [&shard](const Observer& observer) {
+                return shard->contains(observer);
+            };
+            // a record of an earlier run would mark the shard as finished while it is still being written
+            std::filesystem::remove(options.output_path / SHARD_RECORD_FILE_NAME);
+            clog << endl << "Shard " << options.shard.index << " of " << options.shard.count << " covers "
+                 << shard->positions.size() << " of " << shard->total_observers << " observers" << endl;
+        }
+
+        if (!options.incremental) {
+            if (shard.has_value()) {
+                score_and_plot(inputs, azimuth_data, *minimaps, options, in_shard, shard->heights);
+                write_shard_record(options, *shard);
+            } else {
+                score_and_plot(inputs, azimuth_data, *minimaps, options, nullptr, std::nullopt);
+            }
+            return;
+        }
+
+        RunManifest manifest(options.output_path);
+        const auto fingerprints = fingerprint_observers(inputs, map_labeled_data(azimuth_data), *minimaps,
+                                                        options, in_shard, manifest);
 
-            clog << endl << "Rendering to images ..." << endl;
-            plot_to_images(*scored_payload, *minimaps, color_map, options);
+        const auto kinds = output_kinds(options);
+        set<string> changed_positions;
+        for (const auto& [position, fingerprint]: fingerprints.by_position) {
+            const bool up_to_date = std::all_of(kinds.cbegin(), kinds.cend(), [&](const string& kind) {
+                return manifest.is_up_to_date(kind + "/" + position, fingerprint);
+            });
+            if (!up_to_date) {
+                changed_positions.insert(position);
+            }
+        }
+        clog << endl << changed_positions.size() << " of " << fingerprints.by_position.size()
+             << " observers changed since the last run in " << options.output_path.string() << endl;
+
+        if (!changed_positions.empty()) {
+            score_and_plot(inputs, azimuth_data, *minimaps, options, [&changed_positions](const Observer& observer) {
+                return changed_positions.contains(observer.position().str());
+            }, fingerprints.heights);
+        }
+
+        for (const auto& position: changed_positions) {
+            for (const auto& kind: kinds) {
+                manifest.record(kind + "/" + position, fingerprints.by_position.at(position));
+            }
+        }
+        manifest.save();
+        if (shard.has_value()) {
+            write_shard_record(options, *shard);
+        }
+    }
+
+    struct loaded_scored_cloud {
+        ObserverPosition position;
+        shared_ptr<vector<ScoredPoint>> points;
+    };
+
+    /**
+     * Maps the scored clouds of one kind and pairs them with the observers at their positions. Points below
+     * the lower dB bound are dropped while reading, so a run can render a narrower range than it was scored with.
+     */
+    static auto read_scored_payload(const path& folder,
+                                    const vector<Observer>& observers,
+                                    const global_colormap_func& color_map,
+                                    double min_dB) -> multiple_scored_cloud_payload {
+        ScopedSpan span("read_scored_clouds", folder.filename().string());
+        vector<path> cloud_paths;
+        for (const auto& entry: std::filesystem::directory_iterator(folder)) {
+            if (entry.is_regular_file() && entry.path().extension() == SCORED_CLOUD_EXTENSION) {
+                cloud_paths.push_back(entry.path());
+            }
+        }
+        std::sort(cloud_paths.begin(), cloud_paths.end());
+
+        const auto loaded_clouds = map_vec<path, loaded_scored_cloud>(
+                cloud_paths,
+                [min_dB](const path& cloud_path) {
+                    const ScoredCloudFile cloud_file(cloud_path);
+                    return loaded_scored_cloud{
+                            .position = cloud_file.position(),
+                            .points = cloud_file.points(min_dB),
+                    };
+                });
+
+        map<string, const Observer*> observers_by_position;
+        for (const auto& observer: observers) {
+            observers_by_position.insert(make_pair(observer.position().str(), &observer));
+        }
+        multiple_scored_cloud_payload payload{
+                .point_clouds = {},
+                .color_map = color_map,
+        };
+        for (const auto& loaded_cloud: loaded_clouds) {
+            const auto observer = observers_by_position.find(loaded_cloud.position.str());
+            if (observer == observers_by_position.end()) {
+                throw runtime_error("No observer in the inputs at " + loaded_cloud.position.str()
+                                    + " for the scored points in " + folder.string());
+            }
+            payload.point_clouds.emplace_back(*observer->second, loaded_cloud.points);
+        }
+        return payload;
+    }
+
+    void render_scored(const InputDataCollector& inputs,
+                       const task_options& options) {
+        if (options.scored_path.empty()) {
+            throw invalid_argument("render-scored needs the output folder of a scoring run as the scored path.");
+        }
+        const path scored_folder = options.scored_path / SCORED_CLOUD_FOLDER;
+        const path model_folder = scored_folder / SCORED_MODEL_FOLDER;
+        const path image_folder = scored_folder / SCORED_IMAGE_FOLDER;
+        const bool with_models = (options.output_format & OutputFormat::SPARSE_MODEL) != 0;
+        const bool with_images = (options.output_format & (OutputFormat::RENDERING | OutputFormat::POINT_CLOUD)) != 0;
+        if (with_models && !is_directory(model_folder)) {
+            throw invalid_argument("No scored points for models in " + model_folder.string()
+                                   + ", score with the output formats model and scored first.");
+        }
+        if (with_images && !is_directory(image_folder)) {
+            throw invalid_argument("No scored points for images in " + image_folder.string()
+                                   + ", score with the output formats image and scored first.");
+        }
+
+        const auto observer_provider = resident_observer_provider(inputs, options.camera, true);
+        const auto observers = observer_provider->observers_with_positions();
+        // only the sweep images need the points below the regular range
+        const double sweep_min_dB = options.sweep.enabled() ? lowest_db_min(options.sweep) : options.db_range.min;
+        const auto color_map = construct_color_map_function(options.rendering.color_map, options.db_range);
+
+        if (with_models) {
+            const auto payload = read_scored_payload(model_folder, observers, color_map, options.db_range.min);
+            clog << endl << "Rendering " << payload.point_clouds.size() << " scored clouds to sparse cloud models ..."
+                 << endl;
+            plot_to_models(payload, inputs, color_map, options, payload.observer_heights());
+        }
+        if (with_images) {
+            const auto minimaps = inputs.data<AZIMUTH_RCS_MINIMAP, false>();
+            const auto sweep_payload = read_scored_payload(image_folder, observers, color_map,
+                                                           std::min(sweep_min_dB, options.db_range.min));
+            plot_scored_images(drop_points_below(sweep_payload, options.db_range.min), sweep_payload, *minimaps,
+                               color_map, options, sweep_payload.observer_heights());
         }
     }
 }
@@ -10,5 +10,11 @@ namespace rcsop::launcher::tasks {
     void azimuth_rcs_plotter(const InputDataCollector& inputs,
                              const task_options& options);
 
+    /**
+     * Renders the scored clouds kept by an earlier run with the scored output format (see
+     * task_options::scored_path) into models, images and point clouds without scoring again.
+     */
+    void render_scored(const InputDataCollector& inputs,
+                       const task_options& options);
 }
 #endif //RCSOP_LAUNCHER_AZIMUTH_RCS_PLOTTER_H
@@ -1,8 +1,10 @@
 #include "rcs_slices.h"
 
 #include <execution>
+#include <numbers>
 
 #include "utils/logging.h"
+#include "utils/point_scoring.h"
 
 #include "model_camera.h"
 #include "observer_provider.h"
@@ -27,7 +29,7 @@ namespace rcsop::launcher::tasks {
     using rcsop::common::ScoredCloud;
     using rcsop::common::OutputDataWriter;
 
-    using rcsop::data::ObserverProvider;
+    using rcsop::launcher::utils::resident_observer_provider;
     using rcsop::data::PointCloudProvider;
     using rcsop::data::SIMPLE_RCS_MAT;
     using rcsop::common::utils::rcs::rcs_value_t;
@@ -38,6 +40,8 @@ namespace rcsop::launcher::tasks {
 
     using rcsop::launcher::utils::batch_output;
 
+    const static size_t SLICE_TABLE_BINS_PER_DEGREE = 4;
+
     static inline auto flat_down_from_above(const vec3& point) -> vec2 {
         auto res = vec2();
         res.x() = point.x();
@@ -78,21 +82,100 @@ namespace rcsop::launcher::tasks {
         return is_in_triangle(point, midpoint_to_previous, midpoint_to_next, origin);
     }
 
+    static inline auto normalized_angle(const vec2& point) -> double {
+        const double angle = std::atan2(point.y(), point.x());
+        return angle < 0 ? angle + 2 * std::numbers::pi : angle;
+    }
+
+    /**
+     * Angular bins around the origin, each listing the camera slices whose wedge overlaps it, in camera order.
+     * A point is tested only against the slices of its bin (usually one, two at a wedge border) instead of all
+     * of them. As every slice triangle lies within its wedge, the first matching slice is the same as with a
+     * linear search over all cameras.
+     */
+    class AngularSliceTable {
+    private:
+        const vector<vec2>& _image_positions;
+        vec2 _origin;
+        size_t _bin_count;
+        double _bin_width;
+        vector<size_t> _bin_offsets;
+        vector<size_t> _bin_slices;
+
+        [[nodiscard]] auto bin_of(double angle) const -> size_t {
+            return std::min(_bin_count - 1, static_cast<size_t>(angle / _bin_width));
+        }
+
+    public:
+        AngularSliceTable(const vector<vec2>& image_positions, const vec2& origin)
+                : _image_positions(image_positions),
+                  _origin(origin),
+                  _bin_count(360 * SLICE_TABLE_BINS_PER_DEGREE),
+                  _bin_width(2 * std::numbers::pi / static_cast<double>(_bin_count)) {
+            const auto image_count = image_positions.size();
+            vector<vector<size_t>> slices_per_bin(_bin_count);
+            for (size_t image_id = 0; image_id < image_count; image_id++) {
+                const auto& previous_camera = image_positions[image_id == 0 ? image_count - 1 : image_id - 1];
+                const auto& current_camera = image_positions[image_id];
+                const auto& next_camera = image_positions[(image_id + 1) % image_count];
+                const vec2 midpoint_to_previous = (previous_camera + current_camera) / 2 - origin;
+                const vec2 midpoint_to_next = (current_camera + next_camera) / 2 - origin;
+
+                // the triangle with the origin spans the shorter arc between both midpoints
+                double begin = normalized_angle(midpoint_to_previous);
+                double span = normalized_angle(midpoint_to_next) - begin;
+                if (span > std::numbers::pi) {
+                    span -= 2 * std::numbers::pi;
+                } else if (span < -std::numbers::pi) {
+                    span += 2 * std::numbers::pi;
+                }
+                if (span < 0) {
+                    begin = normalized_angle(midpoint_to_next);
+                    span = -span;
+                }
+
+                const auto first_bin = bin_of(begin);
+                const auto covered_bins = static_cast<size_t>((begin + span) / _bin_width) - first_bin + 1;
+                for (size_t i = 0; i < std::min(covered_bins, _bin_count); i++) {
+                    slices_per_bin[(first_bin + i) % _bin_count].push_back(image_id);
+                }
+            }
+
+            _bin_offsets.reserve(_bin_count + 1);
+            _bin_offsets.push_back(0);
+            for (const auto& slices: slices_per_bin) {
+                _bin_slices.insert(_bin_slices.end(), slices.cbegin(), slices.cend());
+                _bin_offsets.push_back(_bin_slices.size());
+            }
+        }
+
+        [[nodiscard]] auto find_slice(const vec2& point) const -> optional<size_t> {
+            const auto bin = bin_of(normalized_angle(point - _origin));
+            const auto image_count = _image_positions.size();
+            for (size_t i = _bin_offsets[bin]; i < _bin_offsets[bin + 1]; i++) {
+                const auto image_id = _bin_slices[i];
+                if (is_within_camera_slice(point, _origin, image_id, image_count, _image_positions)) {
+                    return image_id;
+                }
+            }
+            return {};
+        }
+    };
+
     void rcs_slices(const InputDataCollector& inputs,
                     const task_options& options) {
-        const auto observer_provider = make_shared<ObserverProvider>(inputs, options.camera, false);
+        const auto observer_provider = resident_observer_provider(inputs, options.camera, false);
         const auto point_provider = make_shared<PointCloudProvider>(inputs, options.camera);
 
         auto observers = observer_provider->observers_with_positions();
         const auto cameras = map_vec<Observer, ModelCamera>(observers, &Observer::native_camera);
         const auto image_positions = map_vec<ModelCamera, vec3>(cameras, &ModelCamera::position);
         const auto flattened_image_positions = map_vec<vec3, vec2>(image_positions, flat_down_from_above);
-        const auto image_count = image_positions.size();
-
-        const size_t take_every_nth = options.rendering.use_gpu_rendering ? 20 : 15;
-        const auto base_points = point_provider->get_base_points(data::ReconstructionType::COMPLETE, take_every_nth);
+        const auto base_points = point_provider->get_base_points(data::ReconstructionType::COMPLETE,
+                                                                 options.point_spacing);
 
         const auto origin = vec2(0, 0);
+        const AngularSliceTable slice_table(flattened_image_positions, origin);
         const height_t default_height = options.camera.default_height;
         const auto data = inputs.data<SIMPLE_RCS_MAT>()
                 ->at_height(default_height)
@@ -101,18 +184,13 @@ namespace rcsop::launcher::tasks {
 
         auto points = map_vec_shared<SimplePoint, ScoredPoint, true>(
                 *base_points,
-                [&data, &origin, &flattened_image_positions, &image_count]
-                        (const SimplePoint& point) {
-                    auto flat_point = flat_down_from_above(point.position());
-
-                    for (size_t image_id = 0; image_id < image_count; image_id++) {
-                        if (is_within_camera_slice(flat_point, origin, image_id, image_count,
-                                                   flattened_image_positions)) {
-                            rcs_value_t value = data[image_id];
-                            return ScoredPoint(point.position(), point.id(), value);
-                        }
+                [&data, &slice_table](const SimplePoint& point) {
+                    const auto slice = slice_table.find_slice(flat_down_from_above(point.position()));
+                    if (!slice.has_value()) {
+                        return ScoredPoint(point.position(), point.id());
                     }
-                    return ScoredPoint(point.position(), point.id());
+                    rcs_value_t value = data[*slice];
+                    return ScoredPoint(point.position(), point.id(), value);
                 });
         auto filtered_points = filter_vec_shared<ScoredPoint>(
                 *points, [](const ScoredPoint& point) {
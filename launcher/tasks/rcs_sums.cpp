@@ -24,6 +24,25 @@
 namespace rcsop::launcher::tasks {
     using rcsop::common::utils::gauss::gauss_options;
     using rcsop::common::utils::gauss::get_gauss_integral_factor;
+    using rcsop::common::utils::map_vec;
+
+    using rcsop::common::Observer;
+    using rcsop::common::ScoredPoint;
+    using rcsop::common::ScoredCloud;
+    using rcsop::common::OutputDataWriter;
+    using rcsop::common::observed_point;
+    using rcsop::common::coloring::construct_color_map_function;
+
+    using rcsop::launcher::utils::resident_observer_provider;
+    using rcsop::data::SIMPLE_RCS_MAT;
+    using rcsop::data::AZIMUTH_RCS_MAT;
+
+    using rcsop::rendering::ObserverRenderer;
+
+    using rcsop::launcher::utils::accumulation_source;
+    using rcsop::launcher::utils::accumulate_scores;
+    using rcsop::launcher::utils::map_labeled_data;
+    using rcsop::launcher::utils::batch_output;
 
     const static gauss_options distribution_options = {
             .sigma = STANDARD_DEVIATION,
@@ -32,25 +51,92 @@ namespace rcsop::launcher::tasks {
             .y_scale = VERTICAL_SPREAD,
     };
 
-    void accumulate_rcs(const InputDataCollector& input,
+    /**
+     * Renders the one accumulated cloud from the view of every observer, all renderers share the same points.
+     */
+    static void render_from_all_observers(const shared_ptr<vector<ScoredPoint>>& points,
+                                          const vector<Observer>& observers,
+                                          const task_options& options) {
+        if (points->empty()) {
+            throw runtime_error("No point received a score, nothing to render.");
+        }
+        auto score_range = ScoredPoint::get_score_range(*points);
+        auto color_map = construct_color_map_function(options.rendering.color_map, score_range);
+
+        auto renderers = map_vec<Observer, shared_ptr<OutputDataWriter>>(
+                observers,
+                [&points, &color_map, &options](const Observer& observer) -> shared_ptr<OutputDataWriter> {
+                    ScoredCloud payload(observer, points);
+                    return make_shared<ObserverRenderer>(payload, color_map, options.rendering,
+                                                         options.camera.distance_to_origin);
+                });
+
+        set<height_t> heights;
+        for (const auto& observer: observers) {
+            heights.insert(observer.position().height);
+        }
+        batch_output(renderers, options, vector<height_t>(heights.cbegin(), heights.cend()));
+    }
+
+    void accumulate_rcs(const InputDataCollector& inputs,
                         const task_options& options) {
-        //TODO: WIP
+        const auto observer_provider = resident_observer_provider(inputs, options.camera, false);
+        const auto observers = observer_provider->observers_with_positions();
+        const auto rcs_map = inputs.data<SIMPLE_RCS_MAT>();
+
+        // the RCS sums hold one value per camera for each height, in the same order as the observers
+        vector<accumulation_source> sources;
+        for (const auto height: rcs_map->available_heights()) {
+            const auto rcs = rcs_map->at_height(height)->rcs();
+            size_t camera_index = 0;
+            for (const auto& observer: observers) {
+                if (observer.position().height != height) {
+                    continue;
+                }
+                if (camera_index >= rcs.size()) {
+                    break;
+                }
+                const double value = rcs[camera_index++];
+                sources.push_back({
+                        .observer = observer,
+                        .value_func = [value](const observed_point& point) {
+                            return point.distance_in_world > 0 ? value / point.distance_in_world : NAN;
+                        },
+                });
+            }
+        }
+
+        const auto points = accumulate_scores(inputs, sources, options, distribution_options);
+        render_from_all_observers(points, observers, options);
     }
 
     void accumulate_azimuth(const InputDataCollector& inputs,
                             const task_options& options) {
-        /*
-         //TODO WIP: adapter for BasicRcsMap or refactoring
-        const shared_ptr<BasicRcsMap> rcs_data = inputs->data<SIMPLE_RCS_MAT>(false);
-        const auto scored_payload = score_points(inputs, rcs_data, options.rendering.color_map);
-        const auto& points = scored_payload->point_clouds;
-        const auto& colormap = scored_payload->colormap;
-
-        auto payload_size = points.size();
-        for (size_t index = 1; index <= payload_size; index++) {
-            ScoredCloud scored_cloud = points[index - 1];
-            ObserverRenderer renderer(scored_cloud);
-            renderer.render(output_path, colormap, construct_log_prefix(index, payload_size));
-        }*/
+        const auto observer_provider = resident_observer_provider(inputs, options.camera, true);
+        const auto observers = observer_provider->observers_with_positions();
+        auto azimuth_data = inputs.data<AZIMUTH_RCS_MAT, true>();
+        if (options.prefilter_data) {
+            for (auto& [_, data]: azimuth_data) {
+                data->use_filtered_peaks();
+            }
+        }
+        const auto labeled_data = map_labeled_data(azimuth_data);
+
+        vector<accumulation_source> sources;
+        sources.reserve(observers.size() * labeled_data.size());
+        for (const auto& observer: observers) {
+            for (const auto& [observer_options, data_collection]: labeled_data) {
+                const auto data_for_observer = data_collection->get_for_exact_position(observer);
+                sources.push_back({
+                        .observer = observer.clone_with_data(observer_options),
+                        .value_func = [data_for_observer](const observed_point& point) {
+                            return data_for_observer->map_to_nearest(point);
+                        },
+                });
+            }
+        }
+
+        const auto points = accumulate_scores(inputs, sources, options, distribution_options);
+        render_from_all_observers(points, observers, options);
     }
 }
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "utils/types.h"
+#include "utils/memory.h"
+
+#include "job_server.h"
+
+#include "test_paths.h"
+
+using rcsop::launcher::JobServer;
+using rcsop::launcher::InputDataCollector;
+using rcsop::launcher::task_options;
+using rcsop::launcher::launcher_task;
+using rcsop::common::utils::memory::ScopedMemoryStage;
+using rcsop::common::utils::memory::collect_memory_stages;
+
+class JobServerTest : public ::testing::Test {
+protected:
+    vector<task_options> _received_jobs;
+    map<string, launcher_task> _tasks = {
+            {"record", [this](const InputDataCollector&, const task_options& options) {
+                _received_jobs.push_back(options);
+            }},
+    };
+    JobServer _server{unique_temp_path("server.sock"), _tasks};
+    path _input_path = unique_temp_path("inputs");
+    path _output_path = unique_temp_path("outputs");
+
+    JobServerTest() {
+        std::filesystem::create_directories(_input_path);
+    }
+
+    /**
+     * Sends the request over a connected socket pair and returns the reply of the server.
+     */
+    auto request(const vector<string>& arguments) -> string {
+        int sockets[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+            throw runtime_error("Could not create a socket pair.");
+        }
+        string message;
+        for (const auto& argument: arguments) {
+            message += argument + "\n";
+        }
+        message += "\n";
+        EXPECT_EQ(write(sockets[0], message.data(), message.size()), static_cast<ssize_t>(message.size()));
+
+        _server.serve_connection(sockets[1]);
+
+        string reply;
+        char buffer[256];
+        ssize_t received;
+        while ((received = read(sockets[0], buffer, sizeof(buffer))) > 0) {
+            reply.append(buffer, static_cast<size_t>(received));
+        }
+        close(sockets[0]);
+        return reply;
+    }
+
+    auto job_arguments() const -> vector<string> {
+        return {"--input-path", _input_path.string(), "--output-path", _output_path.string(),
+                "--task", "record", "--no-timestamp", "--db-min", "-25"};
+    }
+};
+
+TEST_F(JobServerTest, RunsTheRequestedTaskAndRepliesWithItsOutput) {
+    const auto reply = request(job_arguments());
+
+    ASSERT_EQ(_received_jobs.size(), 1);
+    const auto& job = _received_jobs.front();
+    EXPECT_EQ(job.task_name, "record");
+    EXPECT_EQ(job.input_path, _input_path);
+    EXPECT_EQ(job.db_range.min, -25);
+    EXPECT_EQ(reply, "OK " + job.output_path.string() + "\n");
+    EXPECT_TRUE(is_directory(job.output_path));
+}
+
+TEST_F(JobServerTest, DropsTheMemoryStagesOfAFinishedJob) {
+    {
+        ScopedMemoryStage earlier_stage("earlier_stage");
+    }
+    ASSERT_FALSE(collect_memory_stages().empty());
+
+    const auto reply = request(job_arguments());
+
+    EXPECT_EQ(reply.rfind("OK ", 0), 0) << reply;
+    EXPECT_TRUE(collect_memory_stages().empty());
+}
+
+TEST_F(JobServerTest, RejectsTheExecutorOptionsOfAJob) {
+    for (const auto& option: {"--threads", "--nesting"}) {
+        auto arguments = job_arguments();
+        arguments.emplace_back(option);
+        arguments.emplace_back(string(option) == "--threads" ? "2" : "tasks");
+
+        const auto reply = request(arguments);
+        EXPECT_EQ(reply.rfind("ERROR ", 0), 0) << reply;
+        EXPECT_NE(reply.find(option), string::npos) << reply;
+    }
+    EXPECT_TRUE(_received_jobs.empty());
+}
+
+TEST_F(JobServerTest, RepliesWithTheReasonOfAnInvalidRequest) {
+    const auto reply = request({"--input-path", _input_path.string()});
+
+    EXPECT_EQ(reply.rfind("ERROR ", 0), 0) << reply;
+    EXPECT_EQ(reply.back(), '\n');
+    EXPECT_EQ(std::count(reply.cbegin(), reply.cend(), '\n'), 1);
+    EXPECT_TRUE(_received_jobs.empty());
+}
+
+TEST(JobServerSocketTest, KeepsAFileThatIsNotASocket) {
+    const path socket_path = unique_temp_path("server.sock");
+    {
+        std::ofstream file(socket_path);
+        file << "not a socket";
+    }
+    const map<string, launcher_task> tasks;
+    JobServer server(socket_path, tasks);
+
+    EXPECT_THROW(server.run(), invalid_argument);
+    EXPECT_TRUE(is_regular_file(socket_path));
+}
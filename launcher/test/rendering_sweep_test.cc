@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "utils/types.h"
+#include "utils/rendering_sweep.h"
+
+using rcsop::common::Observer;
+using rcsop::common::ObserverPosition;
+using rcsop::common::ScoredCloud;
+using rcsop::common::ScoredPoint;
+using rcsop::common::multiple_scored_cloud_payload;
+using rcsop::common::coloring::construct_color_map_function;
+using rcsop::common::coloring::resolve_map_by_name;
+using rcsop::common::utils::points::vec3;
+using rcsop::launcher::utils::rendering_sweep;
+using rcsop::launcher::utils::rendering_options;
+using rcsop::launcher::utils::expand_rendering_variants;
+using rcsop::launcher::utils::lowest_db_min;
+using rcsop::launcher::utils::drop_points_below;
+
+static auto from_dB(double dB) -> double {
+    return std::pow(10.0, dB / 10.0);
+}
+
+static auto cloud_with_dB(const vector<double>& dB_values) -> ScoredCloud {
+    auto points = make_shared<vector<ScoredPoint>>();
+    for (size_t index = 0; index < dB_values.size(); index++) {
+        points->emplace_back(vec3(static_cast<double>(index), 0, 0), index, from_dB(dB_values[index]));
+    }
+    const Observer observer(ObserverPosition{.height = 40, .azimuth = 90}, "observer.png", nullptr);
+    return {observer, points};
+}
+
+static auto sweep_with_db_min(const vector<double>& db_min) -> rendering_sweep {
+    return {
+            .db_min = db_min,
+            .db_max = {-5},
+            .color_maps = {"jet"},
+            .alphas = {1},
+            .gradient_radii = {10},
+    };
+}
+
+TEST(RenderingSweepTest, EveryVariantKeepsThePointsOfItsOwnRange) {
+    const auto sweep = sweep_with_db_min({-10, -30});
+    const auto variants = expand_rendering_variants(sweep, rendering_options{});
+    ASSERT_EQ(variants.size(), 2);
+    EXPECT_EQ(lowest_db_min(sweep), -30);
+    EXPECT_NE(variants[0].label, variants[1].label);
+
+    // the scores are linear, the bounds in dB
+    const auto cloud = cloud_with_dB({-40, -25, -20, -8, -6});
+    const auto higher = drop_points_below(cloud, variants[0].db_range.min);
+    const auto lower = drop_points_below(cloud, variants[1].db_range.min);
+
+    ASSERT_EQ(higher.points()->size(), 2);
+    EXPECT_EQ(higher.points()->at(0).id(), 3);
+    EXPECT_EQ(higher.points()->at(1).id(), 4);
+    ASSERT_EQ(lower.points()->size(), 4);
+    EXPECT_EQ(lower.points()->at(0).id(), 1);
+}
+
+TEST(RenderingSweepTest, KeepsTheCloudWithoutPointsBelowTheBound) {
+    const auto cloud = cloud_with_dB({-20, -10});
+    EXPECT_EQ(drop_points_below(cloud, -30).points(), cloud.points());
+
+    const multiple_scored_cloud_payload payload{
+            .point_clouds = {cloud, cloud_with_dB({-40, -15})},
+            .color_map = construct_color_map_function(resolve_map_by_name("jet"), {.min = -30, .max = -5}),
+    };
+    const auto filtered = drop_points_below(payload, -30);
+    ASSERT_EQ(filtered.point_clouds.size(), 2);
+    EXPECT_EQ(filtered.point_clouds[0].points(), cloud.points());
+    EXPECT_EQ(filtered.point_clouds[1].points()->size(), 1);
+}
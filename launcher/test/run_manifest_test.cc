@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "utils/types.h"
+#include "utils/run_manifest.h"
+#include "utils/content_hash.h"
+
+#include "test_paths.h"
+
+using rcsop::launcher::utils::RunManifest;
+using rcsop::launcher::utils::RUN_MANIFEST_FILE_NAME;
+using rcsop::common::utils::io::hash_file;
+
+static void write_file(const path& file_path, const string& content) {
+    std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+static auto output_folder() -> path {
+    const path folder = unique_temp_path("output");
+    std::filesystem::create_directories(folder);
+    return folder;
+}
+
+TEST(RunManifestTest, KeepsTheRecordedOutputsAcrossRuns) {
+    const path folder = output_folder();
+    {
+        RunManifest manifest(folder);
+        EXPECT_FALSE(manifest.is_up_to_date("image/40cm_90", "a1"));
+        manifest.record("image/40cm_90", "a1");
+        manifest.record("image/40cm_180", "b2");
+        manifest.save();
+    }
+    ASSERT_TRUE(exists(folder / RUN_MANIFEST_FILE_NAME));
+
+    RunManifest manifest(folder);
+    EXPECT_TRUE(manifest.is_up_to_date("image/40cm_90", "a1"));
+    EXPECT_FALSE(manifest.is_up_to_date("image/40cm_180", "changed"));
+    EXPECT_FALSE(manifest.is_up_to_date("model/40cm_90", "a1"));
+    manifest.save();
+
+    // only the output checked up to date is kept, the changed one has to be recorded again
+    RunManifest next_run(folder);
+    EXPECT_TRUE(next_run.is_up_to_date("image/40cm_90", "a1"));
+    EXPECT_FALSE(next_run.is_up_to_date("image/40cm_180", "b2"));
+}
+
+TEST(RunManifestTest, CachesFileHashesBySizeAndModificationTime) {
+    const path folder = output_folder();
+    const path input_path = unique_temp_path("input.mat");
+    write_file(input_path, "first content");
+    const auto first_hash = hash_file(input_path);
+    {
+        RunManifest manifest(folder);
+        EXPECT_EQ(manifest.input_hash(input_path), first_hash);
+        manifest.save();
+    }
+
+    // same size and time: the cached hash is used without reading the file
+    const auto modified = last_write_time(input_path);
+    write_file(input_path, "other content");
+    last_write_time(input_path, modified);
+    EXPECT_EQ(RunManifest(folder).input_hash(input_path), first_hash);
+
+    write_file(input_path, "a longer content");
+    EXPECT_EQ(RunManifest(folder).input_hash(input_path), hash_file(input_path));
+}
+
+TEST(RunManifestTest, SkipsAnOutputOnlyIfItsInputsDidNotChange) {
+    const path folder = output_folder();
+    const path input_path = unique_temp_path("input.mat");
+    write_file(input_path, "first content");
+    const auto fingerprint = [&input_path](RunManifest& manifest) {
+        return std::to_string(manifest.input_hash(input_path));
+    };
+    {
+        RunManifest manifest(folder);
+        manifest.record("image/40cm_90", fingerprint(manifest));
+        manifest.save();
+    }
+    {
+        RunManifest manifest(folder);
+        EXPECT_TRUE(manifest.is_up_to_date("image/40cm_90", fingerprint(manifest)));
+        manifest.save();
+    }
+
+    write_file(input_path, "changed content");
+    RunManifest manifest(folder);
+    EXPECT_FALSE(manifest.is_up_to_date("image/40cm_90", fingerprint(manifest)));
+}
+
+TEST(RunManifestTest, IncludesTheEntriesOfAnotherFolder) {
+    const path shard_folder = output_folder();
+    {
+        RunManifest shard(shard_folder);
+        shard.record("image/40cm_90", "a1");
+        shard.record("image/40cm_180", "b2");
+        shard.save();
+    }
+
+    const path merged_folder = output_folder();
+    {
+        RunManifest merged(merged_folder);
+        merged.record("image/40cm_180", "kept");
+        merged.include(shard_folder);
+        merged.save();
+    }
+    RunManifest merged(merged_folder);
+    EXPECT_TRUE(merged.is_up_to_date("image/40cm_90", "a1"));
+    EXPECT_TRUE(merged.is_up_to_date("image/40cm_180", "kept"));
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "utils/types.h"
+#include "utils/sharding.h"
+#include "utils/run_manifest.h"
+
+#include "test_paths.h"
+
+using rcsop::common::Observer;
+using rcsop::common::ObserverPosition;
+using rcsop::common::height_t;
+using rcsop::launcher::utils::task_options;
+using rcsop::launcher::utils::assign_shard;
+using rcsop::launcher::utils::shard_folder_name;
+using rcsop::launcher::utils::write_shard_record;
+using rcsop::launcher::utils::merge_shards;
+using rcsop::launcher::utils::RunManifest;
+using rcsop::launcher::utils::MERGED_SHARDS_FOLDER;
+using rcsop::launcher::utils::SHARD_RECORD_FILE_NAME;
+using rcsop::launcher::utils::RUN_MANIFEST_FILE_NAME;
+
+static auto observers_at(const vector<ObserverPosition>& positions) -> vector<Observer> {
+    vector<Observer> observers;
+    for (const auto& position: positions) {
+        observers.emplace_back(position, position.str() + ".png", nullptr);
+    }
+    return observers;
+}
+
+const static vector<Observer> FIXTURE_OBSERVERS = observers_at({
+        {.height = 40, .azimuth = 180},
+        {.height = 40, .azimuth = 0},
+        {.height = 80, .azimuth = 90},
+        {.height = 40, .azimuth = 90},
+        {.height = 80, .azimuth = 0},
+});
+
+static auto position_names(const set<ObserverPosition>& positions) -> vector<string> {
+    vector<string> names;
+    for (const auto& position: positions) {
+        names.push_back(position.str());
+    }
+    return names;
+}
+
+/**
+ * Stands in for a task: one image per included observer in the folder of its height and a manifest entry.
+ */
+static void run_fixture_task(const path& output_path, const std::function<bool(const Observer&)>& include) {
+    create_directories(output_path);
+    RunManifest manifest(output_path);
+    for (const auto& observer: FIXTURE_OBSERVERS) {
+        if (!include(observer)) {
+            continue;
+        }
+        const auto& position = observer.position();
+        const path folder = output_path / (std::to_string(position.height) + "cm") / "image";
+        create_directories(folder);
+        std::ofstream file(folder / (position.str() + ".png"));
+        file << "rendered " << position.str();
+        manifest.record("image/" + position.str(), "fingerprint " + position.str());
+    }
+    manifest.save();
+}
+
+/**
+ * Relative paths and contents of all outputs below the folder, without the records of the run.
+ */
+static auto folder_contents(const path& folder) -> map<string, string> {
+    map<string, string> contents;
+    for (const auto& entry: std::filesystem::recursive_directory_iterator(folder)) {
+        const auto relative_path = entry.path().lexically_relative(folder);
+        if (!entry.is_regular_file() || relative_path == SHARD_RECORD_FILE_NAME
+            || relative_path == RUN_MANIFEST_FILE_NAME) {
+            continue;
+        }
+        std::ifstream file(entry.path());
+        std::stringstream content;
+        content << file.rdbuf();
+        contents.insert(make_pair(relative_path.string(), content.str()));
+    }
+    return contents;
+}
+
+TEST(ShardingTest, DealsTheSortedPositionsToTheShardsInTurn) {
+    const auto first = assign_shard(FIXTURE_OBSERVERS, {.index = 0, .count = 2});
+    const auto second = assign_shard(FIXTURE_OBSERVERS, {.index = 1, .count = 2});
+
+    EXPECT_EQ(position_names(first.positions), (vector<string>{"40cm_000°", "40cm_180°", "80cm_090°"}));
+    EXPECT_EQ(position_names(second.positions), (vector<string>{"40cm_090°", "80cm_000°"}));
+    EXPECT_EQ(first.total_observers, 5);
+    EXPECT_EQ(first.heights, (vector<height_t>{40, 80}));
+    EXPECT_EQ(second.heights, first.heights);
+    EXPECT_EQ(shard_folder_name({.index = 1, .count = 2}), "shard-1-of-2");
+}
+
+TEST(ShardingTest, MergedShardsEqualASingleRun) {
+    const path single_folder = unique_temp_path("single");
+    run_fixture_task(single_folder, [](const Observer&) {
+        return true;
+    });
+
+    const path shard_root = unique_temp_path("sharded");
+    task_options options{};
+    options.task_name = "azimuth-rcs";
+    options.parameter_hash = 42;
+    for (size_t index = 0; index < 2; index++) {
+        options.shard = {.index = index, .count = 2};
+        options.output_path = shard_root / shard_folder_name(options.shard);
+        const auto assignment = assign_shard(FIXTURE_OBSERVERS, options.shard);
+        run_fixture_task(options.output_path, [&assignment](const Observer& observer) {
+            return assignment.contains(observer);
+        });
+        write_shard_record(options, assignment);
+    }
+    merge_shards(shard_root);
+
+    const path merged_folder = shard_root / MERGED_SHARDS_FOLDER;
+    const auto expected = folder_contents(single_folder);
+    EXPECT_EQ(expected.size(), FIXTURE_OBSERVERS.size());
+    EXPECT_EQ(folder_contents(merged_folder), expected);
+
+    // the merged manifest knows the outputs of all shards, an incremental run on it skips them all
+    RunManifest manifest(merged_folder);
+    for (const auto& observer: FIXTURE_OBSERVERS) {
+        const auto position = observer.position().str();
+        EXPECT_TRUE(manifest.is_up_to_date("image/" + position, "fingerprint " + position)) << position;
+    }
+}
+
+TEST(ShardingTest, RefusesToMergeAnIncompleteRun) {
+    const path shard_root = unique_temp_path("sharded");
+    task_options options{};
+    options.task_name = "azimuth-rcs";
+    options.shard = {.index = 0, .count = 2};
+    options.output_path = shard_root / shard_folder_name(options.shard);
+    const auto assignment = assign_shard(FIXTURE_OBSERVERS, options.shard);
+    run_fixture_task(options.output_path, [&assignment](const Observer& observer) {
+        return assignment.contains(observer);
+    });
+    write_shard_record(options, assignment);
+
+    EXPECT_THROW(merge_shards(shard_root), runtime_error);
+    EXPECT_FALSE(exists(shard_root / MERGED_SHARDS_FOLDER));
+}
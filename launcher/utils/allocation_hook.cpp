@@ -0,0 +1,66 @@
+#include <new>
+#include <cstdlib>
+
+#include "utils/memory.h"
+
+/**
+ * Replaces the global (unaligned) operator new/delete to count allocations, only compiled in with
+ * RCSOP_TRACK_ALLOCATIONS. Over-aligned allocations keep using the default operators and are not counted.
+ */
+
+using rcsop::common::utils::memory::record_allocation;
+using rcsop::common::utils::memory::mark_allocation_hook_installed;
+
+static const bool allocation_hook_installed = []() {
+    mark_allocation_hook_installed();
+    return true;
+}();
+
+static inline void* counted_allocation(std::size_t size) noexcept {
+    record_allocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new(std::size_t size) {
+    void* memory = counted_allocation(size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_allocation(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_allocation(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
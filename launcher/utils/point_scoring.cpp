@@ -1,37 +1,66 @@
 #include "point_scoring.h"
 
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+
 #include "utils/chronometer.h"
 #include "utils/gauss.h"
 #include "utils/mapping.h"
 #include "utils/rcs.h"
+#include "utils/tracing.h"
+#include "utils/memory.h"
+#include "utils/scratch_arena.h"
+#include "utils/downsampling.h"
 
 #include "observer.h"
 #include "observer_provider.h"
 #include "point_cloud_provider.h"
+#include "chunked_point_cloud_provider.h"
+#include "point_source.h"
 #include "data_point_projector.h"
 
 namespace rcsop::launcher::utils {
+    namespace parallel = rcsop::common::utils::parallel;
+
+    using parallel::nesting_policy;
+
     using rcsop::common::utils::time::start_time;
     using rcsop::common::utils::time::log_and_start_next;
 
     using rcsop::common::utils::rcs::raw_rcs_to_dB;
     using rcsop::common::utils::rcs::rcs_value_t;
 
-    using rcsop::common::utils::gauss::rcs_gaussian_vertical;
+    using rcsop::common::utils::gauss::VerticalGaussKernel;
+    using rcsop::common::utils::gauss::EllipticGaussKernel;
 
     using rcsop::common::utils::logging::construct_log_prefix;
 
+    using rcsop::common::utils::tracing::ScopedSpan;
+    using rcsop::common::utils::memory::ScopedMemoryStage;
+    using rcsop::common::utils::memory::ScopedScratch;
+    using rcsop::common::utils::memory::scratch_vector;
+
     using rcsop::common::utils::map_vec_shared;
     using rcsop::common::utils::map_vec;
     using rcsop::common::utils::filter_vec_shared;
+    using rcsop::common::utils::filter_vec;
+    using rcsop::common::utils::get_indices;
+    using rcsop::common::utils::points::voxel_downsample;
+    using rcsop::common::utils::points::vec3;
 
     using rcsop::common::ScoredPoint;
     using rcsop::common::SimplePoint;
+    using rcsop::common::PointSource;
+    using rcsop::common::VectorPointSource;
+    using rcsop::common::point_chunk;
     using rcsop::common::Observer;
-    using rcsop::common::observed_factor_func;
+    using rcsop::common::camera_local_point;
+    using rcsop::common::camera_options;
 
     using rcsop::data::AbstractDataSet;
     using rcsop::data::PointCloudProvider;
+    using rcsop::data::ChunkedPointCloudProvider;
     using rcsop::data::ObserverProvider;
     using rcsop::data::DataPointProjector;
     using rcsop::data::projection_options;
@@ -44,6 +73,36 @@ namespace rcsop::launcher::utils {
 
     using dB_range_filter = function<bool(double)>;
 
+    static const regex data_label_pattern("^(\\d{1,3})(°)?$");
+
+    static auto translate_label_to_translation(const string& label) -> data_observer_translation {
+        smatch label_match;
+        if (!regex_match(label, label_match, data_label_pattern)) {
+            std::clog << "Warning: RCS data folder doesn't match expected name pattern, using default rotation value."
+                      << std::endl;
+            return {};
+        }
+        long roll_degrees = std::stoi(label_match[1]);
+        data_observer_translation observer_translation{
+                .roll = static_cast<double>(roll_degrees),
+        };
+        return observer_translation;
+    }
+
+    auto map_labeled_data(
+            const map<string, shared_ptr<AzimuthRcsDataCollection>>& data) -> vector<data_with_observer_options> {
+        vector<data_with_observer_options> result;
+        for (auto& [label, data_set]: data) {
+            auto observer_translation = translate_label_to_translation(label);
+            result.push_back(
+                    {
+                            .observer_options = observer_translation,
+                            .data_collection = data_set
+                    });
+        }
+        return result;
+    }
+
     static auto get_range_filter(const ScoreRange range_limits) -> dB_range_filter {
         return [range_limits](const double dB_value) {
             return range_limits.min <= dB_value;// && dB_value <= range_limits.max;
@@ -51,27 +110,118 @@ namespace rcsop::launcher::utils {
     }
 
     /**
-     * Filters points in a range of scores from a defined minimum (-20dB) to maximum (5dB)
+     * Keeps the points in a range of scores from a defined minimum (-20dB) to maximum (5dB), discarded points
+     * are dropped along the way. The result lives in the scratch memory of the observer.
      */
-    static inline auto filter_points(
-            const vector<ScoredPoint>& camera_points,
-            const dB_range_filter& dB_filter) -> shared_ptr <vector<ScoredPoint>> {
-        return filter_vec_shared<ScoredPoint>(
-                camera_points,
-                [&dB_filter](const ScoredPoint& point) -> bool {
-                    const auto score = point.score_to_dB();
-                    return dB_filter(score);
-                });
+    template<typename Values, typename PointOf>
+    static auto filter_points(
+            const Values& values,
+            const PointOf& point_of,
+            const dB_range_filter& dB_filter,
+            const ScopedScratch& scratch) -> scratch_vector<ScoredPoint> {
+        auto result = scratch.make_vector<ScoredPoint>();
+        result.reserve(values.size());
+        for (const auto& value: values) {
+            const ScoredPoint& point = point_of(value);
+            if (!point.is_discarded() && dB_filter(point.score_to_dB())) {
+                result.push_back(point);
+            }
+        }
+        return result;
     }
 
+    static auto filter_points(
+            const vector<ScoredPoint>& points,
+            const dB_range_filter& dB_filter,
+            const ScopedScratch& scratch) -> scratch_vector<ScoredPoint> {
+        return filter_points(points, [](const ScoredPoint& point) -> const ScoredPoint& { return point; },
+                             dB_filter, scratch);
+    }
+
+    /**
+     * Points of one observer and label within the dB range, the peak points are only filled
+     * if both the raw and the peak filtered table are scored.
+     */
     struct filtered_scored_points {
         size_t total_count;
-        shared_ptr<vector<ScoredPoint>> filtered_points;
+        scratch_vector<ScoredPoint> filtered_points;
+        scratch_vector<ScoredPoint> filtered_peak_points;
     };
 
+    static auto describe_camera_options(const camera_options& camera) -> string {
+        std::ostringstream description;
+        description << std::setprecision(17) << camera.pitch_correction << "," << camera.distance_to_origin << ","
+                    << camera.default_height << "," << camera.use_any_camera_nearby << ","
+                    << camera.force_use_original_image;
+        return description.str();
+    }
+
+    auto resident_observer_provider(const InputDataCollector& inputs,
+                                    const camera_options& camera,
+                                    bool fill_in_missing_observers) -> shared_ptr<const ObserverProvider> {
+        return inputs.resident<ObserverProvider>(
+                "observers:" + describe_camera_options(camera) + ":" + std::to_string(fill_in_missing_observers),
+                [&inputs, &camera, fill_in_missing_observers]() {
+                    return make_shared<ObserverProvider>(inputs, camera, fill_in_missing_observers);
+                });
+    }
+
+    static auto generate_base_points(const InputDataCollector& inputs,
+                                     const task_options& task_options) -> shared_ptr<vector<SimplePoint>>;
+
+    static auto stream_base_points(const InputDataCollector& inputs,
+                                   const task_options& task_options) -> shared_ptr<PointSource>;
+
+    /**
+     * Base points only depend on the generator options and the camera options, shared by all jobs on the
+     * same inputs while they are resident. Without a chunk size all points are generated at once and handed
+     * out as a single chunk, otherwise they are read chunk by chunk.
+     */
+    static auto resident_base_points(const InputDataCollector& inputs,
+                                     const task_options& task_options) -> shared_ptr<const PointSource> {
+        std::ostringstream key;
+        key << "base_points:" << task_options.point_generator << "," << task_options.point_density << ","
+            << std::setprecision(17) << task_options.point_spacing << "," << task_options.chunk_size << ","
+            << describe_camera_options(task_options.camera);
+        return inputs.resident<PointSource>(key.str(), [&inputs, &task_options]() -> shared_ptr<PointSource> {
+            if (task_options.chunk_size > 0) {
+                return stream_base_points(inputs, task_options);
+            }
+            return make_shared<VectorPointSource>(generate_base_points(inputs, task_options), 0);
+        });
+    }
+
     static auto generate_base_points(const InputDataCollector& inputs,
                                      const task_options& task_options) -> shared_ptr<vector<SimplePoint>> {
+        ScopedSpan span("generate_base_points");
+        ScopedMemoryStage memory_stage("base_points");
         const auto point_provider = make_unique<PointCloudProvider>(inputs, task_options.camera);
+        const auto spacing = task_options.point_spacing;
+        switch (task_options.point_generator) {
+            case MODEL_SPARSE:
+                return point_provider->get_base_points(ReconstructionType::SPARSE_CLOUD, spacing);
+            case MODEL_DENSE:
+                return point_provider->get_base_points(ReconstructionType::DENSE_CLOUD, spacing);
+            case FULL_MODEL:
+            case MODEL_WITH_PROJECTION:
+                return point_provider->get_base_points(ReconstructionType::COMPLETE, spacing);
+            case BOUNDING_BOX:
+                return point_provider->downsample(
+                        point_provider->generate_homogenous_cloud(task_options.point_density), spacing);
+            case DATA_PROJECTION:
+                return make_shared<vector<SimplePoint>>();
+        }
+        throw invalid_argument("task_options");
+    }
+
+    /**
+     * Like generate_base_points without ever holding all points, no spacing can be applied that way.
+     */
+    static auto stream_base_points(const InputDataCollector& inputs,
+                                   const task_options& task_options) -> shared_ptr<PointSource> {
+        ScopedSpan span("stream_base_points");
+        const auto point_provider = make_unique<ChunkedPointCloudProvider>(inputs, task_options.camera,
+                                                                          task_options.chunk_size);
         switch (task_options.point_generator) {
             case MODEL_SPARSE:
                 return point_provider->get_base_points(ReconstructionType::SPARSE_CLOUD);
@@ -83,51 +233,72 @@ namespace rcsop::launcher::utils {
             case BOUNDING_BOX:
                 return point_provider->generate_homogenous_cloud(task_options.point_density);
             case DATA_PROJECTION:
-                return make_shared<vector<SimplePoint>>();
+                return make_shared<VectorPointSource>(make_shared<vector<SimplePoint>>(), 0);
         }
         throw invalid_argument("task_options");
     }
 
-    static inline auto score_observed_points(
-            const vector<observed_point>& observed_points,
-            const AbstractDataSet* data_for_observer,
-            const projection_options& projection_options
-    ) -> shared_ptr<vector<ScoredPoint>> {
-        const auto vertical_angle_limit = projection_options.vertical_angle_limit;
-        const auto& factor_func = projection_options.factor_func;
-        auto scored_points = map_vec<observed_point, ScoredPoint, true>(
-                observed_points,
-                [&data_for_observer, &factor_func, &vertical_angle_limit](const observed_point& point) {
-                    double value = data_for_observer->map_to_nearest(point);
-                    if (abs(point.vertical_angle) > vertical_angle_limit || std::isnan(value)) {
-                        return ScoredPoint(point.position, point.id, 0);
-                    }
-
-                    double factor = factor_func(point);
-                    double final_value = factor * value;
-                    return ScoredPoint(point.position, point.id, final_value);
-                });
-        auto result = make_shared<vector<ScoredPoint>>();
-        for (const auto& point : scored_points) {
-            if (!point.is_discarded()) {
-                result->push_back(point);
-            }
-        }
-        return result;
-    }
+    struct scored_pair {
+        ScoredPoint raw;
+        ScoredPoint peak;
+    };
 
+    /**
+     * Observes the camera local points and scores them in a single pass, without the peak filtered table
+     * only the raw scores are set. With score_both_tables the values of the raw and the peak filtered table are
+     * looked up at once, otherwise the table selected in the data set.
+     */
     static auto filter_and_score_points(
             const AbstractDataSet* data_for_observer,
-            const vector<SimplePoint>& base_points,
+            const scratch_vector<camera_local_point>& local_points,
             const Observer& observer,
-            const projection_options& projection_params
+            const projection_options& projection_params,
+            bool score_both_tables,
+            const ScopedScratch& scratch
     ) -> filtered_scored_points {
-        const auto observed_points = observer.observe_points(base_points);
-        const auto scored_points = score_observed_points(*observed_points, data_for_observer, projection_params);
-        auto filtered_points = filter_points(*scored_points, projection_params.db_filter);
+        ScopedSpan span("observe_points");
+        const auto vertical_angle_limit = projection_params.vertical_angle_limit;
+        const auto& vertical_weights = projection_params.vertical_weights;
+        auto scored_points = scratch.make_vector<scored_pair>(local_points.size());
+        parallel::transform(
+                local_points.cbegin(), local_points.cend(), scored_points.begin(),
+                [&observer, &data_for_observer, &vertical_weights, vertical_angle_limit, score_both_tables]
+                        (const camera_local_point& local_point) {
+                    const auto point = observer.observe_camera_local(local_point);
+                    const vec3 position = point.position.cast<double>();
+                    if (std::abs(point.vertical_angle) > vertical_angle_limit) {
+                        return scored_pair{
+                                .raw = ScoredPoint(position, point.id, 0),
+                                .peak = ScoredPoint(position, point.id, 0),
+                        };
+                    }
+                    // NaN values are discarded along with the zeros
+                    const double factor = vertical_weights(point);
+                    if (!score_both_tables) {
+                        const double value = data_for_observer->map_to_nearest(point);
+                        return scored_pair{
+                                .raw = ScoredPoint(position, point.id, factor * value),
+                                .peak = ScoredPoint(position, point.id, 0),
+                        };
+                    }
+                    const auto [raw_value, peak_value] = data_for_observer->map_to_nearest_both(point);
+                    return scored_pair{
+                            .raw = ScoredPoint(position, point.id, factor * raw_value),
+                            .peak = ScoredPoint(position, point.id, factor * peak_value),
+                    };
+                });
+
+        const auto& db_filter = projection_params.db_filter;
         return {
-            .total_count = observed_points->size(),
-            .filtered_points = filtered_points,
+                .total_count = local_points.size(),
+                .filtered_points = filter_points(
+                        scored_points, [](const scored_pair& pair) -> const ScoredPoint& { return pair.raw; },
+                        db_filter, scratch),
+                .filtered_peak_points = score_both_tables
+                                        ? filter_points(
+                                scored_points, [](const scored_pair& pair) -> const ScoredPoint& { return pair.peak; },
+                                db_filter, scratch)
+                                        : scratch.make_vector<ScoredPoint>(),
         };
     }
 
@@ -135,91 +306,470 @@ namespace rcsop::launcher::utils {
             const AbstractDataSet* data_for_observer,
             const Observer& observer,
             const DataPointProjector& projector,
-            const data::projection_options& projection_params) -> filtered_scored_points {
-        auto projected_points = projector.project_data(
+            const data::projection_options& projection_params,
+            double spacing_centimeters,
+            bool score_both_tables,
+            const ScopedScratch& scratch) -> filtered_scored_points {
+        ScopedSpan span("project_data");
+        const auto downsample = [&observer, spacing_centimeters](shared_ptr<vector<ScoredPoint>> points) {
+            if (spacing_centimeters > 0) {
+                return voxel_downsample(*points, observer.world_to_local_units(spacing_centimeters));
+            }
+            return points;
+        };
+        if (!score_both_tables) {
+            const auto projected_points = downsample(projector.project_data(
+                    data_for_observer, observer, projection_params));
+            return {
+                    .total_count = projected_points->size(),
+                    .filtered_points = filter_points(*projected_points, projection_params.db_filter, scratch),
+                    .filtered_peak_points = scratch.make_vector<ScoredPoint>(),
+            };
+        }
+        const auto [raw_points, peak_points] = projector.project_data_both(
                 data_for_observer, observer, projection_params);
-        auto total_count = projected_points->size();
-        auto filtered_points = filter_points(*projected_points, projection_params.db_filter);
+        const auto projected_points = downsample(raw_points);
         return {
-                .total_count = total_count,
-                .filtered_points = filtered_points
+                .total_count = projected_points->size(),
+                .filtered_points = filter_points(*projected_points, projection_params.db_filter, scratch),
+                .filtered_peak_points = filter_points(*downsample(peak_points), projection_params.db_filter, scratch),
         };
     }
 
-    auto score_points(
+    /**
+     * Data and translated observer of one label, looked up once per observer.
+     */
+    struct observed_label {
+        double roll;
+        const AbstractDataSet* data_for_observer;
+        Observer observer_with_translation;
+    };
+
+    /**
+     * Points of a part of the work on one observer, e.g. of one label or of one label and chunk.
+     */
+    struct scored_part {
+        vector<ScoredPoint> points;
+        vector<ScoredPoint> peak_points;
+    };
+
+    struct observer_clouds {
+        shared_ptr<vector<ScoredPoint>> points;
+        shared_ptr<vector<ScoredPoint>> peak_points;
+    };
+
+    /**
+     * Inputs shared by all observers of one scoring run, the counts are summed up over all of them.
+     */
+    struct scoring_context {
+        const PointSource& base_points;
+        const DataPointProjector& projector;
+        const projection_options& projection_params;
+        bool score_both_tables;
+        bool project_data;
+        double point_spacing;
+        std::atomic<size_t>& total_count;
+        std::atomic<size_t>& filtered_count;
+    };
+
+    static auto observe_labels(const Observer& observer,
+                               const vector<data_with_observer_options>& labeled_data) -> vector<observed_label> {
+        vector<observed_label> labels;
+        labels.reserve(labeled_data.size());
+        for (const auto& [observer_options, data_collection]: labeled_data) {
+            labels.push_back({
+                    .roll = observer_options.roll,
+                    .data_for_observer = data_collection->get_for_exact_position(observer),
+                    .observer_with_translation = observer.clone_with_data(observer_options),
+            });
+        }
+        return labels;
+    }
+
+    static void append_points(const scoring_context& context,
+                              const filtered_scored_points& scored,
+                              scored_part& part) {
+        context.total_count += scored.total_count;
+        context.filtered_count += scored.filtered_points.size();
+        part.points.insert(part.points.end(), scored.filtered_points.cbegin(), scored.filtered_points.cend());
+        part.peak_points.insert(part.peak_points.end(),
+                                scored.filtered_peak_points.cbegin(), scored.filtered_peak_points.cend());
+    }
+
+    /**
+     * The camera local geometry only depends on the observer, the labels differ just by their roll.
+     */
+    static auto map_to_camera_local(const point_chunk& chunk,
+                                    const Observer& observer,
+                                    const ScopedScratch& scratch) -> scratch_vector<camera_local_point> {
+        ScopedSpan span("map_to_camera_local");
+        auto points = scratch.make_vector<camera_local_point>(chunk.size());
+        parallel::transform(
+                chunk.begin(), chunk.end(), points.begin(),
+                [&observer](const SimplePoint& point) {
+                    return observer.to_camera_local(point);
+                });
+        return points;
+    }
+
+    static void score_label_chunk(const scoring_context& context,
+                                  const scratch_vector<camera_local_point>& local_points,
+                                  const observed_label& label,
+                                  scored_part& part,
+                                  const ScopedScratch& scratch) {
+        ScopedSpan span("score_label", [&label]() {
+            return "roll " + std::to_string(lround(label.roll));
+        });
+        append_points(context, filter_and_score_points(label.data_for_observer, local_points,
+                                                       label.observer_with_translation, context.projection_params,
+                                                       context.score_both_tables, scratch), part);
+    }
+
+    static void project_label(const scoring_context& context,
+                              const observed_label& label,
+                              scored_part& part) {
+        if (!context.project_data) {
+            return;
+        }
+        const ScopedScratch scratch;
+        append_points(context, project_data_to_points(label.data_for_observer, label.observer_with_translation,
+                                                      context.projector, context.projection_params,
+                                                      context.point_spacing, context.score_both_tables, scratch),
+                      part);
+    }
+
+    /**
+     * Joins the parts of one observer in their order.
+     */
+    static auto concatenate_parts(const vector<scored_part>& parts) -> observer_clouds {
+        observer_clouds clouds{
+                .points = make_shared<vector<ScoredPoint>>(),
+                .peak_points = make_shared<vector<ScoredPoint>>(),
+        };
+        for (const auto& part: parts) {
+            clouds.points->insert(clouds.points->end(), part.points.cbegin(), part.points.cend());
+            clouds.peak_points->insert(clouds.peak_points->end(), part.peak_points.cbegin(), part.peak_points.cend());
+        }
+        return clouds;
+    }
+
+    /**
+     * Observes the base points and projects the data of every label for one observer, the loops over the points
+     * run in parallel unless the observer is an item of a parallel outer loop.
+     */
+    static auto score_observer(const scoring_context& context,
+                               const Observer& observer,
+                               const vector<data_with_observer_options>& labeled_data) -> observer_clouds {
+        ScopedSpan span("score_observer", [&observer]() {
+            return observer.position().str();
+        });
+        const auto labels = observe_labels(observer, labeled_data);
+        vector<scored_part> label_parts(labels.size());
+
+        // 1. observed base points, the temporaries of a chunk are released before the next one is read
+        vector<SimplePoint> chunk_buffer;
+        for (size_t chunk_index = 0; chunk_index < context.base_points.chunk_count(); chunk_index++) {
+            const ScopedScratch scratch;
+            const auto chunk = context.base_points.read_chunk(chunk_index, chunk_buffer);
+            const auto local_points = map_to_camera_local(chunk, observer, scratch);
+            for (size_t label_index = 0; label_index < labels.size(); label_index++) {
+                score_label_chunk(context, local_points, labels[label_index], label_parts[label_index], scratch);
+            }
+        }
+
+        // 2. projected points, after the observed points of the same label as without chunks
+        for (size_t label_index = 0; label_index < labels.size(); label_index++) {
+            project_label(context, labels[label_index], label_parts[label_index]);
+        }
+        return concatenate_parts(label_parts);
+    }
+
+    /**
+     * Scores every chunk of an observer and every projection of a label as a task of its own on the
+     * work-stealing pool, so observers seeing many points don't leave the other threads idle. A chunk task
+     * maps its points to camera local coordinates once and scores all labels on them. The last task of an
+     * observer assembles its clouds, in the same order as score_observer.
+     */
+    static auto score_observer_tasks(const scoring_context& context,
+                                     const vector<Observer>& observers,
+                                     const vector<data_with_observer_options>& labeled_data)
+    -> vector<observer_clouds> {
+        const size_t observer_count = observers.size();
+        const size_t label_count = labeled_data.size();
+        const size_t chunk_count = context.base_points.chunk_count();
+        // the parts of a label are its chunks followed by its projected points
+        const size_t parts_per_label = chunk_count + 1;
+        const size_t tasks_per_observer = label_count == 0 ? 0 : chunk_count + label_count;
+
+        vector<vector<observed_label>> observer_labels;
+        observer_labels.reserve(observer_count);
+        for (const auto& observer: observers) {
+            observer_labels.push_back(observe_labels(observer, labeled_data));
+        }
+        vector<vector<scored_part>> observer_parts(observer_count,
+                                                   vector<scored_part>(label_count * parts_per_label));
+        vector<std::atomic<size_t>> remaining_tasks(observer_count);
+        for (auto& remaining: remaining_tasks) {
+            remaining = tasks_per_observer;
+        }
+        vector<observer_clouds> result(observer_count);
+        if (tasks_per_observer == 0) {
+            std::generate(result.begin(), result.end(), []() {
+                return concatenate_parts({});
+            });
+            return result;
+        }
+        std::atomic<size_t> assembled_count{0};
+        const auto time = start_time();
+
+        parallel::run_tasks(
+                observer_count * tasks_per_observer,
+                [&context, &observers, &observer_labels, &observer_parts, &remaining_tasks, &result,
+                 &assembled_count, &time, observer_count, chunk_count, parts_per_label, tasks_per_observer]
+                        (const size_t task_index) {
+                    const size_t observer_index = task_index / tasks_per_observer;
+                    const size_t observer_task = task_index % tasks_per_observer;
+                    const auto& observer = observers[observer_index];
+                    const auto& labels = observer_labels[observer_index];
+                    auto& parts = observer_parts[observer_index];
+
+                    if (observer_task < chunk_count) {
+                        ScopedSpan span("score_task", [&observer]() {
+                            return observer.position().str();
+                        });
+                        const ScopedScratch scratch;
+                        vector<SimplePoint> chunk_buffer;
+                        const auto chunk = context.base_points.read_chunk(observer_task, chunk_buffer);
+                        const auto local_points = map_to_camera_local(chunk, observer, scratch);
+                        for (size_t label_index = 0; label_index < labels.size(); label_index++) {
+                            score_label_chunk(context, local_points, labels[label_index],
+                                              parts[label_index * parts_per_label + observer_task], scratch);
+                        }
+                    } else {
+                        const size_t label_index = observer_task - chunk_count;
+                        project_label(context, labels[label_index],
+                                      parts[label_index * parts_per_label + chunk_count]);
+                    }
+
+                    if (remaining_tasks[observer_index].fetch_sub(1) == 1) {
+                        result[observer_index] = concatenate_parts(parts);
+                        parts = {};
+                        log_and_start_next(time, construct_log_prefix(++assembled_count, observer_count)
+                                                 + "Scored and filtered "
+                                                 + std::to_string(result[observer_index].points->size())
+                                                 + " points at " + observer.position().str());
+                    }
+                });
+        return result;
+    }
+
+    struct scored_observer_clouds {
+        vector<ScoredCloud> clouds;
+        vector<ScoredCloud> peak_clouds;
+    };
+
+    /**
+     * Observes the base points and projects the data once per observer and label. With score_both_tables the
+     * values of the raw and the peak filtered table are looked up in the same pass, otherwise the table
+     * selected in the data sets.
+     */
+    static auto score_observers(
             const InputDataCollector& inputs,
             const vector<data_with_observer_options>& labeled_data,
             const task_options& task_options,
-            const global_colormap_func& color_map_func) -> shared_ptr<multiple_scored_cloud_payload const> {
+            bool score_both_tables,
+            const observer_predicate& include_observer) -> scored_observer_clouds {
+        ScopedSpan span("score_points");
+        ScopedMemoryStage memory_stage("score_points");
         auto dB_range = task_options.db_range;
-        auto observer_provider = make_shared<ObserverProvider>(inputs, task_options.camera, true);
+        auto observer_provider = resident_observer_provider(inputs, task_options.camera, true);
         auto projector = make_shared<DataPointProjector>();
 
         auto observers = observer_provider->observers_with_positions();
+        if (include_observer != nullptr) {
+            observers = filter_vec<Observer>(observers, include_observer);
+        }
         auto observer_count = observers.size();
-        auto base_points = generate_base_points(inputs, task_options);
+        auto base_points = resident_base_points(inputs, task_options);
 
         auto total_time = start_time();
         auto range_filter = get_range_filter(dB_range);
 
-        auto vertical_distribution = rcs_gaussian_vertical(task_options.vertical_options.angle_spread,
-                                                           task_options.vertical_options.normal_variance);
+        const VerticalGaussKernel vertical_weights(task_options.vertical_options.angle_spread,
+                                                   task_options.vertical_options.normal_variance,
+                                                   task_options.vertical_options.angle_spread);
         auto projection_params = data::projection_options {
             .db_filter = range_filter,
-            .factor_func = vertical_distribution,
+            .vertical_weights = vertical_weights,
             .vertical_angle_limit = task_options.vertical_options.angle_spread,
             .steps_per_angle = task_options.point_density,
         };
 
-        size_t total_count{0};
-        size_t filtered_count{0};
-        auto complete_payload = map_vec<Observer, ScoredCloud, false>(
-                observers,
-                [&labeled_data, &task_options,
-                 &base_points, &projector, &observer_count, &total_count, &filtered_count, &projection_params]
-                        (const size_t index, const Observer& observer) {
-                    auto time = start_time();
-                    auto relevant_points = make_shared<vector<ScoredPoint>> ();
-                    for (const auto& [observer_options, data_collection]: labeled_data) {
-                        auto data_for_observer = data_collection->get_for_exact_position(observer);
-                        auto observer_with_translation = observer.clone_with_data(observer_options);
-
-                        // 1. observed base points
-                        if (!base_points->empty()) {
-                            auto [total_observed_count, observed_points] = filter_and_score_points(
-                                    data_for_observer, *base_points, observer_with_translation, projection_params);
-                            total_count += total_observed_count;
-                            filtered_count += observed_points->size();
-
-                            relevant_points->insert(relevant_points->end(),
-                                                    observed_points->cbegin(), observed_points->cend());
-                        }
-
-                        // 2. projected points
-                        if ((task_options.point_generator & PointGenerator::DATA_PROJECTION) != 0) {
-                            auto [total_projected_count, projected_points] = project_data_to_points(
-                                    data_for_observer, observer_with_translation, *projector, projection_params);
-                            total_count += total_projected_count;
-                            filtered_count += projected_points->size();
-
-                            relevant_points->insert(relevant_points->end(),
-                                                    projected_points->cbegin(), projected_points->cend());
-                        }
-                    }
+        std::atomic<size_t> total_count{0};
+        std::atomic<size_t> filtered_count{0};
+        const scoring_context context{
+                .base_points = *base_points,
+                .projector = *projector,
+                .projection_params = projection_params,
+                .score_both_tables = score_both_tables,
+                .project_data = (task_options.point_generator & PointGenerator::DATA_PROJECTION) != 0,
+                .point_spacing = task_options.point_spacing,
+                .total_count = total_count,
+                .filtered_count = filtered_count,
+        };
 
-                    log_and_start_next(time, construct_log_prefix(index + 1, observer_count)
-                                             + "Scored and filtered " + std::to_string(relevant_points->size()) +
-                                             " points at " + observer.position().str());
-                    return ScoredCloud(observer, relevant_points);
-                });
+        vector<observer_clouds> scored_points;
+        if (parallel::executor_configuration().nesting == nesting_policy::TASKS) {
+            scored_points = score_observer_tasks(context, observers, labeled_data);
+        } else {
+            // the observers one after the other with their points in parallel, or several observers at once
+            scored_points.resize(observer_count);
+            const auto observer_indices = get_indices(observers);
+            parallel::for_each_outer(
+                    observer_indices.cbegin(), observer_indices.cend(),
+                    [&context, &scored_points, &observers, &labeled_data, observer_count](const size_t index) {
+                        const auto& observer = observers[index];
+                        auto time = start_time();
+                        scored_points[index] = score_observer(context, observer, labeled_data);
+                        log_and_start_next(time, construct_log_prefix(index + 1, observer_count)
+                                                 + "Scored and filtered "
+                                                 + std::to_string(scored_points[index].points->size())
+                                                 + " points at " + observer.position().str());
+                    });
+        }
         log_and_start_next(total_time, "Scored a total of " + std::to_string(total_count) +
                                        " and filtered down to " + std::to_string(filtered_count) +
                                        " for a total of " + std::to_string(observer_count) +
                                        " observers.");
 
+        scored_observer_clouds result;
+        for (size_t index = 0; index < observer_count; index++) {
+            result.clouds.emplace_back(observers[index], scored_points[index].points);
+            if (score_both_tables) {
+                result.peak_clouds.emplace_back(observers[index], scored_points[index].peak_points);
+            }
+        }
+        return result;
+    }
+
+    auto score_points(
+            const InputDataCollector& inputs,
+            const vector<data_with_observer_options>& labeled_data,
+            const task_options& task_options,
+            const global_colormap_func& color_map_func,
+            const observer_predicate& include_observer) -> shared_ptr<multiple_scored_cloud_payload const> {
+        auto [clouds, _] = score_observers(inputs, labeled_data, task_options, false, include_observer);
         return make_shared<multiple_scored_cloud_payload>(multiple_scored_cloud_payload{
-                .point_clouds = complete_payload,
+                .point_clouds = std::move(clouds),
                 .color_map = color_map_func,
         });
     }
+
+    auto score_points_with_peaks(
+            const InputDataCollector& inputs,
+            const vector<data_with_observer_options>& labeled_data,
+            const task_options& task_options,
+            const global_colormap_func& color_map_func,
+            const observer_predicate& include_observer) -> raw_and_peak_payloads {
+        auto [clouds, peak_clouds] = score_observers(inputs, labeled_data, task_options, true, include_observer);
+        return {
+                .raw = make_shared<multiple_scored_cloud_payload>(multiple_scored_cloud_payload{
+                        .point_clouds = std::move(clouds),
+                        .color_map = color_map_func,
+                }),
+                .peaks = make_shared<multiple_scored_cloud_payload>(multiple_scored_cloud_payload{
+                        .point_clouds = std::move(peak_clouds),
+                        .color_map = color_map_func,
+                }),
+        };
+    }
+
+    /**
+     * Adds the weighted value of every base point of the chunk seen by the source to the partial sums of one thread.
+     */
+    static void accumulate_source(const accumulation_source& source,
+                                  const point_chunk& base_points,
+                                  const EllipticGaussKernel& weights,
+                                  vector<double>& partial_sums) {
+        ScopedSpan span("accumulate_source", [&source]() {
+            return source.observer.position().str();
+        });
+        const auto& [observer, value_func] = source;
+        for (size_t point_index = 0; point_index < base_points.size(); point_index++) {
+            const auto observed = observer.observe_point(base_points[point_index]);
+            const double weight = weights(observed);
+            if (weight == 0) {
+                continue;
+            }
+            const double value = value_func(observed);
+            if (std::isnan(value)) {
+                continue;
+            }
+            partial_sums[point_index] += weight * value;
+        }
+    }
+
+    auto accumulate_scores(
+            const InputDataCollector& inputs,
+            const vector<accumulation_source>& sources,
+            const task_options& task_options,
+            const gauss_options& distribution_options) -> shared_ptr<vector<ScoredPoint>> {
+        ScopedSpan span("accumulate_scores");
+        ScopedMemoryStage memory_stage("accumulate_scores");
+        const auto base_points = resident_base_points(inputs, task_options);
+        auto result = make_shared<vector<ScoredPoint>>();
+        if (sources.empty()) {
+            return result;
+        }
+
+        auto time = start_time();
+        const EllipticGaussKernel weights(distribution_options);
+        // one partial array per thread instead of per source, so the memory stays bounded by the core count
+        const size_t partial_count = std::clamp<size_t>(parallel::thread_count(), 1, sources.size());
+        vector<vector<double>> partial_sums(partial_count);
+        const auto partial_indices = get_indices(partial_sums);
+        vector<SimplePoint> chunk_buffer;
+        vector<ScoredPoint> chunk_scores;
+        size_t point_count = 0;
+        for (size_t chunk_index = 0; chunk_index < base_points->chunk_count(); chunk_index++) {
+            const auto chunk = base_points->read_chunk(chunk_index, chunk_buffer);
+            point_count += chunk.size();
+            parallel::for_each<false>(
+                    partial_indices.cbegin(), partial_indices.cend(),
+                    [&sources, &chunk, &weights, &partial_sums, partial_count](const size_t partial_index) {
+                        auto& sums = partial_sums[partial_index];
+                        sums.assign(chunk.size(), 0.);
+                        for (size_t source_index = partial_index;
+                             source_index < sources.size();
+                             source_index += partial_count) {
+                            accumulate_source(sources[source_index], chunk, weights, sums);
+                        }
+                    });
+
+            ScopedSpan merge_span("merge_partial_sums");
+            const auto point_indices = get_indices(partial_sums.front());
+            chunk_scores.resize(chunk.size());
+            parallel::transform<false>(
+                    point_indices.cbegin(), point_indices.cend(), chunk_scores.begin(),
+                    [&chunk, &partial_sums](const size_t point_index) {
+                        // always summed in the same order, the result doesn't depend on the scheduling
+                        double sum = 0;
+                        for (const auto& sums: partial_sums) {
+                            sum += sums[point_index];
+                        }
+                        const auto& point = chunk[point_index];
+                        return ScoredPoint(point.position(), point.id(), sum);
+                    });
+            std::copy_if(chunk_scores.cbegin(), chunk_scores.cend(), std::back_inserter(*result),
+                         [](const ScoredPoint& point) {
+                             return !point.is_discarded();
+                         });
+        }
+        log_and_start_next(time, "Accumulated " + std::to_string(sources.size()) + " observer/label pairs over "
+                                 + std::to_string(point_count) + " points in "
+                                 + std::to_string(base_points->chunk_count()) + " chunks with "
+                                 + std::to_string(partial_count) + " partial sums, "
+                                 + std::to_string(result->size()) + " points received a score");
+        return result;
+    }
 }
@@ -6,29 +6,93 @@
 
 #include "scored_cloud.h"
 #include "input_data_collector.h"
+#include "observer_provider.h"
 #include "observed_point.h"
 #include "observer.h"
 
 #include "colors.h"
+#include "utils/gauss.h"
 
 namespace rcsop::launcher::utils {
     using rcsop::common::ScoredCloud;
+    using rcsop::common::ScoredPoint;
     using rcsop::common::observed_point;
     using rcsop::data::AbstractDataCollection;
     using rcsop::common::multiple_scored_cloud_payload;
     using rcsop::common::data_observer_translation;
     using rcsop::common::coloring::global_colormap_func;
+    using rcsop::common::utils::gauss::gauss_options;
+    using rcsop::common::Observer;
+    using rcsop::data::AzimuthRcsDataCollection;
+    using rcsop::data::ObserverProvider;
 
     struct data_with_observer_options {
         data_observer_translation observer_options;
         shared_ptr<AbstractDataCollection> data_collection;
     };
 
+    /**
+     * RCS value of a point seen by one observer before weighting, NaN if there is no data for it.
+     */
+    using observed_value_func = function<double(const observed_point&)>;
+
+    /**
+     * Selects the observers to score, nullptr for all of them.
+     */
+    using observer_predicate = function<bool(const Observer&)>;
+
+    struct accumulation_source {
+        Observer observer;
+        observed_value_func value_func;
+    };
+
+    struct raw_and_peak_payloads {
+        shared_ptr<multiple_scored_cloud_payload const> raw;
+        shared_ptr<multiple_scored_cloud_payload const> peaks;
+    };
+
+    /**
+     * Observers for the camera options, kept in memory as long as the inputs keep their values resident.
+     */
+    auto resident_observer_provider(const InputDataCollector& inputs,
+                                    const camera_options& camera,
+                                    bool fill_in_missing_observers) -> shared_ptr<const ObserverProvider>;
+
+    /**
+     * Translates the data folder labels ("<roll>°") into the roll of the observers.
+     */
+    auto map_labeled_data(
+            const map<string, shared_ptr<AzimuthRcsDataCollection>>& data) -> vector<data_with_observer_options>;
+
     auto score_points(
             const InputDataCollector& inputs,
             const vector<data_with_observer_options>& data,
             const task_options& task_options,
-            const global_colormap_func& color_map_func) -> shared_ptr<multiple_scored_cloud_payload const>;
+            const global_colormap_func& color_map_func,
+            const observer_predicate& include_observer = nullptr) -> shared_ptr<multiple_scored_cloud_payload const>;
+
+    /**
+     * Scores the points with the raw and the peak filtered data in a single pass, the observed geometry and
+     * the projected samples are shared by both payloads. Ignores use_filtered_peaks of the data sets.
+     */
+    auto score_points_with_peaks(
+            const InputDataCollector& inputs,
+            const vector<data_with_observer_options>& data,
+            const task_options& task_options,
+            const global_colormap_func& color_map_func,
+            const observer_predicate& include_observer = nullptr) -> raw_and_peak_payloads;
+
+    /**
+     * Sums the weighted values of all sources into a single score per base point. The sources are split
+     * across threads, each summing into its own partial array, which are merged in a fixed order at the end.
+     * With a chunk size the base points are accumulated one chunk after the other, the partial arrays only
+     * span a chunk then. Points without any contribution are dropped.
+     */
+    auto accumulate_scores(
+            const InputDataCollector& inputs,
+            const vector<accumulation_source>& sources,
+            const task_options& task_options,
+            const gauss_options& distribution_options) -> shared_ptr<vector<ScoredPoint>>;
 
 }
 
@@ -0,0 +1,185 @@
+#include "utils/rendering_sweep.h"
+
+#include <sstream>
+
+#include "utils/mapping.h"
+#include "utils/logging.h"
+#include "utils/tracing.h"
+#include "utils/memory.h"
+
+namespace rcsop::launcher::utils {
+    namespace parallel = rcsop::common::utils::parallel;
+
+    using std::filesystem::create_directories;
+
+    using rcsop::common::utils::map_vec;
+    using rcsop::common::utils::get_indices;
+    using rcsop::common::utils::filter_vec_shared;
+    using rcsop::common::utils::logging::construct_log_prefix;
+    using rcsop::common::utils::tracing::ScopedSpan;
+    using rcsop::common::utils::memory::ScopedMemoryStage;
+    using rcsop::common::coloring::construct_color_map_function;
+    using rcsop::common::coloring::resolve_map_by_name;
+    using rcsop::common::coloring::global_colormap_func;
+    using rcsop::common::ScoredPoint;
+
+    using rcsop::rendering::BaseBackground;
+
+    static auto format_value(double value) -> string {
+        std::ostringstream stream;
+        stream << value;
+        return stream.str();
+    }
+
+    auto expand_rendering_variants(const rendering_sweep& sweep,
+                                   const rendering_options& base_options) -> vector<rendering_variant> {
+        vector<rendering_variant> variants;
+        for (const auto db_min: sweep.db_min) {
+            for (const auto db_max: sweep.db_max) {
+                for (const auto& color_map: sweep.color_maps) {
+                    for (const auto alpha: sweep.alphas) {
+                        for (const auto gradient_radius: sweep.gradient_radii) {
+                            variants.push_back({
+                                    .label = "db" + format_value(db_min) + "to" + format_value(db_max)
+                                             + "_" + color_map
+                                             + "_alpha" + format_value(alpha)
+                                             + "_radius" + format_value(gradient_radius),
+                                    .db_range = {
+                                            .min = db_min,
+                                            .max = db_max,
+                                    },
+                                    .rendering = {
+                                            .use_gpu_rendering = base_options.use_gpu_rendering,
+                                            .color_map = resolve_map_by_name(color_map),
+                                            .gradient = {
+                                                    .radius = gradient_radius,
+                                                    .center_alpha = alpha,
+                                            },
+                                    },
+                            });
+                        }
+                    }
+                }
+            }
+        }
+        return variants;
+    }
+
+    double lowest_db_min(const rendering_sweep& sweep) {
+        if (sweep.db_min.empty()) {
+            throw invalid_argument("No lower dB bound given in the sweep.");
+        }
+        return *std::min_element(sweep.db_min.cbegin(), sweep.db_min.cend());
+    }
+
+    auto drop_points_below(const ScoredCloud& cloud, double db_min) -> ScoredCloud {
+        const auto& points = *cloud.points();
+        const bool any_below = std::any_of(points.cbegin(), points.cend(), [db_min](const ScoredPoint& point) {
+            return point.score_to_dB() < db_min;
+        });
+        if (!any_below) {
+            return cloud;
+        }
+        auto remaining_points = filter_vec_shared<ScoredPoint>(points, [db_min](const ScoredPoint& point) {
+            return point.score_to_dB() >= db_min;
+        });
+        return {cloud.observer(), remaining_points};
+    }
+
+    auto drop_points_below(const multiple_scored_cloud_payload& payload,
+                           double db_min) -> multiple_scored_cloud_payload {
+        multiple_scored_cloud_payload result{
+                .point_clouds = {},
+                .color_map = payload.color_map,
+        };
+        result.point_clouds.reserve(payload.point_clouds.size());
+        for (const auto& cloud: payload.point_clouds) {
+            result.point_clouds.push_back(drop_points_below(cloud, db_min));
+        }
+        return result;
+    }
+
+    static auto points_for_variant(const ScoredCloud& cloud,
+                                   const rendering_variant& variant,
+                                   double scored_db_min) -> ScoredCloud {
+        if (variant.db_range.min <= scored_db_min) {
+            return cloud;
+        }
+        return drop_points_below(cloud, variant.db_range.min);
+    }
+
+    void render_variants(const multiple_scored_cloud_payload& payload,
+                         const vector<rendering_variant>& variants,
+                         const task_options& options,
+                         const vector<height_t>& observer_heights,
+                         const renderer_decorator& decorate) {
+        if (variants.empty()) {
+            return;
+        }
+        ScopedMemoryStage memory_stage("render_variants");
+        const auto& point_clouds = payload.point_clouds;
+        const bool separate_heights = observer_heights.size() > 1;
+        double scored_db_min = variants.front().db_range.min;
+        for (const auto& variant: variants) {
+            scored_db_min = std::min(scored_db_min, variant.db_range.min);
+        }
+
+        // in the order of the variants, the parallel map_vec doesn't keep it for types without a default value
+        vector<global_colormap_func> color_maps;
+        color_maps.reserve(variants.size());
+        for (const auto& variant: variants) {
+            color_maps.push_back(construct_color_map_function(variant.rendering.color_map, variant.db_range));
+        }
+
+        // the GPU renderer loads its shader and draws on the thread its GL context was made on
+        const bool on_calling_thread = options.rendering.use_gpu_rendering;
+        const auto variant_indices = get_indices(variants);
+        const size_t image_count = point_clouds.size() * variants.size();
+        for (size_t cloud_index = 0; cloud_index < point_clouds.size(); cloud_index++) {
+            const auto& cloud = point_clouds[cloud_index];
+            const auto& observer = cloud.observer();
+            ScopedSpan span("render_variants", [&observer]() {
+                return observer.position().str();
+            });
+
+            const auto create_renderer = [&cloud, &variants, &color_maps, &options, &decorate, scored_db_min]
+                    (const size_t variant_index) {
+                const auto& variant = variants[variant_index];
+                auto renderer = make_shared<ObserverRenderer>(
+                        points_for_variant(cloud, variant, scored_db_min),
+                        color_maps[variant_index], variant.rendering,
+                        options.camera.distance_to_origin);
+                decorate(cloud, *renderer);
+                return renderer;
+            };
+            const auto renderers = on_calling_thread
+                                   ? map_vec<size_t, shared_ptr<ObserverRenderer>, false>(variant_indices,
+                                                                                          create_renderer)
+                                   : map_vec<size_t, shared_ptr<ObserverRenderer>>(variant_indices,
+                                                                                   create_renderer);
+
+            // all variants share the renderer kind, so one decoded source image serves all of them
+            const shared_ptr<const BaseBackground> background = renderers.front()->decode_background();
+
+            const auto render_variant = [&variants, &renderers, &background, &options, &observer, &cloud_index,
+                                         &image_count, separate_heights](const size_t variant_index) {
+                const auto& renderer = renderers[variant_index];
+                path output_path = options.output_path / variants[variant_index].label;
+                if (separate_heights && observer.has_position()) {
+                    output_path /= std::to_string(observer.position().height) + "cm";
+                }
+                output_path /= renderer->path_prefix();
+                create_directories(output_path);
+
+                const size_t image_index = cloud_index * variants.size() + variant_index;
+                renderer->use_background(background);
+                renderer->write(output_path, construct_log_prefix(image_index + 1, image_count));
+            };
+            if (on_calling_thread) {
+                std::for_each(variant_indices.cbegin(), variant_indices.cend(), render_variant);
+            } else {
+                parallel::for_each<false>(variant_indices.cbegin(), variant_indices.cend(), render_variant);
+            }
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef RCSOP_LAUNCHER_RENDERING_SWEEP_H
+#define RCSOP_LAUNCHER_RENDERING_SWEEP_H
+
+#include "utils/types.h"
+
+#include "scored_cloud.h"
+#include "observer_renderer.h"
+#include "task_utils.h"
+
+namespace rcsop::launcher::utils {
+    using rcsop::common::ScoredCloud;
+    using rcsop::common::multiple_scored_cloud_payload;
+
+    struct rendering_variant {
+        string label;
+        ScoreRange db_range;
+        rendering_options rendering;
+    };
+
+    using renderer_decorator = std::function<void(const ScoredCloud&, ObserverRenderer&)>;
+
+    /**
+     * All combinations of the swept values, the label names the output folder of a variant.
+     */
+    [[nodiscard]] auto expand_rendering_variants(const rendering_sweep& sweep,
+                                                 const rendering_options& base_options) -> vector<rendering_variant>;
+
+    /**
+     * Lowest lower bound of all variants, the points have to be scored down to it once for all variants.
+     */
+    [[nodiscard]] double lowest_db_min(const rendering_sweep& sweep);
+
+    /**
+     * The cloud without its points below the lower dB bound, the same cloud if none are below it.
+     */
+    [[nodiscard]] auto drop_points_below(const ScoredCloud& cloud, double db_min) -> ScoredCloud;
+
+    /**
+     * Drops the points below the lower dB bound from every cloud of the payload.
+     */
+    [[nodiscard]] auto drop_points_below(const multiple_scored_cloud_payload& payload,
+                                         double db_min) -> multiple_scored_cloud_payload;
+
+    /**
+     * Renders the images of every variant from the same scored payload into <output>/<label>. Each source image
+     * is decoded once per observer and the variants of an observer render in parallel on top of it, with GPU
+     * rendering one after the other on the calling thread. Points below the lower bound of a variant are dropped
+     * before rendering.
+     */
+    void render_variants(const multiple_scored_cloud_payload& payload,
+                         const vector<rendering_variant>& variants,
+                         const task_options& options,
+                         const vector<height_t>& observer_heights,
+                         const renderer_decorator& decorate);
+}
+
+#endif //RCSOP_LAUNCHER_RENDERING_SWEEP_H
@@ -0,0 +1,140 @@
+#include "utils/run_manifest.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace rcsop::launcher::utils {
+    using std::filesystem::recursive_directory_iterator;
+
+    using rcsop::common::utils::io::hash_file;
+    using rcsop::common::utils::io::hash_string;
+
+    static const char* FILE_ENTRY = "file";
+    static const char* OUTPUT_ENTRY = "output";
+    static const char FIELD_SEPARATOR = '\t';
+
+    RunManifest::RunManifest(const path& output_path)
+            : _manifest_path(output_path / RUN_MANIFEST_FILE_NAME) {
+        read_entries(_manifest_path, _previous_files, _previous_outputs);
+    }
+
+    void RunManifest::read_entries(const path& manifest_path,
+                                   map<string, file_record>& files,
+                                   map<string, string>& outputs) {
+        std::ifstream manifest(manifest_path);
+        string line;
+        while (std::getline(manifest, line)) {
+            std::istringstream fields(line);
+            string entry_type;
+            std::getline(fields, entry_type, FIELD_SEPARATOR);
+            if (entry_type == FILE_ENTRY) {
+                // file <size> <modified> <hash> <path>
+                file_record record{};
+                string file_path;
+                fields >> record.size >> record.modified >> std::hex >> record.hash >> std::dec;
+                fields.ignore(1);
+                std::getline(fields, file_path);
+                if (!fields.fail()) {
+                    files.insert(make_pair(file_path, record));
+                }
+            } else if (entry_type == OUTPUT_ENTRY) {
+                // output <fingerprint> <key>
+                string fingerprint;
+                string output_key;
+                std::getline(fields, fingerprint, FIELD_SEPARATOR);
+                std::getline(fields, output_key);
+                if (!fields.fail()) {
+                    outputs.insert(make_pair(output_key, fingerprint));
+                }
+            }
+        }
+    }
+
+    content_hash_t RunManifest::input_hash(const path& input_path) {
+        if (is_directory(input_path)) {
+            vector<path> file_paths;
+            for (const auto& entry: recursive_directory_iterator{input_path}) {
+                if (entry.is_regular_file()) {
+                    file_paths.push_back(entry.path());
+                }
+            }
+            std::sort(file_paths.begin(), file_paths.end());
+
+            content_hash_t hash = hash_string(input_path.filename().string());
+            for (const auto& file_path: file_paths) {
+                hash = hash_string(file_path.lexically_relative(input_path).string(), hash);
+                hash = hash_string(std::to_string(input_hash(file_path)), hash);
+            }
+            return hash;
+        }
+
+        const string key = absolute(input_path).lexically_normal().string();
+        const auto size = file_size(input_path);
+        const auto modified = static_cast<long long>(last_write_time(input_path).time_since_epoch().count());
+        {
+            std::lock_guard guard(_lock);
+            const auto& known_files = _files.contains(key) ? _files : _previous_files;
+            const auto known_file = known_files.find(key);
+            if (known_file != known_files.end()
+                && known_file->second.size == size && known_file->second.modified == modified) {
+                _files.insert_or_assign(key, known_file->second);
+                return known_file->second.hash;
+            }
+        }
+
+        // hashed outside of the lock, the files of several observers are read in parallel
+        const file_record record{
+                .size = size,
+                .modified = modified,
+                .hash = hash_file(input_path),
+        };
+        std::lock_guard guard(_lock);
+        _files.insert_or_assign(key, record);
+        return record.hash;
+    }
+
+    bool RunManifest::is_up_to_date(const string& output_key, const string& fingerprint) {
+        std::lock_guard guard(_lock);
+        const auto previous_output = _previous_outputs.find(output_key);
+        if (previous_output == _previous_outputs.end() || previous_output->second != fingerprint) {
+            return false;
+        }
+        _outputs.insert_or_assign(output_key, fingerprint);
+        return true;
+    }
+
+    void RunManifest::record(const string& output_key, const string& fingerprint) {
+        std::lock_guard guard(_lock);
+        _outputs.insert_or_assign(output_key, fingerprint);
+    }
+
+    void RunManifest::include(const path& output_path) {
+        map<string, file_record> files;
+        map<string, string> outputs;
+        read_entries(output_path / RUN_MANIFEST_FILE_NAME, files, outputs);
+
+        std::lock_guard guard(_lock);
+        _files.insert(files.cbegin(), files.cend());
+        _outputs.insert(outputs.cbegin(), outputs.cend());
+    }
+
+    void RunManifest::save() const {
+        std::lock_guard guard(_lock);
+        // written next to the manifest first, an interrupted run keeps the old one intact
+        const path temporary_path{_manifest_path.string() + ".tmp"};
+        {
+            std::ofstream manifest(temporary_path, std::ios::trunc);
+            for (const auto& [file_path, record]: _files) {
+                manifest << FILE_ENTRY << FIELD_SEPARATOR << record.size << ' ' << record.modified << ' '
+                         << std::hex << record.hash << std::dec << FIELD_SEPARATOR << file_path << "\n";
+            }
+            for (const auto& [output_key, fingerprint]: _outputs) {
+                manifest << OUTPUT_ENTRY << FIELD_SEPARATOR << fingerprint << FIELD_SEPARATOR << output_key << "\n";
+            }
+            if (!manifest) {
+                throw runtime_error("Could not write the run manifest " + temporary_path.string());
+            }
+        }
+        std::filesystem::rename(temporary_path, _manifest_path);
+    }
+}
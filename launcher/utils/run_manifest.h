@@ -0,0 +1,66 @@
+#ifndef RCSOP_LAUNCHER_RUN_MANIFEST_H
+#define RCSOP_LAUNCHER_RUN_MANIFEST_H
+
+#include <mutex>
+
+#include "utils/types.h"
+#include "utils/content_hash.h"
+
+namespace rcsop::launcher::utils {
+    using rcsop::common::utils::io::content_hash_t;
+
+    const static string RUN_MANIFEST_FILE_NAME = ".rcsop-manifest";
+
+    /**
+     * Fingerprints of the outputs in an output folder, stored next to them so a later run can skip the
+     * outputs whose inputs and parameters did not change. The content hashes of the input files are cached
+     * by size and modification time, unchanged files are not read again.
+     */
+    class RunManifest {
+    private:
+        struct file_record {
+            uintmax_t size;
+            long long modified;
+            content_hash_t hash;
+        };
+
+        path _manifest_path;
+        map<string, file_record> _previous_files;
+        map<string, string> _previous_outputs;
+        map<string, file_record> _files;
+        map<string, string> _outputs;
+        mutable std::mutex _lock;
+
+        static void read_entries(const path& manifest_path,
+                                 map<string, file_record>& files,
+                                 map<string, string>& outputs);
+
+    public:
+        explicit RunManifest(const path& output_path);
+
+        /**
+         * Content hash of a single file, or of all files below a folder including their relative paths.
+         */
+        [[nodiscard]] content_hash_t input_hash(const path& input_path);
+
+        /**
+         * True if the output was written with the same fingerprint before, the entry is kept in that case.
+         */
+        [[nodiscard]] bool is_up_to_date(const string& output_key, const string& fingerprint);
+
+        void record(const string& output_key, const string& fingerprint);
+
+        /**
+         * Takes over the entries of the manifest in another output folder, e.g. of a shard. Entries that are
+         * recorded already are kept.
+         */
+        void include(const path& output_path);
+
+        /**
+         * Writes the kept and recorded entries, outputs of earlier runs that were not checked are dropped.
+         */
+        void save() const;
+    };
+}
+
+#endif //RCSOP_LAUNCHER_RUN_MANIFEST_H
@@ -0,0 +1,243 @@
+#include "utils/sharding.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "utils/content_hash.h"
+#include "utils/run_manifest.h"
+
+namespace rcsop::launcher::utils {
+    using std::clog;
+    using std::endl;
+    using std::filesystem::recursive_directory_iterator;
+    using std::filesystem::directory_iterator;
+
+    using rcsop::common::utils::io::to_hex;
+
+    static const char* SHARD_ENTRY = "shard";
+    static const char* TASK_ENTRY = "task";
+    static const char* PARAMETERS_ENTRY = "parameters";
+    static const char* OBSERVER_COUNT_ENTRY = "observers";
+    static const char* OBSERVER_ENTRY = "observer";
+    static const char FIELD_SEPARATOR = '\t';
+    static const string SHARD_FOLDER_PREFIX = "shard-";
+
+    struct shard_record {
+        shard_options shard;
+        string task_name;
+        string parameters;
+        size_t total_observers = 0;
+        set<ObserverPosition> positions;
+    };
+
+    auto assign_shard(const vector<Observer>& observers,
+                      const shard_options& shard) -> shard_assignment {
+        set<ObserverPosition> all_positions;
+        set<height_t> heights;
+        for (const auto& observer: observers) {
+            all_positions.insert(observer.position());
+            heights.insert(observer.position().height);
+        }
+
+        shard_assignment assignment{
+                .positions = {},
+                .total_observers = all_positions.size(),
+                .heights = vector<height_t>(heights.cbegin(), heights.cend()),
+        };
+        size_t index = 0;
+        for (const auto& position: all_positions) {
+            if (index++ % shard.count == shard.index) {
+                assignment.positions.insert(position);
+            }
+        }
+        return assignment;
+    }
+
+    auto shard_folder_name(const shard_options& shard) -> string {
+        return SHARD_FOLDER_PREFIX + std::to_string(shard.index) + "-of-" + std::to_string(shard.count);
+    }
+
+    static void write_record(const path& folder, const shard_record& record) {
+        const path record_path = folder / SHARD_RECORD_FILE_NAME;
+        const path temporary_path{record_path.string() + ".tmp"};
+        {
+            std::ofstream file(temporary_path, std::ios::trunc);
+            file << SHARD_ENTRY << FIELD_SEPARATOR << record.shard.index << FIELD_SEPARATOR << record.shard.count
+                 << "\n";
+            file << TASK_ENTRY << FIELD_SEPARATOR << record.task_name << "\n";
+            file << PARAMETERS_ENTRY << FIELD_SEPARATOR << record.parameters << "\n";
+            file << OBSERVER_COUNT_ENTRY << FIELD_SEPARATOR << record.total_observers << "\n";
+            for (const auto& position: record.positions) {
+                file << OBSERVER_ENTRY << FIELD_SEPARATOR << position.height << FIELD_SEPARATOR << position.azimuth
+                     << "\n";
+            }
+            if (!file) {
+                throw runtime_error("Could not write the shard record " + temporary_path.string());
+            }
+        }
+        std::filesystem::rename(temporary_path, record_path);
+    }
+
+    static auto read_record(const path& folder) -> shard_record {
+        const path record_path = folder / SHARD_RECORD_FILE_NAME;
+        std::ifstream file(record_path);
+        if (!file) {
+            throw runtime_error("No shard record in " + folder.string() + ", the shard did not finish.");
+        }
+        shard_record record;
+        string line;
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            string entry_type;
+            std::getline(fields, entry_type, FIELD_SEPARATOR);
+            if (entry_type == SHARD_ENTRY) {
+                fields >> record.shard.index >> record.shard.count;
+            } else if (entry_type == TASK_ENTRY) {
+                std::getline(fields, record.task_name);
+            } else if (entry_type == PARAMETERS_ENTRY) {
+                std::getline(fields, record.parameters);
+            } else if (entry_type == OBSERVER_COUNT_ENTRY) {
+                fields >> record.total_observers;
+            } else if (entry_type == OBSERVER_ENTRY) {
+                ObserverPosition position;
+                fields >> position.height >> position.azimuth;
+                record.positions.insert(position);
+            }
+            if (fields.fail()) {
+                throw runtime_error("Malformed line '" + line + "' in the shard record " + record_path.string());
+            }
+        }
+        return record;
+    }
+
+    void write_shard_record(const task_options& options,
+                            const shard_assignment& assignment) {
+        write_record(options.output_path, {
+                .shard = options.shard,
+                .task_name = options.task_name,
+                .parameters = to_hex(options.parameter_hash),
+                .total_observers = assignment.total_observers,
+                .positions = assignment.positions,
+        });
+    }
+
+    /**
+     * All shards of one run, ordered by their index. Throws if a shard is missing or belongs to another run.
+     */
+    static auto read_complete_shards(const path& shard_root) -> vector<pair<path, shard_record>> {
+        vector<pair<path, shard_record>> shards;
+        for (const auto& entry: directory_iterator(shard_root)) {
+            if (entry.is_directory() && entry.path().filename().string().starts_with(SHARD_FOLDER_PREFIX)) {
+                shards.emplace_back(entry.path(), read_record(entry.path()));
+            }
+        }
+        if (shards.empty()) {
+            throw invalid_argument("No shard folders in " + shard_root.string() + ".");
+        }
+        std::sort(shards.begin(), shards.end(), [](const auto& a, const auto& b) {
+            return a.second.shard.index < b.second.shard.index;
+        });
+
+        const auto& first = shards.front().second;
+        if (shards.size() != first.shard.count) {
+            throw runtime_error("Found " + std::to_string(shards.size()) + " shard folders in " + shard_root.string()
+                                + ", but the run was split into " + std::to_string(first.shard.count) + " shards.");
+        }
+        set<ObserverPosition> covered_positions;
+        for (size_t index = 0; index < shards.size(); index++) {
+            const auto& [folder, record] = shards[index];
+            if (record.shard.index != index || record.shard.count != first.shard.count) {
+                throw runtime_error("Shard " + std::to_string(index) + " of " + std::to_string(first.shard.count)
+                                    + " is missing in " + shard_root.string() + ".");
+            }
+            if (record.task_name != first.task_name || record.parameters != first.parameters) {
+                throw runtime_error("The shard in " + folder.string()
+                                    + " was run with another task or other options than the first shard.");
+            }
+            for (const auto& position: record.positions) {
+                if (!covered_positions.insert(position).second) {
+                    throw runtime_error("The observer at " + position.str() + " is part of several shards.");
+                }
+            }
+        }
+        if (covered_positions.size() != first.total_observers) {
+            throw runtime_error("The shards cover " + std::to_string(covered_positions.size()) + " of "
+                                + std::to_string(first.total_observers) + " observers.");
+        }
+        return shards;
+    }
+
+    /**
+     * Places the outputs of a shard in the merged folder, returns the number of files.
+     */
+    static auto link_shard_outputs(const path& shard_folder, const path& target_folder) -> size_t {
+        vector<path> file_paths;
+        for (const auto& entry: recursive_directory_iterator(shard_folder)) {
+            if (entry.is_regular_file()) {
+                file_paths.push_back(entry.path());
+            }
+        }
+        std::sort(file_paths.begin(), file_paths.end());
+
+        size_t file_count = 0;
+        for (const auto& file_path: file_paths) {
+            const auto relative_path = file_path.lexically_relative(shard_folder);
+            if (relative_path == SHARD_RECORD_FILE_NAME || relative_path == RUN_MANIFEST_FILE_NAME) {
+                continue;
+            }
+            const path target_path = target_folder / relative_path;
+            if (exists(target_path)) {
+                throw runtime_error("Several shards wrote " + relative_path.string() + ", "
+                                    + shard_folder.string() + " overlaps with an earlier shard.");
+            }
+            create_directories(target_path.parent_path());
+            std::error_code link_error;
+            std::filesystem::create_hard_link(file_path, target_path, link_error);
+            if (link_error) {
+                std::filesystem::copy_file(file_path, target_path);
+            }
+            file_count++;
+        }
+        return file_count;
+    }
+
+    void merge_shards(const path& shard_root) {
+        const auto shards = read_complete_shards(shard_root);
+        const path merged_folder = shard_root / MERGED_SHARDS_FOLDER;
+        const path temporary_folder{merged_folder.string() + ".tmp"};
+        std::filesystem::remove_all(temporary_folder);
+        create_directories(temporary_folder);
+
+        shard_record merged_record{
+                .shard = {},
+                .task_name = shards.front().second.task_name,
+                .parameters = shards.front().second.parameters,
+                .total_observers = shards.front().second.total_observers,
+                .positions = {},
+        };
+        RunManifest manifest(temporary_folder);
+        bool with_manifest = false;
+        size_t file_count = 0;
+        for (const auto& [folder, record]: shards) {
+            const auto shard_files = link_shard_outputs(folder, temporary_folder);
+            clog << folder.filename().string() << ": " << record.positions.size() << " observers, "
+                 << shard_files << " files" << endl;
+            file_count += shard_files;
+            merged_record.positions.insert(record.positions.cbegin(), record.positions.cend());
+            if (exists(folder / RUN_MANIFEST_FILE_NAME)) {
+                manifest.include(folder);
+                with_manifest = true;
+            }
+        }
+        if (with_manifest) {
+            manifest.save();
+        }
+        write_record(temporary_folder, merged_record);
+
+        // the previous merge is only replaced once the new one is complete
+        std::filesystem::remove_all(merged_folder);
+        std::filesystem::rename(temporary_folder, merged_folder);
+        clog << "Merged " << shards.size() << " shards with " << merged_record.positions.size() << " observers and "
+             << file_count << " files into " << merged_folder.string() << endl;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef RCSOP_LAUNCHER_SHARDING_H
+#define RCSOP_LAUNCHER_SHARDING_H
+
+#include "utils/types.h"
+
+#include "observer.h"
+#include "task_utils.h"
+
+namespace rcsop::launcher::utils {
+    using rcsop::common::Observer;
+    using rcsop::common::ObserverPosition;
+
+    const static string SHARD_RECORD_FILE_NAME = ".rcsop-shard";
+    const static string MERGED_SHARDS_FOLDER = "merged";
+
+    /**
+     * Observers of one shard. The positions of all observers are sorted by height and azimuth and dealt out
+     * to the shards in turn, so every process arrives at the same partition and the shards stay balanced.
+     */
+    struct shard_assignment {
+        set<ObserverPosition> positions;
+        size_t total_observers = 0;
+        /**
+         * Heights of all observers, the outputs of a shard use the same folders as an unsharded run.
+         */
+        vector<height_t> heights;
+
+        [[nodiscard]] bool contains(const Observer& observer) const {
+            return positions.contains(observer.position());
+        }
+    };
+
+    [[nodiscard]] auto assign_shard(const vector<Observer>& observers,
+                                    const shard_options& shard) -> shard_assignment;
+
+    /**
+     * Output folder of a shard below the task folder, e.g. shard-2-of-4.
+     */
+    [[nodiscard]] auto shard_folder_name(const shard_options& shard) -> string;
+
+    /**
+     * Notes the shard, the task, the parameter hash and the observers of the shard in its output folder.
+     * Written last, so a shard without the record did not finish.
+     */
+    void write_shard_record(const task_options& options,
+                            const shard_assignment& assignment);
+
+    /**
+     * Stitches the finished shard folders below shard_root into shard_root/merged, laid out like the output
+     * of an unsharded run. All shards of the same run have to be present and have to cover disjoint observers.
+     * The run manifests of the shards are combined as well. Files are hard linked where possible and copied
+     * otherwise, the shard folders stay intact.
+     */
+    void merge_shards(const path& shard_root);
+}
+
+#endif //RCSOP_LAUNCHER_SHARDING_H
@@ -1,12 +1,22 @@
 #include "utils/task_utils.h"
 
+#include "utils/tracing.h"
+#include "utils/memory.h"
+
+#include "render_pipeline.h"
+
 namespace rcsop::launcher::utils {
     using std::for_each;
     using std::filesystem::create_directories;
 
     using rcsop::data::ModelWriter;
 
+    using rcsop::rendering::render_job;
+    using rcsop::rendering::render_pipelined;
+
     using rcsop::common::utils::logging::construct_log_prefix;
+    using rcsop::common::utils::tracing::ScopedSpan;
+    using rcsop::common::utils::memory::ScopedMemoryStage;
 
     void batch_output(vector<shared_ptr<OutputDataWriter>>& output_writers,
                       const task_options& options,
@@ -22,24 +32,48 @@ namespace rcsop::launcher::utils {
                 create_directories(path);
             });
         }
-        auto renderer_indexes = common::utils::get_indices(output_writers);
-        std::for_each(
-                std::execution::seq,
-                renderer_indexes.cbegin(),
-                renderer_indexes.cend(),
-                [&options, &output_writers, &height_folders](const auto renderer_index) {
-                    auto output_writer = output_writers.at(renderer_index);
-
-                    const auto place_in_separate_folder =
-                            height_folders.size() > 1 && output_writer->observer_has_position();
-
-                    path output_path = place_in_separate_folder
-                                       ? height_folders.at(output_writer->observer_height())
-                                       : options.output_path;
-                    path output_processor_folder = output_path / output_writer->path_prefix();
-                    create_directories(output_processor_folder);
-                    output_writer->write(output_processor_folder,
-                                         construct_log_prefix(renderer_index + 1, output_writers.size()));
+        const auto output_folder = [&options, &height_folders](const OutputDataWriter& output_writer) {
+            const auto place_in_separate_folder =
+                    height_folders.size() > 1 && output_writer.observer_has_position();
+
+            path output_path = place_in_separate_folder
+                               ? height_folders.at(output_writer.observer_height())
+                               : options.output_path;
+            path output_processor_folder = output_path / output_writer.path_prefix();
+            create_directories(output_processor_folder);
+            return output_processor_folder;
+        };
+
+        // runs of images with the same prefix go through the render pipeline together, so the outputs keep
+        // their order and every prefix its own stage
+        const size_t writer_count = output_writers.size();
+        size_t writer_index = 0;
+        while (writer_index < writer_count) {
+            const auto& output_writer = output_writers[writer_index];
+            const auto path_prefix = output_writer->path_prefix();
+            ScopedSpan span("write_output", path_prefix);
+            ScopedMemoryStage memory_stage("write_output:" + path_prefix);
+            if (std::dynamic_pointer_cast<ObserverRenderer>(output_writer) == nullptr) {
+                output_writer->write(output_folder(*output_writer),
+                                     construct_log_prefix(writer_index + 1, writer_count));
+                writer_index++;
+                continue;
+            }
+
+            vector<render_job> render_jobs;
+            for (; writer_index < writer_count; writer_index++) {
+                auto renderer = std::dynamic_pointer_cast<ObserverRenderer>(output_writers[writer_index]);
+                if (renderer == nullptr || renderer->path_prefix() != path_prefix) {
+                    break;
+                }
+                const auto output_path = output_folder(*renderer);
+                render_jobs.push_back({
+                        .renderer = std::move(renderer),
+                        .output_path = output_path,
+                        .log_prefix = construct_log_prefix(writer_index + 1, writer_count),
                 });
+            }
+            render_pipelined(render_jobs);
+        }
     }
 }
\ No newline at end of file
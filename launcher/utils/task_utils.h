@@ -3,6 +3,8 @@
 
 #include <filesystem>
 
+#include "utils/content_hash.h"
+
 #include "input_data_collector.h"
 #include "rendering_options.h"
 #include "observer_renderer.h"
@@ -14,6 +16,7 @@ namespace rcsop::launcher::utils {
     using rcsop::common::camera_options;
     using rcsop::common::OutputDataWriter;
     using rcsop::common::height_t;
+    using rcsop::common::utils::io::content_hash_t;
 
     using rcsop::data::InputDataCollector;
 
@@ -39,10 +42,40 @@ namespace rcsop::launcher::utils {
         NONE = 0,
         RENDERING = 1,
         SPARSE_MODEL = 2,
+        POINT_CLOUD = 4,
+        SCORED_CLOUD = 8,
 
         BOTH = RENDERING | SPARSE_MODEL,
     };
 
+    /**
+     * Values to render every combination of, the scored points are shared by all of them.
+     * Either all lists are empty (no sweep) or each holds at least one value.
+     */
+    struct rendering_sweep {
+        vector<double> db_min;
+        vector<double> db_max;
+        vector<string> color_maps;
+        vector<float> alphas;
+        vector<float> gradient_radii;
+
+        [[nodiscard]] bool enabled() const {
+            return !db_min.empty();
+        }
+    };
+
+    /**
+     * Part of the observers a process works on, see --shard. A count of 1 covers all observers.
+     */
+    struct shard_options {
+        size_t index = 0;
+        size_t count = 1;
+
+        [[nodiscard]] bool enabled() const {
+            return count > 1;
+        }
+    };
+
     struct task_options {
         string task_name;
         path input_path;
@@ -51,10 +84,27 @@ namespace rcsop::launcher::utils {
         vertical_spread vertical_options;
         PointGenerator point_generator;
         size_t point_density;
+        double point_spacing;
+        /**
+         * Number of base points observed and accumulated at a time, 0 keeps all base points in memory.
+         */
+        size_t chunk_size;
         ScoreRange db_range;
         camera_options camera;
         rendering_options rendering;
+        rendering_sweep sweep;
         OutputFormat output_format;
+        /**
+         * Folder with the scored clouds written by an earlier run, read by render-scored.
+         */
+        path scored_path;
+        path trace_path;
+        bool incremental;
+        shard_options shard;
+        /**
+         * Hash of all options that influence the outputs, see RunManifest.
+         */
+        content_hash_t parameter_hash;
     };
 
     using launcher_task = std::function<void(const InputDataCollector&, const task_options&)>;
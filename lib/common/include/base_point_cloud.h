@@ -21,7 +21,7 @@ namespace rcsop::common {
 
         virtual ~BasePointCloud() = default;
 
-        [[nodiscard]] auto model_path() -> path;
+        [[nodiscard]] auto model_path() const -> path;
 
     public:
         [[nodiscard]] virtual shared_ptr<vector<SimplePoint>> get_points() const = 0;
@@ -1,6 +1,8 @@
 #ifndef RCSOP_COMMON_COLORS_H
 #define RCSOP_COMMON_COLORS_H
 
+#include <span>
+
 #include "utils/types.h"
 #include "utils/sparse.h"
 #include "utils/mapping.h"
@@ -12,7 +14,54 @@ namespace rcsop::common::coloring {
     using rcsop::common::ScoreRange;
 
     using local_colormap_func = function<color_vec(double v, double vmin, double vmax)>;
-    using global_colormap_func = function<color_vec(double v)>;
+
+    /**
+     * Entries per color lookup table, fine enough that neighbouring entries of the continuous maps
+     * differ by at most one step per channel.
+     */
+    const static size_t COLOR_TABLE_SIZE = 4096;
+
+    /**
+     * A color map sampled once over a fixed range of values. Values outside of the range (and NaN)
+     * get the color of the nearest end. Copies share the same table.
+     */
+    class ColorLookupTable {
+    private:
+        double _min_value;
+        double _max_value;
+        double _value_to_index;
+        shared_ptr<const vector<color_vec>> _colors;
+
+        [[nodiscard]] size_t index_of(double value) const {
+            const double position = (value - _min_value) * _value_to_index + 0.5;
+            // also catches NaN, all comparisons with it are false
+            if (!(position > 0)) {
+                return 0;
+            }
+            return std::min(static_cast<size_t>(position), _colors->size() - 1);
+        }
+
+    public:
+        ColorLookupTable(const local_colormap_func& color_map,
+                         double min_value,
+                         double max_value,
+                         size_t table_size = COLOR_TABLE_SIZE);
+
+        [[nodiscard]] color_vec operator()(double value) const {
+            return (*_colors)[index_of(value)];
+        }
+
+        /**
+         * Maps every value to the color at the same position, both spans need the same size.
+         */
+        void map_values(std::span<const double> values, std::span<color_vec> colors) const;
+
+        [[nodiscard]] auto map_values(const vector<double>& values) const -> vector<color_vec>;
+
+        [[nodiscard]] auto range() const -> ScoreRange;
+    };
+
+    using global_colormap_func = ColorLookupTable;
 
     [[nodiscard]] color_vec map_turbo(double v, double vmin, double vmax);
 
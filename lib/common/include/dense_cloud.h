@@ -3,6 +3,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <CGAL/Surface_mesh/Surface_mesh.h>
@@ -26,10 +27,24 @@ namespace rcsop::common {
     using rcsop::common::SimplePoint;
     using rcsop::common::BasePointCloud;
 
+    /**
+     * Vertices are read directly from binary PLY files, the triangulated mesh and its inside test
+     * are only built on first use of is_inside or filter_points
+     */
     class DenseCloud : public BasePointCloud {
     private:
-        unique_ptr<SurfaceMesh> _mesh;
-        unique_ptr<InsideTriangleMesh> _inside;
+        vector<SimplePoint> _vertices;
+
+        mutable unique_ptr<SurfaceMesh> _mesh;
+        mutable unique_ptr<InsideTriangleMesh> _inside;
+        mutable bool _mesh_closed = false;
+        mutable std::once_flag _mesh_loaded;
+
+        [[nodiscard]] bool read_vertices_only();
+
+        void load_mesh() const;
+
+        SurfaceMesh& mesh() const;
 
     public:
         explicit DenseCloud(const path& ply_file_path);
@@ -6,12 +6,14 @@
 
 namespace rcsop::common {
     using rcsop::common::utils::points::vec2;
+    using rcsop::common::utils::points::stored_vec2;
+    using rcsop::common::utils::points::storage_scalar_t;
 
     class ImagePoint {
     private:
-        vec2 _coordinates = vec2::Zero();
-        double _distance = 0;
-        double _score = 0;
+        stored_vec2 _coordinates = stored_vec2::Zero();
+        storage_scalar_t _distance = 0;
+        storage_scalar_t _score = 0;
     public:
         explicit ImagePoint() = default;
 
@@ -1,6 +1,8 @@
 #ifndef RCSOP_COMMON_CAMERA_H
 #define RCSOP_COMMON_CAMERA_H
 
+#include <span>
+
 #include "colmap/util/types.h"
 #include "colmap/base/reconstruction.h"
 
@@ -24,6 +26,9 @@ namespace rcsop::common {
         ModelCamera(const colmap::Image& image,
                     const colmap::Reconstruction& model);
 
+        ModelCamera(colmap::Image image,
+                    colmap::Camera camera);
+
         [[nodiscard]] camera_id_t id() const;
 
         /**
@@ -44,7 +49,7 @@ namespace rcsop::common {
 
         [[nodiscard]] string get_name() const;
 
-        [[nodiscard]] vector<ImagePoint> project_to_image(const vector<ScoredPoint>& points) const;
+        void project_to_image(std::span<const ScoredPoint> points, std::span<ImagePoint> image_points) const;
 
         [[nodiscard]] string get_last_name_segment() const;
     };
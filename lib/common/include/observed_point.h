@@ -7,16 +7,27 @@
 namespace rcsop::common {
     using rcsop::common::utils::points::vec3;
     using rcsop::common::utils::points::point_id_t;
+    using rcsop::common::utils::points::stored_vec3;
+    using rcsop::common::utils::points::storage_scalar_t;
 
     struct observed_point {
-        vec3 position = vec3::Zero();
+        stored_vec3 position = stored_vec3::Zero();
         point_id_t id{};
-        double distance_in_world{};
-        double vertical_angle{};
-        double horizontal_angle{};
+        storage_scalar_t distance_in_world{};
+        storage_scalar_t vertical_angle{};
+        storage_scalar_t horizontal_angle{};
     };
 
-    using observed_factor_func = function<double(const observed_point&)>;
+    /**
+     * A point in the local frame of an observer's camera, before the roll of the data is applied.
+     * Shared by all data labels of the same observer.
+     */
+    struct camera_local_point {
+        stored_vec3 position = stored_vec3::Zero();
+        point_id_t id{};
+        stored_vec3 local_position = stored_vec3::Zero();
+        storage_scalar_t distance_in_world{};
+    };
 }
 
 #endif //RCSOP_COMMON_OBSERVED_POINT_H
@@ -68,6 +68,20 @@ namespace rcsop::common {
 
         [[nodiscard]] auto observe_point(const SimplePoint& point) const -> observed_point;
 
+        [[nodiscard]] auto to_camera_local(const SimplePoint& point) const -> camera_local_point;
+
+        [[nodiscard]] auto
+        to_camera_local(const vector<SimplePoint>& points) const -> shared_ptr<vector<camera_local_point>>;
+
+        /**
+         * Applies only the roll of this observer and the spherical conversion, the points have to be
+         * mapped by an observer with the same camera and camera options, e.g. before clone_with_data.
+         */
+        [[nodiscard]] auto observe_camera_local(const camera_local_point& point) const -> observed_point;
+
+        [[nodiscard]] auto
+        observe_camera_local(const vector<camera_local_point>& points) const -> shared_ptr<vector<observed_point>>;
+
         [[nodiscard]] auto
         observe_points(const vector<SimplePoint>& camera_points) const -> shared_ptr<vector<observed_point>>;
 
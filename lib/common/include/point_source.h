@@ -0,0 +1,108 @@
+#ifndef RCSOP_COMMON_POINT_SOURCE_H
+#define RCSOP_COMMON_POINT_SOURCE_H
+
+#include <span>
+
+#include "utils/types.h"
+#include "utils/points.h"
+#include "utils/mapped_file.h"
+#include "utils/ply_vertices.h"
+#include "simple_point.h"
+
+namespace rcsop::common {
+    using rcsop::common::utils::points::point_id_t;
+    using rcsop::common::utils::points::vec3;
+    using rcsop::common::utils::io::MappedFile;
+    using rcsop::common::utils::io::ply_vertex_layout;
+
+    using point_chunk = std::span<const SimplePoint>;
+
+    /**
+     * Points handed out in chunks of a bounded size, so consumers only hold a chunk at a time instead of the
+     * whole cloud. Chunks can be read concurrently and in any order, reading a chunk again yields the same points.
+     */
+    class PointSource {
+    public:
+        virtual ~PointSource() = default;
+
+        [[nodiscard]] virtual size_t chunk_count() const = 0;
+
+        /**
+         * Points of the chunk, either a view into the source or decoded into the buffer.
+         * Valid until the buffer is changed.
+         */
+        [[nodiscard]] virtual point_chunk read_chunk(size_t chunk_index, vector<SimplePoint>& buffer) const = 0;
+    };
+
+    /**
+     * Points already in memory, the chunks are views into the vector. A chunk size of 0 hands out all points at once.
+     */
+    class VectorPointSource : public PointSource {
+    private:
+        shared_ptr<const vector<SimplePoint>> _points;
+        size_t _chunk_size;
+
+    public:
+        VectorPointSource(shared_ptr<const vector<SimplePoint>> points, size_t chunk_size);
+
+        [[nodiscard]] size_t chunk_count() const override;
+
+        [[nodiscard]] point_chunk read_chunk(size_t chunk_index, vector<SimplePoint>& buffer) const override;
+    };
+
+    /**
+     * Vertices of a binary PLY file, the file is mapped and only the vertices of the requested chunk are decoded.
+     * The vertex with index i gets the id first_id + i.
+     */
+    class PlyVertexSource : public PointSource {
+    private:
+        unique_ptr<MappedFile> _file;
+        ply_vertex_layout _layout;
+        const char* _vertex_data;
+        size_t _chunk_size;
+        point_id_t _first_id;
+
+        PlyVertexSource(unique_ptr<MappedFile> file,
+                        const ply_vertex_layout& layout,
+                        const char* vertex_data,
+                        size_t chunk_size,
+                        point_id_t first_id);
+
+    public:
+        /**
+         * nullptr if the file is not a binary little-endian PLY with the vertices first.
+         */
+        [[nodiscard]] static auto open(const path& ply_file_path,
+                                       size_t chunk_size,
+                                       point_id_t first_id = 0) -> shared_ptr<PlyVertexSource>;
+
+        [[nodiscard]] size_t vertex_count() const;
+
+        [[nodiscard]] size_t chunk_count() const override;
+
+        [[nodiscard]] point_chunk read_chunk(size_t chunk_index, vector<SimplePoint>& buffer) const override;
+    };
+
+    /**
+     * The chunks of several sources one after another.
+     */
+    class ChainedPointSource : public PointSource {
+    private:
+        vector<shared_ptr<const PointSource>> _sources;
+        vector<size_t> _first_chunks;
+
+    public:
+        explicit ChainedPointSource(vector<shared_ptr<const PointSource>> sources);
+
+        [[nodiscard]] size_t chunk_count() const override;
+
+        [[nodiscard]] point_chunk read_chunk(size_t chunk_index, vector<SimplePoint>& buffer) const override;
+    };
+
+    /**
+     * Smallest and largest coordinates of all points, reads the source chunk by chunk. Empty if there are no points.
+     */
+    [[nodiscard]] auto get_bounds(const PointSource& source) -> optional<pair<vec3, vec3>>;
+}
+
+#endif //RCSOP_COMMON_POINT_SOURCE_H
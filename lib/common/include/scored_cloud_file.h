@@ -0,0 +1,62 @@
+#ifndef RCSOP_COMMON_SCORED_CLOUD_FILE_H
+#define RCSOP_COMMON_SCORED_CLOUD_FILE_H
+
+#include <cstdint>
+#include <limits>
+
+#include "utils/types.h"
+#include "utils/mapped_file.h"
+
+#include "scored_point.h"
+#include "observer_position.h"
+
+namespace rcsop::common {
+    using rcsop::common::utils::io::MappedFile;
+
+    const static char SCORED_CLOUD_MAGIC[8] = {'R', 'C', 'S', 'O', 'P', 'S', 'C', 'F'};
+    const static std::uint32_t SCORED_CLOUD_VERSION = 1;
+    const static string SCORED_CLOUD_EXTENSION = ".rcsc";
+
+    /**
+     * Writes the scored points of one observer in columns: a header with the observer position and the point
+     * count, followed by the x, y and z coordinates, the raw score, the score in dB and the point id, each as a
+     * contiguous array of 8 byte values. The file is written next to its target first and renamed afterwards.
+     */
+    void write_scored_cloud(const path& file_path,
+                            const ObserverPosition& position,
+                            const vector<ScoredPoint>& points);
+
+    /**
+     * Memory mapped scored points of one observer written by write_scored_cloud, the columns are only read
+     * when the points are extracted.
+     */
+    class ScoredCloudFile {
+    private:
+        MappedFile _file;
+        ObserverPosition _position;
+        size_t _point_count = 0;
+
+        template<typename T>
+        [[nodiscard]] T column_value(size_t column, size_t index) const;
+
+    public:
+        explicit ScoredCloudFile(path file_path);
+
+        [[nodiscard]] auto position() const -> ObserverPosition;
+
+        [[nodiscard]] auto point_count() const -> size_t;
+
+        /**
+         * Points with a score of at least min_dB, in the order they were written.
+         */
+        [[nodiscard]] auto points(double min_dB = -std::numeric_limits<double>::infinity()) const
+        -> shared_ptr<vector<ScoredPoint>>;
+
+        /**
+         * File name of the scored cloud of an observer position, without any non-ASCII characters.
+         */
+        [[nodiscard]] static auto file_name(const ObserverPosition& position) -> string;
+    };
+}
+
+#endif //RCSOP_COMMON_SCORED_CLOUD_FILE_H
@@ -7,6 +7,7 @@
 
 namespace rcsop::common {
     using rcsop::common::SimplePoint;
+    using rcsop::common::utils::points::storage_scalar_t;
 
     struct ScoreRange {
         double min;
@@ -18,7 +19,7 @@ namespace rcsop::common {
     class ScoredPoint : public IdPoint {
     private:
         SimplePoint _point;
-        double _score{default_point_score};
+        storage_scalar_t _score = default_point_score;
 
     public:
         ScoredPoint() = default;
@@ -53,6 +54,8 @@ namespace rcsop::common {
 
         [[nodiscard]] point_id_t id() const override;
 
+        [[nodiscard]] double score() const;
+
         [[nodiscard]] double score_to_dB() const;
 
         [[nodiscard]] bool is_discarded() const;
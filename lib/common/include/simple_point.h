@@ -10,11 +10,12 @@
 namespace rcsop::common {
     using rcsop::common::utils::points::point_id_t;
     using rcsop::common::utils::points::vec3;
+    using rcsop::common::utils::points::stored_vec3;
 
     class SimplePoint : public IdPoint {
     private:
         point_id_t _point_id = -1;
-        vec3 _position = vec3::Zero();
+        stored_vec3 _position = stored_vec3::Zero();
 
     public:
         SimplePoint() = default;
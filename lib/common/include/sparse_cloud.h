@@ -29,6 +29,11 @@ namespace rcsop::common {
 
         [[nodiscard]] shared_ptr<vector<SimplePoint>> get_points() const override;
 
+        /**
+         * Point positions only, in the same (ascending ID) order as returned by get_points()
+         */
+        [[nodiscard]] shared_ptr<vector<vec3>> get_point_positions() const;
+
         [[nodiscard]] size_t point_count() const override;
 
         void reload();
@@ -39,6 +44,10 @@ namespace rcsop::common {
 
         void add_point(const IdPoint* point, const color_vec& color) override;
 
+        void add_points(const vector<SimplePoint>& points, const vector<color_vec>& colors);
+
+        void delete_points(const vector<point_id_t>& point_ids);
+
         void write(const path& output_path) override;
 
         void purge_cameras(camera_id_t camera_to_keep) override;
@@ -0,0 +1,52 @@
+#ifndef RCSOP_COMMON_SPARSE_CLOUD_READER_H
+#define RCSOP_COMMON_SPARSE_CLOUD_READER_H
+
+#include "utils/types.h"
+#include "utils/points.h"
+#include "utils/sparse.h"
+
+#include "model_camera.h"
+#include "simple_point.h"
+
+namespace rcsop::common {
+    using rcsop::common::utils::sparse::color_vec;
+    using rcsop::common::utils::points::point_id_t;
+    using rcsop::common::utils::points::vec3;
+
+    /**
+     * Read-only view of a binary COLMAP model, containing only point positions and colors,
+     * camera poses and intrinsics. Point tracks and 2D observations are skipped while reading.
+     */
+    class SparseCloudReader {
+    private:
+        struct sparse_point {
+            point_id_t id;
+            vec3 position;
+            color_vec color;
+        };
+
+        vector<sparse_point> _points;
+        vector<ModelCamera> _cameras;
+
+        void read_points(const path& points_path);
+
+        void read_cameras(const path& cameras_path, const path& images_path);
+
+    public:
+        explicit SparseCloudReader(const path& model_path);
+
+        [[nodiscard]] vector<ModelCamera> get_cameras() const;
+
+        [[nodiscard]] shared_ptr<vector<SimplePoint>> get_points() const;
+
+        [[nodiscard]] shared_ptr<vector<vec3>> get_point_positions() const;
+
+        [[nodiscard]] vector<color_vec> get_point_colors() const;
+
+        [[nodiscard]] size_t point_count() const;
+
+        [[nodiscard]] static bool is_available_at(const path& root_path);
+    };
+}
+
+#endif //RCSOP_COMMON_SPARSE_CLOUD_READER_H
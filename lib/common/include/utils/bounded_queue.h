@@ -0,0 +1,83 @@
+#ifndef RCSOP_COMMON_BOUNDED_QUEUE_H
+#define RCSOP_COMMON_BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "utils/types.h"
+
+namespace rcsop::common::utils {
+    /**
+     * Hands items from producer to consumer threads, producers wait while the queue holds capacity items.
+     * Connects the stages of a pipeline, so a fast stage can't run ahead of a slow one by more than the
+     * capacity and the memory held in between stays bounded.
+     */
+    template<typename T>
+    class BoundedQueue {
+    private:
+        const size_t _capacity;
+        std::deque<T> _items;
+        bool _closed = false;
+        std::mutex _lock;
+        std::condition_variable _not_full;
+        std::condition_variable _not_empty;
+
+    public:
+        explicit BoundedQueue(size_t capacity)
+                : _capacity(std::max<size_t>(capacity, 1)) {}
+
+        BoundedQueue(const BoundedQueue&) = delete;
+
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        /**
+         * Waits for a free place, returns false without adding the item if the queue was closed.
+         */
+        bool push(T item) {
+            std::unique_lock guard(_lock);
+            _not_full.wait(guard, [this]() {
+                return _closed || _items.size() < _capacity;
+            });
+            if (_closed) {
+                return false;
+            }
+            _items.push_back(std::move(item));
+            guard.unlock();
+            _not_empty.notify_one();
+            return true;
+        }
+
+        /**
+         * Waits for the next item, nothing once the queue is closed and all items before were taken.
+         */
+        optional<T> pop() {
+            std::unique_lock guard(_lock);
+            _not_empty.wait(guard, [this]() {
+                return _closed || !_items.empty();
+            });
+            if (_items.empty()) {
+                return std::nullopt;
+            }
+            T item = std::move(_items.front());
+            _items.pop_front();
+            guard.unlock();
+            _not_full.notify_one();
+            return item;
+        }
+
+        /**
+         * No more items are accepted, waiting producers give up and consumers stop after the remaining items.
+         */
+        void close() {
+            {
+                const std::lock_guard guard(_lock);
+                _closed = true;
+            }
+            _not_full.notify_all();
+            _not_empty.notify_all();
+        }
+    };
+}
+
+#endif //RCSOP_COMMON_BOUNDED_QUEUE_H
@@ -0,0 +1,31 @@
+#ifndef RCSOP_COMMON_CONTENT_HASH_H
+#define RCSOP_COMMON_CONTENT_HASH_H
+
+#include <cstdint>
+
+#include "utils/types.h"
+
+namespace rcsop::common::utils::io {
+    using content_hash_t = std::uint64_t;
+
+    const static content_hash_t CONTENT_HASH_SEED = 14695981039346656037ULL;
+
+    /**
+     * FNV-1a over 8 byte words (the remaining bytes one by one), only meant to detect changed inputs.
+     * Hashes can be chained by passing the previous hash as the seed.
+     */
+    [[nodiscard]] content_hash_t hash_bytes(const char* data, size_t size,
+                                            content_hash_t seed = CONTENT_HASH_SEED);
+
+    [[nodiscard]] content_hash_t hash_string(const string& value,
+                                             content_hash_t seed = CONTENT_HASH_SEED);
+
+    /**
+     * Hash of the whole content of a file, read through a memory mapping.
+     */
+    [[nodiscard]] content_hash_t hash_file(const path& file_path);
+
+    [[nodiscard]] string to_hex(content_hash_t hash);
+}
+
+#endif //RCSOP_COMMON_CONTENT_HASH_H
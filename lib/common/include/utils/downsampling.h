@@ -0,0 +1,79 @@
+#ifndef RCSOP_COMMON_DOWNSAMPLING_H
+#define RCSOP_COMMON_DOWNSAMPLING_H
+
+#include <array>
+#include <numeric>
+
+#include "utils/types.h"
+#include "utils/points.h"
+#include "utils/mapping.h"
+
+#include "id_point.h"
+
+namespace rcsop::common::utils::points {
+    using voxel_key = std::array<long, 3>;
+
+    /**
+     * Thins a cloud spatially: the space is divided into cubes with an edge length of voxel_size (in world units)
+     * and only the point nearest to the center of each occupied cube is kept. Dense regions are thinned while
+     * isolated points survive, so the coverage of the cloud stays intact.
+     * The result keeps the original order of the remaining points.
+     */
+    template<typename PointType>
+    requires std::is_base_of_v<IdPoint, PointType>
+    auto voxel_downsample(const vector<PointType>& points,
+                          double voxel_size) -> shared_ptr<vector<PointType>> {
+        if (voxel_size <= 0) {
+            throw invalid_argument("Voxel size must be positive");
+        }
+        struct voxel_entry {
+            voxel_key key;
+            double distance_to_center;
+            size_t index;
+        };
+
+        vector<size_t> indices(points.size());
+        std::iota(indices.begin(), indices.end(), 0);
+
+        vector<voxel_entry> entries(points.size());
+        parallel::transform<false>(indices.cbegin(), indices.cend(), entries.begin(),
+                                   [&points, voxel_size](const size_t index) {
+                                       const vec3 scaled = points[index].position() / voxel_size;
+                                       const vec3 cell = scaled.array().floor();
+                                       const vec3 offset = scaled - cell - vec3::Constant(0.5);
+                                       return voxel_entry{
+                                               .key = {static_cast<long>(cell.x()),
+                                                       static_cast<long>(cell.y()),
+                                                       static_cast<long>(cell.z())},
+                                               .distance_to_center = offset.squaredNorm(),
+                                               .index = index,
+                                       };
+                                   });
+        parallel::sort<false>(entries.begin(), entries.end(), [](const voxel_entry& a, const voxel_entry& b) {
+            if (a.key != b.key) {
+                return a.key < b.key;
+            }
+            if (a.distance_to_center != b.distance_to_center) {
+                return a.distance_to_center < b.distance_to_center;
+            }
+            return a.index < b.index;
+        });
+
+        vector<size_t> kept_indices;
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (i == 0 || entries[i].key != entries[i - 1].key) {
+                kept_indices.push_back(entries[i].index);
+            }
+        }
+        parallel::sort<false>(kept_indices.begin(), kept_indices.end());
+
+        auto result = make_shared<vector<PointType>>();
+        result->reserve(kept_indices.size());
+        for (const auto index: kept_indices) {
+            result->push_back(points[index]);
+        }
+        return result;
+    }
+}
+
+#endif //RCSOP_COMMON_DOWNSAMPLING_H
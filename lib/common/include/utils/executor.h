@@ -0,0 +1,143 @@
+#ifndef RCSOP_COMMON_EXECUTOR_H
+#define RCSOP_COMMON_EXECUTOR_H
+
+#include <algorithm>
+#include <execution>
+
+#include "utils/types.h"
+
+constexpr auto PARALLEL = std::execution::par;
+constexpr auto PARALLEL_VECTORIZED = std::execution::par_unseq;
+
+namespace rcsop::common::utils::parallel {
+    /**
+     * Which level of nested loops runs in parallel. Outer loops are the ones over observers, inner loops
+     * the ones over the points of an observer.
+     */
+    enum class nesting_policy {
+        /**
+         * Outer loops run one item after the other, each inner loop uses all threads.
+         */
+        INNER_LOOPS,
+        /**
+         * Outer loops use all threads, the inner loops of an item run on the thread of the item.
+         * Temporaries are then held for as many items as there are threads.
+         */
+        OUTER_LOOPS,
+        /**
+         * Outer items are split into fine-grained tasks, which idle threads steal from the busy ones. Loops
+         * within a task run on the thread of the task, like with OUTER_LOOPS.
+         */
+        TASKS,
+    };
+
+    struct executor_options {
+        /**
+         * Upper limit of the threads of all parallel loops, 0 for one per core.
+         */
+        size_t threads = 0;
+        nesting_policy nesting = nesting_policy::INNER_LOOPS;
+    };
+
+    /**
+     * Applies the options to all parallel loops of the process started afterwards.
+     */
+    void configure_executor(const executor_options& options);
+
+    [[nodiscard]] auto executor_configuration() -> executor_options;
+
+    /**
+     * Number of threads parallel loops can use, at least 1.
+     */
+    [[nodiscard]] auto thread_count() -> size_t;
+
+    /**
+     * Whether a loop started on the calling thread should be spread across threads. Not the case with a single
+     * thread or within an item of a parallel outer loop.
+     */
+    [[nodiscard]] bool run_parallel();
+
+    /**
+     * Marks the calling thread as working on an item of a parallel outer loop for the lifetime of the scope.
+     */
+    class ScopedOuterItem {
+    public:
+        ScopedOuterItem();
+
+        ~ScopedOuterItem();
+
+        ScopedOuterItem(const ScopedOuterItem&) = delete;
+
+        ScopedOuterItem& operator=(const ScopedOuterItem&) = delete;
+    };
+
+    template<bool Vectorized = true, typename Iterator, typename Function>
+    void for_each(Iterator first, Iterator last, Function function) {
+        if (!run_parallel()) {
+            std::for_each(first, last, function);
+        } else if constexpr (Vectorized) {
+            std::for_each(PARALLEL_VECTORIZED, first, last, function);
+        } else {
+            std::for_each(PARALLEL, first, last, function);
+        }
+    }
+
+    template<bool Vectorized = true, typename Iterator, typename OutputIterator, typename Function>
+    void transform(Iterator first, Iterator last, OutputIterator result, Function function) {
+        if (!run_parallel()) {
+            std::transform(first, last, result, function);
+        } else if constexpr (Vectorized) {
+            std::transform(PARALLEL_VECTORIZED, first, last, result, function);
+        } else {
+            std::transform(PARALLEL, first, last, result, function);
+        }
+    }
+
+    template<bool Vectorized = true, typename Iterator, typename SecondIterator, typename OutputIterator,
+            typename Function>
+    void transform(Iterator first, Iterator last, SecondIterator second, OutputIterator result, Function function) {
+        if (!run_parallel()) {
+            std::transform(first, last, second, result, function);
+        } else if constexpr (Vectorized) {
+            std::transform(PARALLEL_VECTORIZED, first, last, second, result, function);
+        } else {
+            std::transform(PARALLEL, first, last, second, result, function);
+        }
+    }
+
+    template<bool Vectorized = true, typename Iterator, typename Compare = std::less<>>
+    void sort(Iterator first, Iterator last, Compare compare = {}) {
+        if (!run_parallel()) {
+            std::sort(first, last, compare);
+        } else if constexpr (Vectorized) {
+            std::sort(PARALLEL_VECTORIZED, first, last, compare);
+        } else {
+            std::sort(PARALLEL, first, last, compare);
+        }
+    }
+
+    /**
+     * Runs the tasks 0 to task_count - 1 on the work-stealing pool, each one as an item of an outer loop.
+     * Tasks are handed out one by one, so a few long tasks don't hold up the short ones queued behind them.
+     * Serially in order if parallel loops are not to be used on the calling thread.
+     */
+    void run_tasks(size_t task_count, const function<void(size_t)>& task);
+
+    /**
+     * Loop over the items of an outer loop, e.g. the observers. In parallel with the OUTER_LOOPS and the TASKS
+     * policy, the loops within an item then run serially.
+     */
+    template<typename Iterator, typename Function>
+    void for_each_outer(Iterator first, Iterator last, Function function) {
+        if (executor_configuration().nesting == nesting_policy::INNER_LOOPS || !run_parallel()) {
+            std::for_each(first, last, function);
+            return;
+        }
+        std::for_each(PARALLEL, first, last, [&function](auto&& item) {
+            const ScopedOuterItem outer_item;
+            function(item);
+        });
+    }
+}
+
+#endif //RCSOP_COMMON_EXECUTOR_H
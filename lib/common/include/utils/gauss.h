@@ -1,9 +1,17 @@
 #ifndef RCSOP_COMMON_GAUSS_H
 #define RCSOP_COMMON_GAUSS_H
 
+#include <cmath>
+
 #include "observed_point.h"
 
 namespace rcsop::common::utils::gauss {
+    /**
+     * Samples per standard deviation in a GaussTable, the relative interpolation error stays below 1e-4.
+     */
+    const static double GAUSS_TABLE_SAMPLES_PER_SIGMA = 64.;
+    const static size_t GAUSS_TABLE_MAX_SAMPLES = 1 << 16;
+
     struct gauss_options {
         double sigma{};
         double integral_factor{};
@@ -15,9 +23,78 @@ namespace rcsop::common::utils::gauss {
 
     [[nodiscard]] double get_gauss_integral_factor(const double& sigma);
 
-    [[nodiscard]] observed_factor_func rcs_gaussian_vertical(
-            double vertical_spread,
-            double sigma);
+    /**
+     * Normalized 2D distribution over the horizontal and vertical angle of an observed point,
+     * scaled to an ellipse with the half axes x_scale and y_scale (in degrees). Zero outside of it.
+     */
+    [[nodiscard]] double rcs_gaussian(const observed_point& point,
+                                      const gauss_options& options);
+
+    /**
+     * gauss(x, sigma) sampled over [-limit, limit] and linearly interpolated in between.
+     * Values outside of the domain are calculated exactly.
+     */
+    class GaussTable {
+    private:
+        double _sigma;
+        double _limit;
+        double _inverse_step;
+        vector<double> _values;
+
+    public:
+        GaussTable(double sigma, double limit);
+
+        [[nodiscard]] double operator()(double x) const {
+            if (!(std::abs(x) < _limit)) {
+                return gauss(x, _sigma);
+            }
+            const double position = (x + _limit) * _inverse_step;
+            const auto index = std::min(static_cast<size_t>(position), _values.size() - 2);
+            const double fraction = position - static_cast<double>(index);
+            return _values[index] + fraction * (_values[index + 1] - _values[index]);
+        }
+    };
+
+    /**
+     * Weight of the vertical angle of an observed point, gauss(vertical_angle / vertical_spread * 2, sigma),
+     * tabulated over +-vertical_angle_limit.
+     */
+    class VerticalGaussKernel {
+    private:
+        double _angle_to_x;
+        GaussTable _table;
+
+    public:
+        VerticalGaussKernel(double vertical_spread, double sigma, double vertical_angle_limit);
+
+        [[nodiscard]] double operator()(const observed_point& point) const {
+            return _table(point.vertical_angle * _angle_to_x);
+        }
+    };
+
+    /**
+     * Tabulated rcs_gaussian. The distribution is separable, so a single table over [-1, 1] is
+     * evaluated once per axis instead of sampling a 2D grid.
+     */
+    class EllipticGaussKernel {
+    private:
+        double _inverse_x_scale;
+        double _inverse_y_scale;
+        double _factor;
+        GaussTable _table;
+
+    public:
+        explicit EllipticGaussKernel(const gauss_options& options);
+
+        [[nodiscard]] double operator()(const observed_point& point) const {
+            const double x = point.horizontal_angle * _inverse_x_scale;
+            const double y = point.vertical_angle * _inverse_y_scale;
+            if (x * x + y * y > 1) {
+                return 0;
+            }
+            return _table(x) * _table(y) * _factor;
+        }
+    };
 }
 
 #endif //RCSOP_COMMON_GAUSS_H
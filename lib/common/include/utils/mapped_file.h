@@ -0,0 +1,85 @@
+#ifndef RCSOP_COMMON_MAPPED_FILE_H
+#define RCSOP_COMMON_MAPPED_FILE_H
+
+#include <cstring>
+
+#include "utils/types.h"
+
+namespace rcsop::common::utils::io {
+
+    /**
+     * Read-only memory mapping of a whole file, unmapped on destruction
+     */
+    class MappedFile {
+    private:
+        path _file_path;
+        const char* _data = nullptr;
+        size_t _size = 0;
+
+    public:
+        explicit MappedFile(path file_path);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] const char* data() const;
+
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] path file_path() const;
+    };
+
+    /**
+     * Sequential cursor over a mapped byte range, every read is bounds-checked
+     */
+    class MappedFileReader {
+    private:
+        const MappedFile& _file;
+        const char* _cursor;
+        const char* _end;
+
+        void require(size_t bytes) const;
+
+    public:
+        explicit MappedFileReader(const MappedFile& file);
+
+        template<typename T>
+        requires std::is_trivially_copyable_v<T>
+        [[nodiscard]] T read() {
+            require(sizeof(T));
+            T value;
+            std::memcpy(&value, _cursor, sizeof(T));
+            _cursor += sizeof(T);
+            return value;
+        }
+
+        template<typename T, size_t Count>
+        requires std::is_trivially_copyable_v<T>
+        void read_into(T (& values)[Count]) {
+            require(sizeof(T) * Count);
+            std::memcpy(values, _cursor, sizeof(T) * Count);
+            _cursor += sizeof(T) * Count;
+        }
+
+        [[nodiscard]] string read_null_terminated();
+
+        [[nodiscard]] string read_line();
+
+        void skip(size_t bytes);
+
+        /**
+         * Skips count elements of element_size bytes, with count read from the file. Checked against the
+         * remaining bytes before multiplying, so a corrupt count can't wrap around.
+         */
+        void skip_elements(uint64_t count, size_t element_size);
+
+        [[nodiscard]] const char* current() const;
+
+        [[nodiscard]] size_t remaining() const;
+    };
+}
+
+#endif //RCSOP_COMMON_MAPPED_FILE_H
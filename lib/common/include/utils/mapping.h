@@ -10,9 +10,7 @@
 #include <ranges>
 
 #include "utils/logging.h"
-
-constexpr auto PARALLEL = std::execution::par;
-constexpr auto PARALLEL_VECTORIZED = std::execution::par_unseq;
+#include "utils/executor.h"
 
 constexpr bool DEFAULT_PARALLEL_ENABLED = true;
 constexpr bool DEFAULT_VECTORIZED_ENABLED = true;
@@ -46,11 +44,7 @@ namespace rcsop::common::utils {
         if constexpr (std::is_default_constructible<Target>::value) {
             result.resize(source.size());
             if constexpr (Parallel) {
-                if constexpr (Vectorized) {
-                    std::transform(PARALLEL_VECTORIZED, source.cbegin(), source.cend(), result.begin(), mapper);
-                } else {
-                    std::transform(PARALLEL, source.cbegin(), source.cend(), result.begin(), mapper);
-                }
+                parallel::transform<Vectorized>(source.cbegin(), source.cend(), result.begin(), mapper);
             } else {
                 std::transform(source.cbegin(), source.cend(), result.begin(), mapper);
             }
@@ -65,15 +59,8 @@ namespace rcsop::common::utils {
                 const std::lock_guard<std::mutex> lock(vector_lock);
                 result.push_back(mapped_value);
             };
-            if constexpr (Vectorized) {
-                std::for_each(PARALLEL_VECTORIZED,
-                              source.cbegin(), source.cend(),
-                              value_mapper);
-            } else {
-                std::for_each(PARALLEL,
-                              source.cbegin(), source.cend(),
-                              value_mapper);
-            }
+            // the lock must not be taken in an unsequenced loop
+            parallel::for_each<false>(source.cbegin(), source.cend(), value_mapper);
             return result;
         }
 
@@ -94,11 +81,7 @@ namespace rcsop::common::utils {
         result->resize(source.size());
 
         if constexpr (Parallel) {
-            if constexpr (Vectorized) {
-                std::transform(PARALLEL_VECTORIZED, source.cbegin(), source.cend(), result->begin(), mapper);
-            } else {
-                std::transform(PARALLEL, source.cbegin(), source.cend(), result->begin(), mapper);
-            }
+            parallel::transform<Vectorized>(source.cbegin(), source.cend(), result->begin(), mapper);
         } else {
             std::transform(source.cbegin(), source.cend(), result->begin(), mapper);
         }
@@ -128,13 +111,7 @@ namespace rcsop::common::utils {
             return mapper(a) < mapper(b);
         };
         if constexpr (Parallel) {
-            if constexpr (Vectorized) {
-                std::sort(PARALLEL_VECTORIZED,
-                          values.begin(), values.end(), comparator);
-            } else {
-                std::sort(PARALLEL,
-                          values.begin(), values.end(), comparator);
-            }
+            parallel::sort<Vectorized>(values.begin(), values.end(), comparator);
         } else {
             std::sort(std::execution::unseq,
                       values.begin(), values.end(), comparator);
@@ -0,0 +1,76 @@
+#ifndef RCSOP_COMMON_MEMORY_H
+#define RCSOP_COMMON_MEMORY_H
+
+#include <ostream>
+
+#include "utils/types.h"
+
+namespace rcsop::common::utils::memory {
+    struct memory_usage {
+        size_t resident_bytes{};
+        size_t peak_resident_bytes{};
+        size_t allocation_count{};
+        size_t allocated_bytes{};
+    };
+
+    struct memory_stage_record {
+        string name;
+        memory_usage begin;
+        memory_usage end;
+    };
+
+    /**
+     * Current and peak resident set size of the process, plus the allocation counters if the
+     * allocation hook is linked in (see RCSOP_TRACK_ALLOCATIONS), otherwise those stay zero.
+     */
+    [[nodiscard]] auto current_memory_usage() -> memory_usage;
+
+    /**
+     * Called by the replaced global operator new, must not allocate itself.
+     */
+    void record_allocation(size_t bytes) noexcept;
+
+    void mark_allocation_hook_installed() noexcept;
+
+    [[nodiscard]] bool is_allocation_tracking_available();
+
+    /**
+     * RAII measurement of a pipeline stage. Records the memory usage at both ends, so the growth of the
+     * resident set and of its high-water mark can be attributed to the stage. Also emits RSS counters into
+     * the trace if tracing is enabled.
+     */
+    class ScopedMemoryStage {
+    private:
+        string _name;
+        memory_usage _begin;
+
+    public:
+        explicit ScopedMemoryStage(string name);
+
+        ~ScopedMemoryStage();
+
+        ScopedMemoryStage(const ScopedMemoryStage&) = delete;
+
+        ScopedMemoryStage& operator=(const ScopedMemoryStage&) = delete;
+    };
+
+    [[nodiscard]] auto collect_memory_stages() -> vector<memory_stage_record>;
+
+    /**
+     * Returns the stages recorded so far and drops them, for processes that run one job after the other.
+     */
+    [[nodiscard]] auto take_memory_stages() -> vector<memory_stage_record>;
+
+    /**
+     * Writes a table per stage name with the number of runs, the largest RSS growth and peak growth,
+     * the highest RSS seen at the end of the stage and, if available, allocation counts and bytes.
+     */
+    void write_memory_summary(std::ostream& output, const vector<memory_stage_record>& records);
+
+    /**
+     * Summarizes all stages recorded so far.
+     */
+    void write_memory_summary(std::ostream& output);
+}
+
+#endif //RCSOP_COMMON_MEMORY_H
@@ -0,0 +1,30 @@
+#ifndef RCSOP_COMMON_PLY_VERTICES_H
+#define RCSOP_COMMON_PLY_VERTICES_H
+
+#include "utils/types.h"
+#include "utils/points.h"
+#include "utils/mapped_file.h"
+
+namespace rcsop::common::utils::io {
+    using rcsop::common::utils::points::vec3;
+
+    /**
+     * Fixed-size vertex records of a binary PLY file and where the coordinates are placed in them
+     */
+    struct ply_vertex_layout {
+        size_t vertex_count{};
+        size_t stride{};
+        size_t coordinate_offsets[3]{};
+        bool coordinates_double[3]{};
+    };
+
+    /**
+     * Parses the header of a binary little-endian PLY file whose first element are the vertices, the reader is
+     * left at the first vertex. Anything else (ASCII, big-endian, list properties on vertices) yields no layout.
+     */
+    [[nodiscard]] auto parse_vertex_layout(MappedFileReader& reader) -> optional<ply_vertex_layout>;
+
+    [[nodiscard]] auto read_vertex_position(const char* vertex, const ply_vertex_layout& layout) -> vec3;
+}
+
+#endif //RCSOP_COMMON_PLY_VERTICES_H
@@ -9,6 +9,24 @@ namespace rcsop::common::utils::points {
     using vec2 = Eigen::Vector2d;
     using vec3 = Eigen::Vector3d;
 
+    /**
+     * Scalar the large point arrays are stored in. Building with RCSOP_FLOAT_STORAGE shrinks SimplePoint from 40 to
+     * 32 and ScoredPoint from 56 to 48 bytes (the vtable pointer and the id stay), the accessors still hand out
+     * double values and all arithmetic stays in double.
+     */
+#ifdef RCSOP_FLOAT_STORAGE
+    using storage_scalar_t = float;
+#else
+    using storage_scalar_t = double;
+#endif
+    using stored_vec2 = Eigen::Matrix<storage_scalar_t, 2, 1>;
+    using stored_vec3 = Eigen::Matrix<storage_scalar_t, 3, 1>;
+
+    template<typename VectorType>
+    [[nodiscard]] auto to_storage(const VectorType& value) {
+        return value.template cast<storage_scalar_t>().eval();
+    }
+
     struct vec3_spherical {
         double radial{};
         double azimuthal{};
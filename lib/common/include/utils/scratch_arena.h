@@ -0,0 +1,107 @@
+#ifndef RCSOP_COMMON_SCRATCH_ARENA_H
+#define RCSOP_COMMON_SCRATCH_ARENA_H
+
+#include <memory_resource>
+
+#include "utils/types.h"
+
+namespace rcsop::common::utils::memory {
+    template<typename T>
+    using scratch_vector = std::pmr::vector<T>;
+
+    /**
+     * Initial buffer of an arena and the most it keeps between units of work, larger units fall back to
+     * the global allocator for the remainder.
+     */
+    const static size_t SCRATCH_ARENA_INITIAL_SIZE = 1 << 20;
+    const static size_t SCRATCH_ARENA_MAX_RETAINED_SIZE = 1 << 28;
+
+    /**
+     * Monotonic memory for the temporaries of one unit of work, e.g. one observer. Allocations only advance a
+     * pointer, nothing is freed before the arena is reset. The blocks taken from the global allocator during a
+     * unit are merged into the buffer at the reset, so after a few units the arena serves all temporaries
+     * without touching the global allocator. Not thread-safe, every thread uses its own arena.
+     */
+    class ScratchArena {
+    private:
+        class counting_resource : public std::pmr::memory_resource {
+        private:
+            size_t _allocated_bytes = 0;
+
+            void* do_allocate(size_t bytes, size_t alignment) override;
+
+            void do_deallocate(void* memory, size_t bytes, size_t alignment) override;
+
+            [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        public:
+            [[nodiscard]] size_t allocated_bytes() const;
+
+            void clear();
+        };
+
+        counting_resource _upstream;
+        unique_ptr<std::byte[]> _buffer;
+        size_t _buffer_size;
+        optional<std::pmr::monotonic_buffer_resource> _resource;
+        size_t _scope_depth = 0;
+
+        friend class ScopedScratch;
+
+    public:
+        explicit ScratchArena(size_t initial_size = SCRATCH_ARENA_INITIAL_SIZE);
+
+        ScratchArena(const ScratchArena&) = delete;
+
+        ScratchArena& operator=(const ScratchArena&) = delete;
+
+        [[nodiscard]] auto resource() -> std::pmr::memory_resource*;
+
+        /**
+         * Releases all allocations at once, containers still using the arena must be gone.
+         */
+        void reset();
+
+        [[nodiscard]] auto capacity() const -> size_t;
+
+        [[nodiscard]] static auto for_current_thread() -> ScratchArena&;
+    };
+
+    /**
+     * Scratch memory of the calling thread for the lifetime of the scope. The arena is reset when the outermost
+     * scope of the thread ends, so containers allocated from it must not outlive the scope. With the arenas
+     * disabled the global allocator is used instead.
+     */
+    class ScopedScratch {
+    private:
+        ScratchArena* _arena = nullptr;
+
+    public:
+        ScopedScratch();
+
+        ~ScopedScratch();
+
+        ScopedScratch(const ScopedScratch&) = delete;
+
+        ScopedScratch& operator=(const ScopedScratch&) = delete;
+
+        [[nodiscard]] auto resource() const -> std::pmr::memory_resource*;
+
+        template<typename T>
+        [[nodiscard]] auto make_vector(size_t size = 0) const -> scratch_vector<T> {
+            scratch_vector<T> values(resource());
+            values.resize(size);
+            return values;
+        }
+    };
+
+    /**
+     * Switches the scratch arenas of all threads on or off, only meant for comparisons, e.g. in benchmarks.
+     * Must not be changed while a ScopedScratch is alive.
+     */
+    void set_scratch_arenas_enabled(bool enabled);
+
+    [[nodiscard]] bool scratch_arenas_enabled();
+}
+
+#endif //RCSOP_COMMON_SCRATCH_ARENA_H
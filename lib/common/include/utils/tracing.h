@@ -0,0 +1,86 @@
+#ifndef RCSOP_COMMON_TRACING_H
+#define RCSOP_COMMON_TRACING_H
+
+#include <chrono>
+#include <concepts>
+#include <ostream>
+
+#include "utils/types.h"
+
+namespace rcsop::common::utils::tracing {
+    using trace_clock = std::chrono::steady_clock;
+
+    struct trace_event {
+        const char* name;
+        string detail;
+        trace_clock::time_point start;
+        trace_clock::duration duration;
+        uint32_t thread_id;
+        uint32_t depth;
+    };
+
+    struct trace_counter {
+        const char* name;
+        trace_clock::time_point time;
+        vector<pair<string, double>> values;
+    };
+
+    /**
+     * Starts recording spans, until then every ScopedSpan is a no-op apart from one atomic load.
+     */
+    void enable_tracing();
+
+    [[nodiscard]] bool is_tracing_enabled();
+
+    /**
+     * RAII span, recorded on destruction into a buffer owned by the current thread.
+     * Spans opened inside other spans on the same thread are nested below them.
+     * The name has to outlive the trace, i.e. it should be a string literal.
+     */
+    class ScopedSpan {
+    private:
+        const char* _name;
+        string _detail;
+        trace_clock::time_point _start;
+        bool _active;
+
+    public:
+        explicit ScopedSpan(const char* name, string detail = {});
+
+        /**
+         * Builds the detail only if tracing is enabled, for spans in hot paths.
+         */
+        template<std::invocable Detail>
+        requires std::convertible_to<std::invoke_result_t<Detail>, string>
+        ScopedSpan(const char* name, Detail&& detail)
+                : ScopedSpan(name, is_tracing_enabled() ? string(detail()) : string{}) {}
+
+        ~ScopedSpan();
+
+        ScopedSpan(const ScopedSpan&) = delete;
+
+        ScopedSpan& operator=(const ScopedSpan&) = delete;
+    };
+
+    /**
+     * Records a sample of one or more named values, shown as a counter track in the trace.
+     */
+    void record_counter(const char* name, vector<pair<string, double>> values);
+
+    /**
+     * All spans recorded so far on any thread, ordered by their start time.
+     */
+    [[nodiscard]] auto collect_events() -> vector<trace_event>;
+
+    /**
+     * Writes all recorded spans in the Chrome trace event format (chrome://tracing, Perfetto).
+     */
+    void write_chrome_trace(const path& trace_file);
+
+    /**
+     * Writes a table with call count, total, mean and maximum duration per span name.
+     */
+    void write_summary(std::ostream& output);
+}
+
+#endif //RCSOP_COMMON_TRACING_H
@@ -4,7 +4,7 @@
 
 namespace rcsop::common {
 
-    auto BasePointCloud::model_path() -> path {
+    auto BasePointCloud::model_path() const -> path {
         return this->_model_path;
     }
 
@@ -2,10 +2,10 @@
 
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 
 namespace rcsop::common::utils::time {
     using std::clog;
-    using std::endl;
     using std::fixed;
     using std::setw;
     using std::setprecision;
@@ -21,8 +21,12 @@ namespace rcsop::common::utils::time {
     timer_seconds log_and_start_next(timer_seconds last_timer,
                                      const string& message) {
         auto last_duration = get_time_seconds(last_timer);
-        clog << "[ " << fixed << setw(7) << setprecision(3)
-             << last_duration << "s ]: " << message << endl;
+
+        // one write per line keeps lines from parallel callers intact, and no flush per line
+        std::stringstream line;
+        line << "[ " << fixed << setw(7) << setprecision(3)
+             << last_duration << "s ]: " << message << '\n';
+        clog << line.str();
 
         return start_time();
     }
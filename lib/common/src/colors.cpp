@@ -379,14 +379,58 @@ namespace rcsop::common::coloring {
                                LINEAR_MAP_ALPHA * factor);
     }
 
+    ColorLookupTable::ColorLookupTable(const local_colormap_func& color_map,
+                                       double min_value,
+                                       double max_value,
+                                       size_t table_size)
+            : _min_value(min_value),
+              _max_value(max_value),
+              _value_to_index(0) {
+        if (table_size < 2) {
+            throw invalid_argument("A color lookup table needs at least two entries");
+        }
+        const auto last_index = static_cast<double>(table_size - 1);
+        const auto value_range = max_value - min_value;
+        if (value_range > 0) {
+            _value_to_index = last_index / value_range;
+        }
+
+        auto colors = make_shared<vector<color_vec>>(table_size);
+        for (size_t index = 0; index < table_size; index++) {
+            const auto value = min_value + value_range * static_cast<double>(index) / last_index;
+            (*colors)[index] = color_map(value, min_value, max_value);
+        }
+        _colors = colors;
+    }
+
+    void ColorLookupTable::map_values(std::span<const double> values, std::span<color_vec> colors) const {
+        if (values.size() != colors.size()) {
+            throw invalid_argument("Every value to map needs exactly one color.");
+        }
+        std::transform(std::execution::unseq, values.begin(), values.end(), colors.begin(),
+                       [this](const double value) {
+                           return (*_colors)[index_of(value)];
+                       });
+    }
+
+    auto ColorLookupTable::map_values(const vector<double>& values) const -> vector<color_vec> {
+        vector<color_vec> colors(values.size());
+        map_values(std::span<const double>(values), std::span<color_vec>(colors));
+        return colors;
+    }
+
+    auto ColorLookupTable::range() const -> ScoreRange {
+        return {
+                .min = _min_value,
+                .max = _max_value,
+        };
+    }
+
     global_colormap_func construct_color_map_function(
             const local_colormap_func& color_map,
             double min_value,
             double max_value) {
-
-        return [min_value, max_value, color_map](double value) {
-            return color_map(value, min_value, max_value);
-        };
+        return {color_map, min_value, max_value};
     }
 
     global_colormap_func construct_color_map_function(
@@ -0,0 +1,41 @@
+#include "utils/content_hash.h"
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "utils/mapped_file.h"
+
+namespace rcsop::common::utils::io {
+    const static content_hash_t FNV_PRIME = 1099511628211ULL;
+
+    content_hash_t hash_bytes(const char* data, size_t size, content_hash_t seed) {
+        content_hash_t hash = seed;
+        size_t offset = 0;
+        for (; offset + sizeof(std::uint64_t) <= size; offset += sizeof(std::uint64_t)) {
+            std::uint64_t word;
+            std::memcpy(&word, data + offset, sizeof(word));
+            hash = (hash ^ word) * FNV_PRIME;
+        }
+        for (; offset < size; offset++) {
+            hash = (hash ^ static_cast<unsigned char>(data[offset])) * FNV_PRIME;
+        }
+        // the length keeps inputs apart that only differ by trailing zero bytes
+        return (hash ^ static_cast<content_hash_t>(size)) * FNV_PRIME;
+    }
+
+    content_hash_t hash_string(const string& value, content_hash_t seed) {
+        return hash_bytes(value.data(), value.size(), seed);
+    }
+
+    content_hash_t hash_file(const path& file_path) {
+        const MappedFile file(file_path);
+        return hash_bytes(file.data(), file.size());
+    }
+
+    string to_hex(content_hash_t hash) {
+        std::ostringstream stream;
+        stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return stream.str();
+    }
+}
@@ -1,23 +1,59 @@
 #include "dense_cloud.h"
 
+#include "utils/mapping.h"
+#include "point_source.h"
+
 namespace rcsop::common {
     namespace PMP = CGAL::Polygon_mesh_processing;
 
+    using rcsop::common::utils::filter_vec;
+
     DenseCloud::DenseCloud(const path& ply_file_path) : BasePointCloud(ply_file_path) {
+        if (read_vertices_only()) {
+            return;
+        }
+        const auto& full_mesh = mesh();
+        for (VertexDescriptor vertex_index: full_mesh.vertices()) {
+            const Point vertex = full_mesh.point(vertex_index);
+            _vertices.emplace_back(vertex_index, vec3(vertex.x(), vertex.y(), vertex.z()));
+        }
+    }
+
+    bool DenseCloud::read_vertices_only() {
+        const auto vertices = PlyVertexSource::open(this->model_path(), 0);
+        if (vertices == nullptr) {
+            return false;
+        }
+        if (vertices->chunk_count() > 0) {
+            std::ignore = vertices->read_chunk(0, _vertices);
+        }
+        return true;
+    }
+
+    void DenseCloud::load_mesh() const {
         _mesh = make_unique<SurfaceMesh>();
         CGAL::IO::read_polygon_mesh(this->model_path().string(), *_mesh);
 
         PMP::triangulate_faces(*_mesh);
 
-        if (CGAL::is_closed(*_mesh)) {
+        _mesh_closed = CGAL::is_closed(*_mesh);
+        if (_mesh_closed) {
             _inside = make_unique<InsideTriangleMesh>(*_mesh);
         } else {
             _inside = nullptr;
         }
     }
 
+    SurfaceMesh& DenseCloud::mesh() const {
+        std::call_once(_mesh_loaded, [this]() {
+            load_mesh();
+        });
+        return *_mesh;
+    }
+
     bool DenseCloud::is_inside(const vec3& point) const {
-        if (!CGAL::is_closed(*_mesh)) {
+        mesh();
+        if (!_mesh_closed) {
             throw std::runtime_error("Dense mesh not closed, hence cannot determine whether any point is inside.");
         }
         assert(_inside != nullptr);
@@ -28,21 +64,20 @@ namespace rcsop::common {
     }
 
     shared_ptr<vector<SimplePoint>> DenseCloud::get_points() const {
-        auto result = make_shared<vector<SimplePoint>>();
-        for (VertexDescriptor vertex_index: this->_mesh->vertices()) {
-            const Point vertex = this->_mesh->point(vertex_index);
-            result->emplace_back(vertex_index, vec3(vertex.x(), vertex.y(), vertex.z()));
-        }
-        return result;
+        return make_shared<vector<SimplePoint>>(_vertices);
     }
 
     void DenseCloud::filter_points(const function<bool(const vec3&)>& predicate_to_keep) {
-        for (VertexDescriptor vertex_index: this->_mesh->vertices()) {
-            const Point vertex = this->_mesh->point(vertex_index);
+        auto& full_mesh = mesh();
+        for (VertexDescriptor vertex_index: full_mesh.vertices()) {
+            const Point vertex = full_mesh.point(vertex_index);
             if (!predicate_to_keep(vec3(vertex.x(), vertex.y(), vertex.z()))) {
-                this->_mesh->remove_vertex(vertex_index);
+                full_mesh.remove_vertex(vertex_index);
             }
         }
+        _vertices = filter_vec<SimplePoint>(_vertices, [&predicate_to_keep](const SimplePoint& point) {
+            return predicate_to_keep(point.position());
+        });
     }
 
     void DenseCloud::add_point(const IdPoint* point,
@@ -57,7 +92,7 @@ namespace rcsop::common {
     }
 
     size_t DenseCloud::point_count() const {
-        return this->_mesh->number_of_vertices();
+        return _vertices.size();
     }
 
     void DenseCloud::purge_cameras(camera_id_t camera_to_keep) {
@@ -67,4 +102,4 @@ namespace rcsop::common {
     bool DenseCloud::is_available_at(const path& file_path) {
         return std::filesystem::is_regular_file(file_path);
     }
-}
\ No newline at end of file
+}
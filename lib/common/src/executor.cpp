@@ -0,0 +1,75 @@
+#include "utils/executor.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <tbb/blocked_range.h>
+#include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+
+namespace rcsop::common::utils::parallel {
+    static std::atomic<size_t> configured_threads{0};
+    static std::atomic<nesting_policy> configured_nesting{nesting_policy::INNER_LOOPS};
+    static std::mutex thread_limit_lock;
+    static unique_ptr<tbb::global_control> thread_limit;
+    static thread_local size_t outer_item_depth = 0;
+
+    void configure_executor(const executor_options& options) {
+        const std::lock_guard guard(thread_limit_lock);
+        configured_threads = options.threads;
+        configured_nesting = options.nesting;
+        // the standard parallel algorithms run on TBB, which honours the limit for all of its threads
+        thread_limit.reset();
+        if (options.threads > 0) {
+            thread_limit = make_unique<tbb::global_control>(tbb::global_control::max_allowed_parallelism,
+                                                            options.threads);
+        }
+    }
+
+    auto executor_configuration() -> executor_options {
+        return {
+                .threads = configured_threads,
+                .nesting = configured_nesting,
+        };
+    }
+
+    auto thread_count() -> size_t {
+        const size_t threads = configured_threads;
+        if (threads > 0) {
+            return threads;
+        }
+        return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    bool run_parallel() {
+        return outer_item_depth == 0 && thread_count() > 1;
+    }
+
+    void run_tasks(size_t task_count, const function<void(size_t)>& task) {
+        if (!run_parallel()) {
+            for (size_t index = 0; index < task_count; index++) {
+                task(index);
+            }
+            return;
+        }
+        // a grain of one task, the simple partitioner never groups tasks into larger ranges
+        tbb::parallel_for(
+                tbb::blocked_range<size_t>(0, task_count, 1),
+                [&task](const tbb::blocked_range<size_t>& range) {
+                    const ScopedOuterItem outer_item;
+                    for (size_t index = range.begin(); index < range.end(); index++) {
+                        task(index);
+                    }
+                },
+                tbb::simple_partitioner());
+    }
+
+    ScopedOuterItem::ScopedOuterItem() {
+        outer_item_depth++;
+    }
+
+    ScopedOuterItem::~ScopedOuterItem() {
+        outer_item_depth--;
+    }
+}
@@ -16,28 +16,12 @@ namespace rcsop::common::utils::gauss {
         return 1 / integral;
     }
 
-    observed_factor_func rcs_gaussian_vertical(double vertical_spread, double sigma) {
-        return [vertical_spread, sigma](const observed_point& point) {
-            return gauss(point.vertical_angle / vertical_spread * 2, sigma, 0.);
-        };
-    }
-
-/* TODO
     static double raw_gauss(const double& x,
                             const double& y,
                             const double& sigma) {
         return (M_SQRT1_2 * M_2_SQRTPI / (2 * sigma)) * exp(-0.5 * (x * x + y * y) / (sigma * sigma));
     }
 
-    static double calc_gauss(const observed_point& point,
-                             const gauss_options& distribution_options) {
-        return raw_gauss(point.horizontal_angle / distribution_options.x_scale,
-                         point.vertical_angle / distribution_options.y_scale,
-                         distribution_options.sigma)
-               * distribution_options.integral_factor
-               / (distribution_options.x_scale * distribution_options.y_scale);
-    }
-
     static bool is_inside_ellipse(const observed_point& point, const gauss_options& options) {
         auto x = point.horizontal_angle / options.x_scale;
         auto y = point.vertical_angle / options.y_scale;
@@ -50,7 +34,42 @@ namespace rcsop::common::utils::gauss {
             return 0;
         }
 
-        return calc_gauss(point, options) / point.distance_in_world;
+        return raw_gauss(point.horizontal_angle / options.x_scale,
+                         point.vertical_angle / options.y_scale,
+                         options.sigma)
+               * options.integral_factor
+               / (options.x_scale * options.y_scale);
     }
-*/
+
+    GaussTable::GaussTable(double sigma, double limit)
+            : _sigma(sigma),
+              _limit(std::max(limit, 0.)),
+              _inverse_step(0) {
+        if (sigma <= 0) {
+            throw invalid_argument("Standard deviation must be positive");
+        }
+        if (_limit == 0) {
+            return;
+        }
+        const auto intervals = static_cast<size_t>(std::min(
+                std::ceil(2 * _limit / sigma * GAUSS_TABLE_SAMPLES_PER_SIGMA),
+                static_cast<double>(GAUSS_TABLE_MAX_SAMPLES - 1)));
+        _inverse_step = static_cast<double>(intervals) / (2 * _limit);
+        _values.resize(intervals + 1);
+        for (size_t i = 0; i <= intervals; i++) {
+            _values[i] = gauss(static_cast<double>(i) / _inverse_step - _limit, sigma);
+        }
+    }
+
+    VerticalGaussKernel::VerticalGaussKernel(double vertical_spread, double sigma, double vertical_angle_limit)
+            : _angle_to_x(2 / vertical_spread),
+              _table(sigma, vertical_angle_limit * 2 / vertical_spread) {}
+
+    EllipticGaussKernel::EllipticGaussKernel(const gauss_options& options)
+            : _inverse_x_scale(1 / options.x_scale),
+              _inverse_y_scale(1 / options.y_scale),
+              // raw_gauss(x, y) = gauss(x) * gauss(y) * sigma * sqrt(2 pi)
+              _factor(options.sigma * M_SQRT2 * sqrt(M_PI) * options.integral_factor
+                      / (options.x_scale * options.y_scale)),
+              _table(options.sigma, 1.) {}
 }
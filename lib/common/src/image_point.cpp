@@ -1,12 +1,14 @@
 #include "image_point.h"
 
 namespace rcsop::common {
+    using rcsop::common::utils::points::to_storage;
+
     ImagePoint::ImagePoint(vec2 coordinates,
                            double distance,
                            double score)
-            : _coordinates(std::move(coordinates)),
-              _distance(distance),
-              _score(score) {}
+            : _coordinates(to_storage(coordinates)),
+              _distance(static_cast<storage_scalar_t>(distance)),
+              _score(static_cast<storage_scalar_t>(score)) {}
 
     double ImagePoint::score() const {
         return _score;
@@ -17,6 +19,6 @@ namespace rcsop::common {
     }
 
     vec2 ImagePoint::coordinates() const {
-        return _coordinates;
+        return _coordinates.cast<double>();
     }
 }
@@ -0,0 +1,108 @@
+#include "utils/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rcsop::common::utils::io {
+
+    MappedFile::MappedFile(path file_path) : _file_path(std::move(file_path)) {
+        const int file_descriptor = open(_file_path.c_str(), O_RDONLY);
+        if (file_descriptor < 0) {
+            throw runtime_error("Could not open " + _file_path.string());
+        }
+        struct stat file_stats{};
+        if (fstat(file_descriptor, &file_stats) != 0) {
+            close(file_descriptor);
+            throw runtime_error("Could not determine size of " + _file_path.string());
+        }
+        _size = static_cast<size_t>(file_stats.st_size);
+        if (_size == 0) {
+            close(file_descriptor);
+            return;
+        }
+
+        void* mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        close(file_descriptor);
+        if (mapping == MAP_FAILED) {
+            throw runtime_error("Could not map " + _file_path.string() + " into memory");
+        }
+        madvise(mapping, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const char*>(mapping);
+    }
+
+    MappedFile::~MappedFile() {
+        if (_data != nullptr) {
+            munmap(const_cast<char*>(_data), _size);
+        }
+    }
+
+    const char* MappedFile::data() const {
+        return _data;
+    }
+
+    size_t MappedFile::size() const {
+        return _size;
+    }
+
+    path MappedFile::file_path() const {
+        return _file_path;
+    }
+
+    MappedFileReader::MappedFileReader(const MappedFile& file)
+            : _file(file),
+              _cursor(file.data()),
+              _end(file.data() + file.size()) {}
+
+    void MappedFileReader::require(size_t bytes) const {
+        if (remaining() < bytes) {
+            throw runtime_error("Unexpected end of file in " + _file.file_path().string());
+        }
+    }
+
+    string MappedFileReader::read_null_terminated() {
+        require(1);
+        const auto* terminator = static_cast<const char*>(std::memchr(_cursor, '\0', remaining()));
+        if (terminator == nullptr) {
+            throw runtime_error("Unterminated string in " + _file.file_path().string());
+        }
+        string value(_cursor, terminator);
+        _cursor = terminator + 1;
+        return value;
+    }
+
+    string MappedFileReader::read_line() {
+        require(1);
+        const auto* line_end = static_cast<const char*>(std::memchr(_cursor, '\n', remaining()));
+        if (line_end == nullptr) {
+            throw runtime_error("Unterminated line in " + _file.file_path().string());
+        }
+        string value(_cursor, line_end);
+        if (!value.empty() && value.back() == '\r') {
+            value.pop_back();
+        }
+        _cursor = line_end + 1;
+        return value;
+    }
+
+    void MappedFileReader::skip(size_t bytes) {
+        require(bytes);
+        _cursor += bytes;
+    }
+
+    void MappedFileReader::skip_elements(uint64_t count, size_t element_size) {
+        if (element_size > 0 && count > remaining() / element_size) {
+            throw runtime_error("Unexpected end of file in " + _file.file_path().string());
+        }
+        skip(static_cast<size_t>(count) * element_size);
+    }
+
+    const char* MappedFileReader::current() const {
+        return _cursor;
+    }
+
+    size_t MappedFileReader::remaining() const {
+        return static_cast<size_t>(_end - _cursor);
+    }
+}
@@ -0,0 +1,179 @@
+#include "utils/memory.h"
+
+#include <atomic>
+#include <mutex>
+#include <fstream>
+#include <iomanip>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "utils/tracing.h"
+
+namespace rcsop::common::utils::memory {
+    using rcsop::common::utils::tracing::record_counter;
+
+    const static double BYTES_PER_MEGABYTE = 1024. * 1024.;
+
+    static std::atomic<bool> allocation_hook_installed{false};
+    static std::atomic<size_t> allocation_count{0};
+    static std::atomic<size_t> allocated_bytes{0};
+
+    static std::mutex stage_lock;
+    static vector<memory_stage_record> stage_records;
+
+    void record_allocation(size_t bytes) noexcept {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void mark_allocation_hook_installed() noexcept {
+        allocation_hook_installed.store(true, std::memory_order_relaxed);
+    }
+
+    bool is_allocation_tracking_available() {
+        return allocation_hook_installed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Second field of /proc/self/statm, in pages.
+     */
+    static auto read_resident_bytes() -> size_t {
+        std::ifstream statm("/proc/self/statm");
+        size_t total_pages = 0;
+        size_t resident_pages = 0;
+        if (!(statm >> total_pages >> resident_pages)) {
+            return 0;
+        }
+        return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    static auto read_peak_resident_bytes() -> size_t {
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+        // ru_maxrss is given in kilobytes on Linux
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;
+    }
+
+    auto current_memory_usage() -> memory_usage {
+        return {
+                .resident_bytes = read_resident_bytes(),
+                .peak_resident_bytes = read_peak_resident_bytes(),
+                .allocation_count = allocation_count.load(std::memory_order_relaxed),
+                .allocated_bytes = allocated_bytes.load(std::memory_order_relaxed),
+        };
+    }
+
+    static void trace_memory_usage(const memory_usage& usage) {
+        vector<pair<string, double>> values{
+                {"rss_mb",      static_cast<double>(usage.resident_bytes) / BYTES_PER_MEGABYTE},
+                {"peak_rss_mb", static_cast<double>(usage.peak_resident_bytes) / BYTES_PER_MEGABYTE},
+        };
+        if (is_allocation_tracking_available()) {
+            values.emplace_back("allocated_mb", static_cast<double>(usage.allocated_bytes) / BYTES_PER_MEGABYTE);
+        }
+        record_counter("memory", std::move(values));
+    }
+
+    ScopedMemoryStage::ScopedMemoryStage(string name)
+            : _name(std::move(name)),
+              _begin(current_memory_usage()) {
+        trace_memory_usage(_begin);
+    }
+
+    ScopedMemoryStage::~ScopedMemoryStage() {
+        const auto end = current_memory_usage();
+        trace_memory_usage(end);
+
+        std::lock_guard guard(stage_lock);
+        stage_records.push_back(memory_stage_record{
+                .name = std::move(_name),
+                .begin = _begin,
+                .end = end,
+        });
+    }
+
+    auto collect_memory_stages() -> vector<memory_stage_record> {
+        std::lock_guard guard(stage_lock);
+        return stage_records;
+    }
+
+    auto take_memory_stages() -> vector<memory_stage_record> {
+        vector<memory_stage_record> records;
+        std::lock_guard guard(stage_lock);
+        records.swap(stage_records);
+        return records;
+    }
+
+    struct stage_statistics {
+        size_t runs{};
+        long long max_resident_growth{};
+        size_t max_peak_growth{};
+        size_t max_resident_at_end{};
+        size_t allocations{};
+        size_t allocated_bytes{};
+    };
+
+    static auto to_megabytes(long long bytes) -> double {
+        return static_cast<double>(bytes) / BYTES_PER_MEGABYTE;
+    }
+
+    void write_memory_summary(std::ostream& output, const vector<memory_stage_record>& records) {
+        // keeps the order in which the stages were first completed
+        vector<string> stage_names;
+        map<string, stage_statistics> statistics_by_name;
+        for (const auto& record: records) {
+            if (!statistics_by_name.contains(record.name)) {
+                stage_names.push_back(record.name);
+            }
+            auto& statistics = statistics_by_name[record.name];
+            const auto resident_growth = static_cast<long long>(record.end.resident_bytes)
+                                         - static_cast<long long>(record.begin.resident_bytes);
+            statistics.runs++;
+            statistics.max_resident_growth = std::max(statistics.max_resident_growth, resident_growth);
+            statistics.max_peak_growth = std::max(statistics.max_peak_growth,
+                                                  record.end.peak_resident_bytes - record.begin.peak_resident_bytes);
+            statistics.max_resident_at_end = std::max(statistics.max_resident_at_end, record.end.resident_bytes);
+            statistics.allocations += record.end.allocation_count - record.begin.allocation_count;
+            statistics.allocated_bytes += record.end.allocated_bytes - record.begin.allocated_bytes;
+        }
+
+        const bool with_allocations = is_allocation_tracking_available();
+        const auto total = current_memory_usage();
+        output << "Memory summary: peak RSS " << std::fixed << std::setprecision(1)
+               << to_megabytes(static_cast<long long>(total.peak_resident_bytes)) << " MB";
+        if (with_allocations) {
+            output << ", " << total.allocation_count << " allocations with "
+                   << to_megabytes(static_cast<long long>(total.allocated_bytes)) << " MB in total";
+        }
+        output << "\n";
+
+        output << std::left << std::setw(28) << "stage" << std::right << std::setw(8) << "runs"
+               << std::setw(16) << "max RSS +[MB]" << std::setw(16) << "max peak +[MB]"
+               << std::setw(16) << "max RSS [MB]";
+        if (with_allocations) {
+            output << std::setw(14) << "allocations" << std::setw(16) << "allocated [MB]";
+        }
+        output << "\n";
+
+        for (const auto& name: stage_names) {
+            const auto& statistics = statistics_by_name.at(name);
+            output << std::left << std::setw(28) << name << std::right << std::setw(8) << statistics.runs
+                   << std::fixed << std::setprecision(1)
+                   << std::setw(16) << to_megabytes(statistics.max_resident_growth)
+                   << std::setw(16) << to_megabytes(static_cast<long long>(statistics.max_peak_growth))
+                   << std::setw(16) << to_megabytes(static_cast<long long>(statistics.max_resident_at_end));
+            if (with_allocations) {
+                output << std::setw(14) << statistics.allocations
+                       << std::setw(16) << to_megabytes(static_cast<long long>(statistics.allocated_bytes));
+            }
+            output << "\n";
+        }
+        output.flush();
+    }
+
+    void write_memory_summary(std::ostream& output) {
+        write_memory_summary(output, collect_memory_stages());
+    }
+}
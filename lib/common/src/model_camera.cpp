@@ -4,9 +4,12 @@
 #include "utils/mapping.h"
 
 namespace rcsop::common {
+    namespace parallel = rcsop::common::utils::parallel;
+
     using rcsop::common::utils::map_vec;
 
     using rcsop::common::utils::sparse::Image;
+    using rcsop::common::utils::sparse::Camera;
     using rcsop::common::utils::sparse::Reconstruction;
     using rcsop::common::utils::points::vec2;
     using rcsop::common::utils::points::vec3;
@@ -16,6 +19,10 @@ namespace rcsop::common {
         this->_model_camera = model.Camera(image.CameraId());
     }
 
+    ModelCamera::ModelCamera(Image image,
+                             Camera camera) : _model_camera(std::move(camera)),
+                                              _model_image(std::move(image)) {}
+
     vec3 ModelCamera::transform_to_world(const vec3& local_coordinates) const {
         return _model_image.InverseProjectionMatrix() * local_coordinates.homogeneous();
     }
@@ -48,20 +55,23 @@ namespace rcsop::common {
         return _model_image.Name();
     }
 
-    vector<ImagePoint> ModelCamera::project_to_image(
-            const vector<ScoredPoint>& points) const {
+    void ModelCamera::project_to_image(std::span<const ScoredPoint> points,
+                                       std::span<ImagePoint> image_points) const {
+        if (points.size() != image_points.size()) {
+            throw invalid_argument("Every point to project needs exactly one image point.");
+        }
         auto camera_position = this->position();
         auto image_projection_matrix = _model_image.ProjectionMatrix();
 
-        return utils::map_vec<ScoredPoint, ImagePoint>(points, [camera_position, image_projection_matrix]
-                (const ScoredPoint& point) -> ImagePoint {
-            auto position =  point.position();
-            auto score = point.score_to_dB();
-            auto position_normalized = (image_projection_matrix * position.homogeneous()).hnormalized();
-            auto distance_to_camera = (camera_position - position).norm();
-            auto projected_point = ImagePoint(position_normalized, distance_to_camera, score);
-            return projected_point;
-        });
+        parallel::transform(
+                points.begin(), points.end(), image_points.begin(),
+                [camera_position, image_projection_matrix](const ScoredPoint& point) -> ImagePoint {
+                    auto position = point.position();
+                    auto score = point.score_to_dB();
+                    auto position_normalized = (image_projection_matrix * position.homogeneous()).hnormalized();
+                    auto distance_to_camera = (camera_position - position).norm();
+                    return ImagePoint(position_normalized, distance_to_camera, score);
+                });
     }
 
     string ModelCamera::get_last_name_segment() const {
@@ -10,6 +10,7 @@
 namespace rcsop::common {
     using rcsop::common::utils::map_vec_shared;
     using rcsop::common::utils::filter_vec;
+    using rcsop::common::utils::points::to_storage;
 
     const static double PI_RADIANS = 180.;
     const static double HALF_PI_RADIANS = PI_RADIANS / 2;
@@ -84,12 +85,19 @@ namespace rcsop::common {
         return {x, y, z};
     }
 
-    auto Observer::observe_point(const SimplePoint& point) const -> observed_point {
+    auto Observer::to_camera_local(const SimplePoint& point) const -> camera_local_point {
         const auto world_point = point.position();
-        const auto distance = _camera->distance_to_camera(world_point);
+        return {
+                .position = to_storage(world_point),
+                .id = point.id(),
+                .local_position = to_storage(_camera->map_to_observer_local(world_point, get_height_offset())),
+                .distance_in_world = static_cast<storage_scalar_t>(_camera->distance_to_camera(world_point)),
+        };
+    }
 
-        const auto translated_point = _camera->map_to_observer_local(world_point, get_height_offset());
-        const auto local_point = undo_data_point_translation(translated_point);
+    auto Observer::observe_camera_local(const camera_local_point& point) const -> observed_point {
+        const double distance = point.distance_in_world;
+        const auto local_point = undo_data_point_translation(point.local_position.cast<double>());
 
         const auto& [_, azimuthal, polar] = cartesian_to_spherical(local_point);
 
@@ -103,14 +111,18 @@ namespace rcsop::common {
         }
 
         return {
-                .position = point.position(),
-                .id = point.id(),
-                .distance_in_world = distance / this->_units_per_centimeter,
-                .vertical_angle = vertical_angle,
-                .horizontal_angle = horizontal_angle,
+                .position = point.position,
+                .id = point.id,
+                .distance_in_world = static_cast<storage_scalar_t>(distance / this->_units_per_centimeter),
+                .vertical_angle = static_cast<storage_scalar_t>(vertical_angle),
+                .horizontal_angle = static_cast<storage_scalar_t>(horizontal_angle),
         };
     }
 
+    auto Observer::observe_point(const SimplePoint& point) const -> observed_point {
+        return observe_camera_local(to_camera_local(point));
+    }
+
     auto Observer::translate_data_point(const vec3& local_point) const -> vec3 {
         return local_point.transpose() * _world_roll.rotation();
     }
@@ -144,6 +156,24 @@ namespace rcsop::common {
         return result;
     }
 
+    auto Observer::to_camera_local(
+            const vector<SimplePoint>& points) const -> shared_ptr<vector<camera_local_point>> {
+        return map_vec_shared<SimplePoint, camera_local_point>(
+                points,
+                [this](const auto& point) {
+                    return to_camera_local(point);
+                });
+    }
+
+    auto Observer::observe_camera_local(
+            const vector<camera_local_point>& points) const -> shared_ptr<vector<observed_point>> {
+        return map_vec_shared<camera_local_point, observed_point>(
+                points,
+                [this](const auto& point) {
+                    return observe_camera_local(point);
+                });
+    }
+
     auto
     Observer::project_observed_positions(const vector<observed_point>& positions) const -> shared_ptr<vector<vec3>> {
         auto result = map_vec_shared<observed_point, vec3>(
@@ -0,0 +1,105 @@
+#include "utils/ply_vertices.h"
+
+#include <sstream>
+
+namespace rcsop::common::utils::io {
+
+    static auto ply_property_size(const string& type) -> optional<size_t> {
+        static const map<string, size_t> PROPERTY_SIZES = {
+                {"char",    1}, {"int8",    1}, {"uchar",  1}, {"uint8",  1},
+                {"short",   2}, {"int16",   2}, {"ushort", 2}, {"uint16", 2},
+                {"int",     4}, {"int32",   4}, {"uint",   4}, {"uint32", 4},
+                {"float",   4}, {"float32", 4},
+                {"double",  8}, {"float64", 8},
+        };
+        if (!PROPERTY_SIZES.contains(type)) {
+            return {};
+        }
+        return PROPERTY_SIZES.at(type);
+    }
+
+    auto parse_vertex_layout(MappedFileReader& reader) -> optional<ply_vertex_layout> {
+        if (reader.read_line() != "ply") {
+            return {};
+        }
+        ply_vertex_layout layout;
+        bool is_binary_little_endian = false;
+        bool in_vertex_element = false;
+        bool vertex_element_seen = false;
+        int coordinates_found = 0;
+
+        while (true) {
+            std::stringstream line(reader.read_line());
+            string keyword;
+            line >> keyword;
+
+            if (keyword == "end_header") {
+                break;
+            }
+            if (keyword == "format") {
+                string format;
+                line >> format;
+                is_binary_little_endian = format == "binary_little_endian";
+            } else if (keyword == "element") {
+                string name;
+                size_t count;
+                line >> name >> count;
+                if (name == "vertex") {
+                    if (vertex_element_seen) {
+                        return {};
+                    }
+                    vertex_element_seen = true;
+                    in_vertex_element = true;
+                    layout.vertex_count = count;
+                } else {
+                    if (!vertex_element_seen) {
+                        return {};
+                    }
+                    in_vertex_element = false;
+                }
+            } else if (keyword == "property" && in_vertex_element) {
+                string type, name;
+                line >> type >> name;
+                const auto size = ply_property_size(type);
+                if (!size.has_value()) {
+                    return {};
+                }
+                const size_t axis = name == "x" ? 0 : name == "y" ? 1 : name == "z" ? 2 : 3;
+                if (axis < 3) {
+                    const bool is_float = type == "float" || type == "float32";
+                    const bool is_double = type == "double" || type == "float64";
+                    if (!is_float && !is_double) {
+                        return {};
+                    }
+                    layout.coordinate_offsets[axis] = layout.stride;
+                    layout.coordinates_double[axis] = is_double;
+                    coordinates_found++;
+                }
+                layout.stride += *size;
+            }
+        }
+        if (!is_binary_little_endian || !vertex_element_seen || coordinates_found != 3) {
+            return {};
+        }
+        return layout;
+    }
+
+    static inline auto read_coordinate(const char* vertex, size_t offset, bool is_double) -> double {
+        if (is_double) {
+            double value;
+            std::memcpy(&value, vertex + offset, sizeof(double));
+            return value;
+        }
+        float value;
+        std::memcpy(&value, vertex + offset, sizeof(float));
+        return static_cast<double>(value);
+    }
+
+    auto read_vertex_position(const char* vertex, const ply_vertex_layout& layout) -> vec3 {
+        return {
+                read_coordinate(vertex, layout.coordinate_offsets[0], layout.coordinates_double[0]),
+                read_coordinate(vertex, layout.coordinate_offsets[1], layout.coordinates_double[1]),
+                read_coordinate(vertex, layout.coordinate_offsets[2], layout.coordinates_double[2]),
+        };
+    }
+}
@@ -0,0 +1,142 @@
+#include "point_source.h"
+
+#include <numeric>
+
+#include "utils/mapping.h"
+
+namespace rcsop::common {
+    namespace parallel = rcsop::common::utils::parallel;
+
+    using rcsop::common::utils::io::MappedFileReader;
+    using rcsop::common::utils::io::parse_vertex_layout;
+    using rcsop::common::utils::io::read_vertex_position;
+
+    static auto count_chunks(size_t point_count, size_t chunk_size) -> size_t {
+        if (point_count == 0) {
+            return 0;
+        }
+        if (chunk_size == 0) {
+            return 1;
+        }
+        return (point_count + chunk_size - 1) / chunk_size;
+    }
+
+    /**
+     * Index of the first point and number of points of a chunk.
+     */
+    static auto chunk_range(size_t chunk_index, size_t point_count, size_t chunk_size) -> pair<size_t, size_t> {
+        if (chunk_index >= count_chunks(point_count, chunk_size)) {
+            throw invalid_argument("Chunk " + std::to_string(chunk_index) + " of "
+                               + std::to_string(count_chunks(point_count, chunk_size)) + " requested.");
+        }
+        if (chunk_size == 0) {
+            return {0, point_count};
+        }
+        const size_t begin = chunk_index * chunk_size;
+        return {begin, std::min(chunk_size, point_count - begin)};
+    }
+
+    VectorPointSource::VectorPointSource(shared_ptr<const vector<SimplePoint>> points, size_t chunk_size)
+            : _points(std::move(points)), _chunk_size(chunk_size) {}
+
+    size_t VectorPointSource::chunk_count() const {
+        return count_chunks(_points->size(), _chunk_size);
+    }
+
+    point_chunk VectorPointSource::read_chunk(size_t chunk_index, vector<SimplePoint>& buffer) const {
+        const auto [begin, count] = chunk_range(chunk_index, _points->size(), _chunk_size);
+        return point_chunk(*_points).subspan(begin, count);
+    }
+
+    PlyVertexSource::PlyVertexSource(unique_ptr<MappedFile> file,
+                                     const ply_vertex_layout& layout,
+                                     const char* vertex_data,
+                                     size_t chunk_size,
+                                     point_id_t first_id)
+            : _file(std::move(file)),
+              _layout(layout),
+              _vertex_data(vertex_data),
+              _chunk_size(chunk_size),
+              _first_id(first_id) {}
+
+    auto PlyVertexSource::open(const path& ply_file_path,
+                               size_t chunk_size,
+                               point_id_t first_id) -> shared_ptr<PlyVertexSource> {
+        auto file = make_unique<MappedFile>(ply_file_path);
+        MappedFileReader reader(*file);
+        const auto layout = parse_vertex_layout(reader);
+        if (!layout.has_value()) {
+            return nullptr;
+        }
+        if (layout->vertex_count > reader.remaining() / layout->stride) {
+            throw runtime_error("Unexpected end of file in " + ply_file_path.string());
+        }
+        const char* vertex_data = reader.current();
+        return shared_ptr<PlyVertexSource>(
+                new PlyVertexSource(std::move(file), *layout, vertex_data, chunk_size, first_id));
+    }
+
+    size_t PlyVertexSource::vertex_count() const {
+        return _layout.vertex_count;
+    }
+
+    size_t PlyVertexSource::chunk_count() const {
+        return count_chunks(_layout.vertex_count, _chunk_size);
+    }
+
+    point_chunk PlyVertexSource::read_chunk(size_t chunk_index, vector<SimplePoint>& buffer) const {
+        const auto [begin, count] = chunk_range(chunk_index, _layout.vertex_count, _chunk_size);
+        vector<size_t> indices(count);
+        std::iota(indices.begin(), indices.end(), begin);
+        buffer.resize(count);
+        parallel::transform<false>(indices.cbegin(), indices.cend(), buffer.begin(),
+                                   [this](const size_t index) {
+                                       const char* vertex = _vertex_data + index * _layout.stride;
+                                       return SimplePoint(_first_id + static_cast<point_id_t>(index),
+                                                          read_vertex_position(vertex, _layout));
+                                   });
+        return buffer;
+    }
+
+    ChainedPointSource::ChainedPointSource(vector<shared_ptr<const PointSource>> sources)
+            : _sources(std::move(sources)) {
+        size_t first_chunk = 0;
+        for (const auto& source: _sources) {
+            _first_chunks.push_back(first_chunk);
+            first_chunk += source->chunk_count();
+        }
+        _first_chunks.push_back(first_chunk);
+    }
+
+    size_t ChainedPointSource::chunk_count() const {
+        return _first_chunks.back();
+    }
+
+    point_chunk ChainedPointSource::read_chunk(size_t chunk_index, vector<SimplePoint>& buffer) const {
+        if (chunk_index >= chunk_count()) {
+            throw invalid_argument("Chunk " + std::to_string(chunk_index) + " of "
+                               + std::to_string(chunk_count()) + " requested.");
+        }
+        // the last source starting at or before the chunk, sources without chunks are skipped that way
+        const auto next_source = std::upper_bound(_first_chunks.cbegin(), _first_chunks.cend(), chunk_index);
+        const auto source_index = static_cast<size_t>(std::distance(_first_chunks.cbegin(), next_source)) - 1;
+        return _sources[source_index]->read_chunk(chunk_index - _first_chunks[source_index], buffer);
+    }
+
+    auto get_bounds(const PointSource& source) -> optional<pair<vec3, vec3>> {
+        optional<pair<vec3, vec3>> bounds;
+        vector<SimplePoint> buffer;
+        for (size_t chunk_index = 0; chunk_index < source.chunk_count(); chunk_index++) {
+            for (const auto& point: source.read_chunk(chunk_index, buffer)) {
+                const vec3 position = point.position();
+                if (!bounds.has_value()) {
+                    bounds = {position, position};
+                    continue;
+                }
+                bounds->first = bounds->first.cwiseMin(position);
+                bounds->second = bounds->second.cwiseMax(position);
+            }
+        }
+        return bounds;
+    }
+}
@@ -0,0 +1,140 @@
+#include "scored_cloud_file.h"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace rcsop::common {
+    using rcsop::common::utils::io::MappedFileReader;
+    using rcsop::common::utils::points::point_id_t;
+
+    struct scored_cloud_header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t column_count;
+        std::int64_t height;
+        std::int64_t azimuth;
+        std::uint64_t point_count;
+    };
+
+    enum ScoredCloudColumn {
+        COLUMN_X = 0,
+        COLUMN_Y = 1,
+        COLUMN_Z = 2,
+        COLUMN_SCORE = 3,
+        COLUMN_DB = 4,
+        COLUMN_ID = 5,
+
+        COLUMN_COUNT = 6,
+    };
+
+    const static size_t COLUMN_VALUE_SIZE = 8;
+
+    static_assert(sizeof(scored_cloud_header) % COLUMN_VALUE_SIZE == 0);
+    static_assert(sizeof(double) == COLUMN_VALUE_SIZE && sizeof(point_id_t) == COLUMN_VALUE_SIZE);
+
+    template<typename T>
+    static void write_column(std::ofstream& file,
+                             const vector<ScoredPoint>& points,
+                             const function<T(const ScoredPoint&)>& get_value) {
+        vector<T> values;
+        values.reserve(points.size());
+        for (const auto& point: points) {
+            values.push_back(get_value(point));
+        }
+        file.write(reinterpret_cast<const char*>(values.data()),
+                   static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    void write_scored_cloud(const path& file_path,
+                            const ObserverPosition& position,
+                            const vector<ScoredPoint>& points) {
+        scored_cloud_header header{};
+        std::memcpy(header.magic, SCORED_CLOUD_MAGIC, sizeof(header.magic));
+        header.version = SCORED_CLOUD_VERSION;
+        header.column_count = COLUMN_COUNT;
+        header.height = position.height;
+        header.azimuth = position.azimuth;
+        header.point_count = points.size();
+
+        const path temporary_path{file_path.string() + ".tmp"};
+        {
+            std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            write_column<double>(file, points, [](const ScoredPoint& point) { return point.position().x(); });
+            write_column<double>(file, points, [](const ScoredPoint& point) { return point.position().y(); });
+            write_column<double>(file, points, [](const ScoredPoint& point) { return point.position().z(); });
+            write_column<double>(file, points, [](const ScoredPoint& point) { return point.score(); });
+            write_column<double>(file, points, [](const ScoredPoint& point) { return point.score_to_dB(); });
+            write_column<point_id_t>(file, points, [](const ScoredPoint& point) { return point.id(); });
+            if (!file) {
+                throw runtime_error("Could not write scored cloud " + temporary_path.string());
+            }
+        }
+        std::filesystem::rename(temporary_path, file_path);
+    }
+
+    ScoredCloudFile::ScoredCloudFile(path file_path) : _file(std::move(file_path)) {
+        MappedFileReader reader(_file);
+        const auto header = reader.read<scored_cloud_header>();
+        if (std::memcmp(header.magic, SCORED_CLOUD_MAGIC, sizeof(header.magic)) != 0) {
+            throw runtime_error(_file.file_path().string() + " is not a scored cloud.");
+        }
+        if (header.version != SCORED_CLOUD_VERSION || header.column_count != COLUMN_COUNT) {
+            throw runtime_error("Unsupported scored cloud version " + std::to_string(header.version)
+                                + " in " + _file.file_path().string());
+        }
+        _position = {
+                .height = header.height,
+                .azimuth = header.azimuth,
+        };
+        // the count comes from the file, multiplying it could wrap around
+        const size_t point_bytes = COLUMN_COUNT * COLUMN_VALUE_SIZE;
+        _point_count = header.point_count;
+        if (reader.remaining() % point_bytes != 0 || reader.remaining() / point_bytes != _point_count) {
+            throw runtime_error("Scored cloud " + _file.file_path().string() + " is truncated.");
+        }
+    }
+
+    template<typename T>
+    T ScoredCloudFile::column_value(size_t column, size_t index) const {
+        const char* value_data = _file.data() + sizeof(scored_cloud_header)
+                                 + (column * _point_count + index) * COLUMN_VALUE_SIZE;
+        T value;
+        std::memcpy(&value, value_data, sizeof(T));
+        return value;
+    }
+
+    auto ScoredCloudFile::position() const -> ObserverPosition {
+        return _position;
+    }
+
+    auto ScoredCloudFile::point_count() const -> size_t {
+        return _point_count;
+    }
+
+    auto ScoredCloudFile::points(double min_dB) const -> shared_ptr<vector<ScoredPoint>> {
+        auto points = make_shared<vector<ScoredPoint>>();
+        points->reserve(_point_count);
+        for (size_t index = 0; index < _point_count; index++) {
+            if (column_value<double>(COLUMN_DB, index) < min_dB) {
+                continue;
+            }
+            const vec3 position(column_value<double>(COLUMN_X, index),
+                                column_value<double>(COLUMN_Y, index),
+                                column_value<double>(COLUMN_Z, index));
+            points->emplace_back(position,
+                                 column_value<point_id_t>(COLUMN_ID, index),
+                                 column_value<double>(COLUMN_SCORE, index));
+        }
+        return points;
+    }
+
+    auto ScoredCloudFile::file_name(const ObserverPosition& position) -> string {
+        std::ostringstream name;
+        name << position.height << "cm_" << std::setw(3) << std::setfill('0') << position.azimuth
+             << SCORED_CLOUD_EXTENSION;
+        return name.str();
+    }
+}
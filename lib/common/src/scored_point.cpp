@@ -12,7 +12,7 @@ namespace rcsop::common {
     using rcsop::common::utils::max_value;
 
     ScoredPoint::ScoredPoint(vec3 position, point_id_t id, double score) :
-            _point(SimplePoint(id, std::move(position))), _score(score) {}
+            _point(SimplePoint(id, std::move(position))), _score(static_cast<storage_scalar_t>(score)) {}
 
     point_id_t ScoredPoint::id() const { return _point.id(); }
 
@@ -20,6 +20,10 @@ namespace rcsop::common {
         return _point.position();
     }
 
+    double ScoredPoint::score() const {
+        return _score;
+    }
+
     double ScoredPoint::score_to_dB() const {
         return raw_rcs_to_dB(_score);
     }
@@ -0,0 +1,94 @@
+#include "utils/scratch_arena.h"
+
+#include <atomic>
+
+namespace rcsop::common::utils::memory {
+    static std::atomic<bool> arenas_enabled{true};
+
+    void* ScratchArena::counting_resource::do_allocate(size_t bytes, size_t alignment) {
+        _allocated_bytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void ScratchArena::counting_resource::do_deallocate(void* memory, size_t bytes, size_t alignment) {
+        std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+    }
+
+    bool ScratchArena::counting_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+    size_t ScratchArena::counting_resource::allocated_bytes() const {
+        return _allocated_bytes;
+    }
+
+    void ScratchArena::counting_resource::clear() {
+        _allocated_bytes = 0;
+    }
+
+    ScratchArena::ScratchArena(size_t initial_size)
+            : _buffer(std::make_unique_for_overwrite<std::byte[]>(initial_size)),
+              _buffer_size(initial_size) {
+        _resource.emplace(_buffer.get(), _buffer_size, &_upstream);
+    }
+
+    auto ScratchArena::resource() -> std::pmr::memory_resource* {
+        return &*_resource;
+    }
+
+    void ScratchArena::reset() {
+        const size_t overflow = _upstream.allocated_bytes();
+        _resource.reset();
+        _upstream.clear();
+        // the next unit of work most likely needs as much as this one, so it should fit into the buffer
+        const size_t required_size = min(_buffer_size + overflow, SCRATCH_ARENA_MAX_RETAINED_SIZE);
+        if (required_size > _buffer_size) {
+            _buffer.reset();
+            _buffer = std::make_unique_for_overwrite<std::byte[]>(required_size);
+            _buffer_size = required_size;
+        }
+        _resource.emplace(_buffer.get(), _buffer_size, &_upstream);
+    }
+
+    auto ScratchArena::capacity() const -> size_t {
+        return _buffer_size;
+    }
+
+    auto ScratchArena::for_current_thread() -> ScratchArena& {
+        thread_local ScratchArena arena;
+        return arena;
+    }
+
+    ScopedScratch::ScopedScratch() {
+        if (!scratch_arenas_enabled()) {
+            return;
+        }
+        _arena = &ScratchArena::for_current_thread();
+        _arena->_scope_depth++;
+    }
+
+    ScopedScratch::~ScopedScratch() {
+        if (_arena == nullptr) {
+            return;
+        }
+        // nested scopes, e.g. a task stolen by a waiting worker, keep their memory until the outermost one ends
+        if (--_arena->_scope_depth == 0) {
+            _arena->reset();
+        }
+    }
+
+    auto ScopedScratch::resource() const -> std::pmr::memory_resource* {
+        if (_arena == nullptr) {
+            return std::pmr::new_delete_resource();
+        }
+        return _arena->resource();
+    }
+
+    void set_scratch_arenas_enabled(bool enabled) {
+        arenas_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool scratch_arenas_enabled() {
+        return arenas_enabled.load(std::memory_order_relaxed);
+    }
+}
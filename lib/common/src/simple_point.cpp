@@ -1,12 +1,13 @@
 #include "simple_point.h"
 
 namespace rcsop::common {
+    using rcsop::common::utils::points::to_storage;
 
     SimplePoint::SimplePoint(point_id_t id, vec3 position) :
-            _point_id(id), _position(std::move(position)) {}
+            _point_id(id), _position(to_storage(position)) {}
             
     vec3 SimplePoint::position() const {
-        return this->_position;
+        return this->_position.cast<double>();
     }
 
     point_id_t SimplePoint::id() const {
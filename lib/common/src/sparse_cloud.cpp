@@ -6,8 +6,12 @@
 namespace rcsop::common {
     using std::filesystem::is_regular_file;
     using rcsop::common::utils::sort_in_place;
+    using rcsop::common::utils::map_vec_shared;
 
     using rcsop::common::utils::sparse::Image;
+    using rcsop::common::utils::sparse::Point3D;
+
+    using native_point_ref = pair<point_id_t, const Point3D*>;
 
     const static char* FILE_CAMERAS = "cameras.bin";
     const static char* FILE_IMAGES = "images.bin";
@@ -61,24 +65,49 @@ namespace rcsop::common {
         return this->cameras;
     }
 
-    shared_ptr<vector<SimplePoint>> SparseCloud::get_points() const {
-        auto point_map = reconstruction->Points3D();
-        auto result = make_shared<vector<SimplePoint>>();
+    /**
+     * References into the native point map, sorted by point ID, without copying any tracks
+     */
+    static auto collect_sorted_by_id(const Reconstruction& reconstruction) -> vector<native_point_ref> {
+        const auto& point_map = reconstruction.Points3D();
+        vector<native_point_ref> result;
+        result.reserve(point_map.size());
         for (const auto& [point_id, point]: point_map) {
-            result->emplace_back(point_id, point.XYZ());
+            result.emplace_back(point_id, &point);
         }
-
-        sort_in_place<SimplePoint, point_id_t>(*result, [](const SimplePoint& point) {
-            return point.id();
+        sort_in_place<native_point_ref, point_id_t>(result, [](const native_point_ref& point) {
+            return point.first;
         });
         return result;
     }
 
-    void SparseCloud::filter_points(const std::function<bool(const vec3&)>& predicate_to_keep) {
-        auto points = reconstruction->Points3D();
+    shared_ptr<vector<SimplePoint>> SparseCloud::get_points() const {
+        const auto native_points = collect_sorted_by_id(*reconstruction);
+        return map_vec_shared<native_point_ref, SimplePoint>(native_points, [](const native_point_ref& point) {
+            return SimplePoint(point.first, point.second->XYZ());
+        });
+    }
 
-        for (const auto& [point_id, point]: points) {
+    shared_ptr<vector<vec3>> SparseCloud::get_point_positions() const {
+        const auto native_points = collect_sorted_by_id(*reconstruction);
+        return map_vec_shared<native_point_ref, vec3>(native_points, [](const native_point_ref& point) -> vec3 {
+            return point.second->XYZ();
+        });
+    }
+
+    void SparseCloud::filter_points(const std::function<bool(const vec3&)>& predicate_to_keep) {
+        vector<point_id_t> points_to_delete;
+        for (const auto& [point_id, point]: reconstruction->Points3D()) {
             if (!predicate_to_keep(point.XYZ())) {
+                points_to_delete.push_back(point_id);
+            }
+        }
+        delete_points(points_to_delete);
+    }
+
+    void SparseCloud::delete_points(const vector<point_id_t>& point_ids) {
+        for (const auto point_id: point_ids) {
+            if (reconstruction->ExistsPoint3D(point_id)) {
                 reconstruction->DeletePoint3D(point_id);
             }
         }
@@ -102,6 +131,16 @@ namespace rcsop::common {
         }
     }
 
+    void SparseCloud::add_points(const vector<SimplePoint>& points,
+                                 const vector<color_vec>& colors) {
+        if (points.size() != colors.size()) {
+            throw invalid_argument("Every point to add needs exactly one color.");
+        }
+        for (size_t index = 0; index < points.size(); index++) {
+            add_point(&points[index], colors[index]);
+        }
+    }
+
     void SparseCloud::write(const path& output_path) {
         create_directories(output_path);
         reconstruction->WriteBinary(output_path);
@@ -116,25 +155,32 @@ namespace rcsop::common {
     }
 
     void SparseCloud::purge_cameras(const camera_id_t camera_to_keep) {
-        auto points = get_points();
-        map<point_id_t, color_vec> point_colors;
-
-        auto native_points = reconstruction->Points3D();
-        for (const auto& point: *points) {
-            auto color = native_points.at(point.id()).Color();
-            point_colors.insert(make_pair(point.id(), color.homogeneous()));
+        const auto& native_points = reconstruction->Points3D();
+        vector<SimplePoint> points;
+        vector<color_vec> point_colors;
+        points.reserve(native_points.size());
+        point_colors.reserve(native_points.size());
+        for (const auto& [point_id, point]: native_points) {
+            points.emplace_back(point_id, point.XYZ());
+            point_colors.push_back(point.Color().homogeneous());
         }
 
-        for (const auto& camera: get_cameras()) {
+        for (const auto& camera: this->cameras) {
             if (camera.id() == camera_to_keep) {
                 continue;
             }
             reconstruction->DeRegisterImage(camera.id());
         }
 
-        for (const auto& point: *points) {
-            auto color = point_colors.at(point.id());
-            reconstruction->AddPoint3D(point.position(), colmap::Track{}, convert_color(color));
+        // de-registering deletes points with too short tracks, only those have to be restored
+        vector<SimplePoint> deleted_points;
+        vector<color_vec> deleted_point_colors;
+        for (size_t index = 0; index < points.size(); index++) {
+            if (!reconstruction->ExistsPoint3D(points[index].id())) {
+                deleted_points.push_back(points[index]);
+                deleted_point_colors.push_back(point_colors[index]);
+            }
         }
+        add_points(deleted_points, deleted_point_colors);
     }
 }
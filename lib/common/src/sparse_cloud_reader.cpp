@@ -0,0 +1,158 @@
+#include "sparse_cloud_reader.h"
+
+#include "colmap/base/camera_models.h"
+
+#include "utils/mapping.h"
+#include "utils/mapped_file.h"
+
+namespace rcsop::common {
+    using rcsop::common::utils::map_vec;
+    using rcsop::common::utils::map_vec_shared;
+    using rcsop::common::utils::sort_in_place;
+    using rcsop::common::utils::io::MappedFile;
+    using rcsop::common::utils::io::MappedFileReader;
+
+    using rcsop::common::utils::sparse::Image;
+    using rcsop::common::utils::sparse::Camera;
+
+    const static char* FILE_CAMERAS = "cameras.bin";
+    const static char* FILE_IMAGES = "images.bin";
+    const static char* FILE_POINTS = "points3D.bin";
+
+    // x, y (double) and the point3D ID (uint64) per observation in images.bin
+    const static size_t IMAGE_POINT2D_BYTES = 2 * sizeof(double) + sizeof(uint64_t);
+    // image ID and point2D index (both uint32) per track element in points3D.bin
+    const static size_t POINT_TRACK_ELEMENT_BYTES = 2 * sizeof(uint32_t);
+
+    SparseCloudReader::SparseCloudReader(const path& model_path) {
+        read_points(model_path / FILE_POINTS);
+        read_cameras(model_path / FILE_CAMERAS, model_path / FILE_IMAGES);
+    }
+
+    bool SparseCloudReader::is_available_at(const path& root_path) {
+        path cameras_path{root_path / FILE_CAMERAS};
+        path images_path{root_path / FILE_IMAGES};
+        path points_path{root_path / FILE_POINTS};
+
+        return is_regular_file(cameras_path) && is_regular_file(images_path) && is_regular_file(points_path);
+    }
+
+    void SparseCloudReader::read_points(const path& points_path) {
+        const MappedFile file(points_path);
+        MappedFileReader reader(file);
+
+        const auto point_count = reader.read<uint64_t>();
+        _points.reserve(point_count);
+        for (uint64_t i = 0; i < point_count; i++) {
+            const auto point_id = reader.read<uint64_t>();
+            double xyz[3];
+            reader.read_into(xyz);
+            uint8_t rgb[3];
+            reader.read_into(rgb);
+            reader.skip(sizeof(double)); // reprojection error
+
+            const auto track_length = reader.read<uint64_t>();
+            reader.skip_elements(track_length, POINT_TRACK_ELEMENT_BYTES);
+
+            color_vec color;
+            color << rgb[0], rgb[1], rgb[2], 1;
+            _points.push_back(sparse_point{
+                    .id = point_id,
+                    .position = vec3(xyz[0], xyz[1], xyz[2]),
+                    .color = color,
+            });
+        }
+
+        sort_in_place<sparse_point, point_id_t>(_points, [](const sparse_point& point) {
+            return point.id;
+        });
+    }
+
+    void SparseCloudReader::read_cameras(const path& cameras_path, const path& images_path) {
+        map<colmap::camera_t, Camera> cameras;
+        {
+            const MappedFile file(cameras_path);
+            MappedFileReader reader(file);
+
+            const auto camera_count = reader.read<uint64_t>();
+            for (uint64_t i = 0; i < camera_count; i++) {
+                Camera camera;
+                camera.SetCameraId(reader.read<uint32_t>());
+                camera.SetModelId(reader.read<int32_t>());
+                camera.SetWidth(reader.read<uint64_t>());
+                camera.SetHeight(reader.read<uint64_t>());
+
+                const auto param_count = colmap::CameraModelNumParams(camera.ModelId());
+                if (param_count < 0) {
+                    throw runtime_error("Unknown camera model in " + cameras_path.string());
+                }
+                vector<double> params(param_count);
+                for (auto& param: params) {
+                    param = reader.read<double>();
+                }
+                camera.SetParams(params);
+                cameras.insert(make_pair(camera.CameraId(), camera));
+            }
+        }
+
+        const MappedFile file(images_path);
+        MappedFileReader reader(file);
+
+        const auto image_count = reader.read<uint64_t>();
+        vector<Image> images;
+        images.reserve(image_count);
+        for (uint64_t i = 0; i < image_count; i++) {
+            Image image;
+            image.SetImageId(reader.read<uint32_t>());
+            double qvec[4];
+            reader.read_into(qvec);
+            double tvec[3];
+            reader.read_into(tvec);
+            image.SetQvec(Eigen::Vector4d(qvec[0], qvec[1], qvec[2], qvec[3]));
+            image.SetTvec(Eigen::Vector3d(tvec[0], tvec[1], tvec[2]));
+            image.SetCameraId(reader.read<uint32_t>());
+            image.SetName(reader.read_null_terminated());
+
+            const auto point2d_count = reader.read<uint64_t>();
+            reader.skip_elements(point2d_count, IMAGE_POINT2D_BYTES);
+
+            images.push_back(image);
+        }
+        sort_in_place<Image, string>(images, [](const Image& a) -> string {
+            return a.Name();
+        });
+
+        for (const auto& image: images) {
+            if (!cameras.contains(image.CameraId())) {
+                throw runtime_error("Image " + image.Name() + " references a missing camera in " + cameras_path.string());
+            }
+            _cameras.emplace_back(image, cameras.at(image.CameraId()));
+        }
+    }
+
+    vector<ModelCamera> SparseCloudReader::get_cameras() const {
+        return this->_cameras;
+    }
+
+    shared_ptr<vector<SimplePoint>> SparseCloudReader::get_points() const {
+        return map_vec_shared<sparse_point, SimplePoint>(_points, [](const sparse_point& point) {
+            return SimplePoint(point.id, point.position);
+        });
+    }
+
+    shared_ptr<vector<vec3>> SparseCloudReader::get_point_positions() const {
+        return map_vec_shared<sparse_point, vec3>(_points, [](const sparse_point& point) {
+            return point.position;
+        });
+    }
+
+    vector<color_vec> SparseCloudReader::get_point_colors() const {
+        return map_vec<sparse_point, color_vec>(_points, [](const sparse_point& point) {
+            return point.color;
+        });
+    }
+
+    size_t SparseCloudReader::point_count() const {
+        return this->_points.size();
+    }
+}
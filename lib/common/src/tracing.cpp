@@ -0,0 +1,245 @@
+#include "utils/tracing.h"
+
+#include <atomic>
+#include <mutex>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace rcsop::common::utils::tracing {
+    using std::chrono::duration;
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    struct thread_trace_buffer {
+        uint32_t thread_id{};
+        uint32_t depth{};
+        std::mutex lock;
+        vector<trace_event> events;
+    };
+
+    static std::atomic<bool> tracing_enabled{false};
+    static trace_clock::time_point trace_origin = trace_clock::now();
+
+    static std::mutex registry_lock;
+    static vector<shared_ptr<thread_trace_buffer>> thread_buffers;
+    static uint32_t next_thread_id = 0;
+
+    static std::mutex counter_lock;
+    static vector<trace_counter> counters;
+
+    static auto local_buffer() -> thread_trace_buffer& {
+        thread_local shared_ptr<thread_trace_buffer> buffer = []() {
+            auto new_buffer = make_shared<thread_trace_buffer>();
+            std::lock_guard guard(registry_lock);
+            new_buffer->thread_id = next_thread_id++;
+            thread_buffers.push_back(new_buffer);
+            return new_buffer;
+        }();
+        return *buffer;
+    }
+
+    void enable_tracing() {
+        trace_origin = trace_clock::now();
+        tracing_enabled.store(true, std::memory_order_release);
+    }
+
+    bool is_tracing_enabled() {
+        return tracing_enabled.load(std::memory_order_relaxed);
+    }
+
+    ScopedSpan::ScopedSpan(const char* name, string detail)
+            : _name(name),
+              _active(is_tracing_enabled()) {
+        if (!_active) {
+            return;
+        }
+        _detail = std::move(detail);
+        local_buffer().depth++;
+        _start = trace_clock::now();
+    }
+
+    ScopedSpan::~ScopedSpan() {
+        if (!_active) {
+            return;
+        }
+        const auto end = trace_clock::now();
+        auto& buffer = local_buffer();
+        const auto depth = --buffer.depth;
+
+        std::lock_guard guard(buffer.lock);
+        buffer.events.push_back(trace_event{
+                .name = _name,
+                .detail = std::move(_detail),
+                .start = _start,
+                .duration = end - _start,
+                .thread_id = buffer.thread_id,
+                .depth = depth,
+        });
+    }
+
+    void record_counter(const char* name, vector<pair<string, double>> values) {
+        if (!is_tracing_enabled()) {
+            return;
+        }
+        const auto now = trace_clock::now();
+        std::lock_guard guard(counter_lock);
+        counters.push_back(trace_counter{
+                .name = name,
+                .time = now,
+                .values = std::move(values),
+        });
+    }
+
+    auto collect_events() -> vector<trace_event> {
+        vector<trace_event> result;
+        {
+            std::lock_guard registry_guard(registry_lock);
+            for (const auto& buffer: thread_buffers) {
+                std::lock_guard buffer_guard(buffer->lock);
+                result.insert(result.end(), buffer->events.cbegin(), buffer->events.cend());
+            }
+        }
+        std::sort(result.begin(), result.end(), [](const trace_event& a, const trace_event& b) {
+            return a.start < b.start;
+        });
+        return result;
+    }
+
+    static auto escape_json(const string& value) -> string {
+        std::stringstream escaped;
+        for (const char character: value) {
+            switch (character) {
+                case '"':
+                    escaped << "\\\"";
+                    break;
+                case '\\':
+                    escaped << "\\\\";
+                    break;
+                case '\n':
+                    escaped << "\\n";
+                    break;
+                case '\t':
+                    escaped << "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(character) < 0x20) {
+                        escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                                << static_cast<int>(character) << std::dec;
+                    } else {
+                        escaped << character;
+                    }
+            }
+        }
+        return escaped.str();
+    }
+
+    static auto to_microseconds(trace_clock::duration value) -> long long {
+        return duration_cast<microseconds>(value).count();
+    }
+
+    void write_chrome_trace(const path& trace_file) {
+        const auto events = collect_events();
+
+        std::ofstream output(trace_file, std::ios::trunc);
+        if (!output) {
+            throw runtime_error("Could not open " + trace_file.string() + " for writing");
+        }
+        output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        set<uint32_t> thread_ids;
+        bool first = true;
+        for (const auto& event: events) {
+            thread_ids.insert(event.thread_id);
+            output << (first ? "\n" : ",\n")
+                   << "{\"name\":\"" << escape_json(event.name) << "\",\"cat\":\"rcsop\",\"ph\":\"X\""
+                   << ",\"ts\":" << to_microseconds(event.start - trace_origin)
+                   << ",\"dur\":" << to_microseconds(event.duration)
+                   << ",\"pid\":1,\"tid\":" << event.thread_id
+                   << ",\"args\":{\"detail\":\"" << escape_json(event.detail) << "\",\"depth\":" << event.depth
+                   << "}}";
+            first = false;
+        }
+        {
+            std::lock_guard guard(counter_lock);
+            for (const auto& counter: counters) {
+                output << (first ? "\n" : ",\n")
+                       << "{\"name\":\"" << escape_json(counter.name) << "\",\"ph\":\"C\""
+                       << ",\"ts\":" << to_microseconds(counter.time - trace_origin)
+                       << ",\"pid\":1,\"args\":{";
+                bool first_value = true;
+                for (const auto& [key, value]: counter.values) {
+                    output << (first_value ? "" : ",") << "\"" << escape_json(key) << "\":" << value;
+                    first_value = false;
+                }
+                output << "}}";
+                first = false;
+            }
+        }
+        for (const auto thread_id: thread_ids) {
+            output << (first ? "\n" : ",\n")
+                   << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread_id
+                   << ",\"args\":{\"name\":\"" << (thread_id == 0 ? "main" : "worker " + std::to_string(thread_id))
+                   << "\"}}";
+            first = false;
+        }
+        output << "\n]}\n";
+        if (!output) {
+            throw runtime_error("Could not write " + trace_file.string());
+        }
+    }
+
+    struct span_statistics {
+        string name;
+        size_t calls{};
+        double total_seconds{};
+        double max_seconds{};
+        uint32_t min_depth = std::numeric_limits<uint32_t>::max();
+    };
+
+    void write_summary(std::ostream& output) {
+        const auto events = collect_events();
+
+        map<string, span_statistics> statistics_by_name;
+        set<uint32_t> thread_ids;
+        for (const auto& event: events) {
+            auto& statistics = statistics_by_name[event.name];
+            const double seconds = duration<double>(event.duration).count();
+            statistics.name = event.name;
+            statistics.calls++;
+            statistics.total_seconds += seconds;
+            statistics.max_seconds = std::max(statistics.max_seconds, seconds);
+            statistics.min_depth = std::min(statistics.min_depth, event.depth);
+            thread_ids.insert(event.thread_id);
+        }
+
+        vector<span_statistics> sorted_statistics;
+        for (const auto& [_, statistics]: statistics_by_name) {
+            sorted_statistics.push_back(statistics);
+        }
+        std::sort(sorted_statistics.begin(), sorted_statistics.end(),
+                  [](const span_statistics& a, const span_statistics& b) {
+                      return a.total_seconds > b.total_seconds;
+                  });
+
+        output << "Trace summary: " << events.size() << " spans on " << thread_ids.size() << " threads"
+               << " (totals of nested and parallel spans overlap)\n";
+        output << std::left << std::setw(28) << "stage" << std::right
+               << std::setw(6) << "depth" << std::setw(10) << "calls"
+               << std::setw(14) << "total [s]" << std::setw(14) << "mean [ms]" << std::setw(14) << "max [ms]"
+               << "\n";
+        for (const auto& statistics: sorted_statistics) {
+            const double mean_milliseconds = 1000. * statistics.total_seconds / static_cast<double>(statistics.calls);
+            output << std::left << std::setw(28) << statistics.name << std::right
+                   << std::setw(6) << statistics.min_depth << std::setw(10) << statistics.calls
+                   << std::fixed << std::setprecision(3)
+                   << std::setw(14) << statistics.total_seconds
+                   << std::setw(14) << mean_milliseconds
+                   << std::setw(14) << 1000. * statistics.max_seconds
+                   << "\n";
+        }
+        output.flush();
+    }
+}
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "utils/types.h"
+#include "utils/bounded_queue.h"
+
+using rcsop::common::utils::BoundedQueue;
+
+TEST(BoundedQueueTest, KeepsTheOrderAcrossThreads) {
+    BoundedQueue<size_t> queue(2);
+    std::thread producer([&queue]() {
+        for (size_t item = 0; item < 1000; item++) {
+            ASSERT_TRUE(queue.push(item));
+        }
+        queue.close();
+    });
+
+    size_t expected = 0;
+    while (const auto item = queue.pop()) {
+        EXPECT_EQ(*item, expected++);
+    }
+    producer.join();
+    EXPECT_EQ(expected, 1000);
+}
+
+TEST(BoundedQueueTest, ClosingReleasesWaitingProducers) {
+    BoundedQueue<size_t> queue(1);
+    ASSERT_TRUE(queue.push(1));
+    std::thread producer([&queue]() {
+        EXPECT_FALSE(queue.push(2));
+    });
+    queue.close();
+    producer.join();
+
+    EXPECT_EQ(queue.pop(), 1);
+    EXPECT_EQ(queue.pop(), std::nullopt);
+}
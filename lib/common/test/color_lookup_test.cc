@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+
+#include "utils/types.h"
+#include "colors.h"
+
+using rcsop::common::coloring::ColorLookupTable;
+using rcsop::common::coloring::map_jet;
+using rcsop::common::coloring::map_turbo;
+using rcsop::common::utils::sparse::color_vec;
+
+TEST(ColorLookupTableTest, MatchesColorMapWithinOneStep) {
+    const ColorLookupTable table(map_jet, -20., 5.);
+    for (double value = -25.; value <= 10.; value += 0.0137) {
+        const color_vec expected = map_jet(value, -20., 5.);
+        const color_vec actual = table(value);
+        for (int channel = 0; channel < 4; channel++) {
+            EXPECT_NEAR(actual[channel], expected[channel], 1) << "value = " << value;
+        }
+    }
+}
+
+TEST(ColorLookupTableTest, BulkMappingEqualsSingleLookups) {
+    const ColorLookupTable table(map_turbo, -20., 5.);
+    const vector<double> values{-30., -20., -7.5, 0., 4.99, 5., 12., std::nan("")};
+
+    const auto colors = table.map_values(values);
+
+    ASSERT_EQ(colors.size(), values.size());
+    for (size_t index = 0; index < values.size(); index++) {
+        EXPECT_EQ(colors[index], table(values[index]));
+    }
+    EXPECT_EQ(colors.back(), table(-20.));
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "utils/types.h"
+#include "utils/content_hash.h"
+
+#include "test_paths.h"
+
+using rcsop::common::utils::io::hash_bytes;
+using rcsop::common::utils::io::hash_string;
+using rcsop::common::utils::io::hash_file;
+using rcsop::common::utils::io::to_hex;
+
+TEST(ContentHashTest, DistinguishesLengthAndContent) {
+    const string zeros(16, '\0');
+
+    EXPECT_EQ(hash_string("azimuth"), hash_string("azimuth"));
+    EXPECT_NE(hash_string("azimuth"), hash_string("azimutH"));
+    EXPECT_NE(hash_bytes(zeros.data(), 8), hash_bytes(zeros.data(), 16));
+    EXPECT_NE(hash_string(""), hash_string("", hash_string("seed")));
+    EXPECT_EQ(to_hex(0x2a).size(), 16);
+}
+
+TEST(ContentHashTest, FileHashEqualsHashOfItsContent) {
+    const path file_path = unique_temp_path("content.bin");
+    const string content = "DataAuswertung_40cm_090°.mat, not quite a MAT file";
+    {
+        std::ofstream file(file_path, std::ios::binary);
+        file << content;
+    }
+
+    EXPECT_EQ(hash_file(file_path), hash_string(content));
+
+    std::filesystem::remove(file_path);
+}
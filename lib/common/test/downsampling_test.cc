@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "utils/types.h"
+#include "utils/downsampling.h"
+#include "simple_point.h"
+
+using rcsop::common::SimplePoint;
+using rcsop::common::utils::points::vec3;
+using rcsop::common::utils::points::voxel_downsample;
+
+TEST(VoxelDownsampleTest, KeepsOnePointPerVoxel) {
+    vector<SimplePoint> points;
+    for (size_t i = 0; i < 10; i++) {
+        points.emplace_back(i, vec3(0.05 * static_cast<double>(i), 0.1, 0.1));
+    }
+
+    auto result = voxel_downsample(points, 0.25);
+
+    // x from 0 to 0.45 covers the voxels [0, 0.25) and [0.25, 0.5)
+    ASSERT_EQ(result->size(), 2);
+    EXPECT_LT(result->at(0).id(), result->at(1).id());
+}
+
+TEST(VoxelDownsampleTest, KeepsPointNearestToVoxelCenter) {
+    vector<SimplePoint> points{
+            SimplePoint(1, vec3(0.01, 0.01, 0.01)),
+            SimplePoint(2, vec3(0.49, 0.51, 0.5)),
+            SimplePoint(3, vec3(0.9, 0.9, 0.9)),
+    };
+
+    auto result = voxel_downsample(points, 1.);
+
+    ASSERT_EQ(result->size(), 1);
+    EXPECT_EQ(result->at(0).id(), 2);
+}
+
+TEST(VoxelDownsampleTest, KeepsIsolatedPoints) {
+    vector<SimplePoint> points;
+    for (size_t i = 0; i < 100; i++) {
+        points.emplace_back(i, vec3(0.001 * static_cast<double>(i), 0, 0));
+    }
+    points.emplace_back(100, vec3(-5, 3, 2));
+    points.emplace_back(101, vec3(7, -1, 4));
+
+    auto result = voxel_downsample(points, 0.5);
+
+    ASSERT_EQ(result->size(), 3);
+    EXPECT_EQ(result->at(1).id(), 100);
+    EXPECT_EQ(result->at(2).id(), 101);
+}
+
+TEST(VoxelDownsampleTest, RejectsNonPositiveVoxelSize) {
+    vector<SimplePoint> points{SimplePoint(1, vec3::Zero())};
+
+    EXPECT_THROW(auto result = voxel_downsample(points, 0.), std::invalid_argument);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <numeric>
+
+#include "utils/types.h"
+#include "utils/executor.h"
+
+using rcsop::common::utils::parallel::configure_executor;
+using rcsop::common::utils::parallel::executor_options;
+using rcsop::common::utils::parallel::nesting_policy;
+using rcsop::common::utils::parallel::thread_count;
+using rcsop::common::utils::parallel::run_parallel;
+using rcsop::common::utils::parallel::for_each_outer;
+using rcsop::common::utils::parallel::run_tasks;
+
+TEST(ExecutorTest, ThreadLimitIsApplied) {
+    configure_executor({.threads = 1});
+    EXPECT_EQ(thread_count(), 1);
+    EXPECT_FALSE(run_parallel());
+
+    configure_executor({});
+    EXPECT_GE(thread_count(), 1);
+}
+
+TEST(ExecutorTest, InnerLoopsRunSeriallyWithinOuterItems) {
+    configure_executor({.threads = 4, .nesting = nesting_policy::OUTER_LOOPS});
+    vector<size_t> items(64);
+    std::iota(items.begin(), items.end(), 0);
+
+    std::atomic<size_t> parallel_inner_loops{0};
+    vector<size_t> sums(items.size());
+    for_each_outer(items.cbegin(), items.cend(), [&parallel_inner_loops, &sums](const size_t item) {
+        if (run_parallel()) {
+            parallel_inner_loops++;
+        }
+        vector<size_t> values(item + 1);
+        rcsop::common::utils::parallel::transform(values.cbegin(), values.cend(), values.begin(), [item](size_t) {
+            return item;
+        });
+        sums[item] = std::accumulate(values.cbegin(), values.cend(), size_t{0});
+    });
+    EXPECT_EQ(parallel_inner_loops, 0);
+    EXPECT_TRUE(run_parallel());
+    for (size_t item = 0; item < items.size(); item++) {
+        EXPECT_EQ(sums[item], item * (item + 1));
+    }
+    configure_executor({});
+}
+
+TEST(ExecutorTest, TasksRunOnceEach) {
+    configure_executor({.threads = 4, .nesting = nesting_policy::TASKS});
+    vector<std::atomic<size_t>> runs(1000);
+    std::atomic<size_t> parallel_inner_loops{0};
+    run_tasks(runs.size(), [&runs, &parallel_inner_loops](const size_t index) {
+        if (run_parallel()) {
+            parallel_inner_loops++;
+        }
+        runs[index]++;
+    });
+    EXPECT_EQ(parallel_inner_loops, 0);
+    for (const auto& count: runs) {
+        EXPECT_EQ(count, 1);
+    }
+    configure_executor({});
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "utils/types.h"
+#include "utils/gauss.h"
+#include "observed_point.h"
+
+using rcsop::common::observed_point;
+using rcsop::common::utils::points::storage_scalar_t;
+using rcsop::common::utils::gauss::gauss;
+using rcsop::common::utils::gauss::gauss_options;
+using rcsop::common::utils::gauss::get_gauss_integral_factor;
+using rcsop::common::utils::gauss::rcs_gaussian;
+using rcsop::common::utils::gauss::GaussTable;
+using rcsop::common::utils::gauss::VerticalGaussKernel;
+using rcsop::common::utils::gauss::EllipticGaussKernel;
+
+TEST(GaussTableTest, InterpolatesWithinTolerance) {
+    const double sigma = 0.159;
+    const GaussTable table(sigma, 2.);
+    for (double x = -2.; x <= 2.; x += 0.0013) {
+        const double expected = gauss(x, sigma);
+        EXPECT_NEAR(table(x), expected, 1e-4 * gauss(0, sigma)) << "x = " << x;
+    }
+}
+
+TEST(GaussTableTest, EvaluatesExactlyOutsideOfDomain) {
+    const GaussTable table(0.5, 1.);
+    EXPECT_DOUBLE_EQ(table(1.), gauss(1., 0.5));
+    EXPECT_DOUBLE_EQ(table(-3.), gauss(-3., 0.5));
+}
+
+TEST(GaussTableTest, RejectsInvalidSigma) {
+    EXPECT_THROW(GaussTable(0., 1.), invalid_argument);
+}
+
+TEST(VerticalGaussKernelTest, MatchesScaledGauss) {
+    const double spread = 5.;
+    const double sigma = 0.159;
+    const VerticalGaussKernel kernel(spread, sigma, spread);
+    for (double angle = -spread; angle <= spread; angle += 0.01) {
+        observed_point point{.vertical_angle = static_cast<storage_scalar_t>(angle)};
+        EXPECT_NEAR(kernel(point), gauss(angle / spread * 2, sigma), 1e-4 * gauss(0, sigma));
+    }
+}
+
+TEST(EllipticGaussKernelTest, MatchesRcsGaussian) {
+    const gauss_options options{
+            .sigma = 0.2,
+            .integral_factor = get_gauss_integral_factor(0.2),
+            .x_scale = 12.5,
+            .y_scale = 7.5,
+    };
+    const EllipticGaussKernel kernel(options);
+    const observed_point center{};
+    const double peak = rcs_gaussian(center, options);
+    for (double horizontal = -15.; horizontal <= 15.; horizontal += 0.37) {
+        for (double vertical = -9.; vertical <= 9.; vertical += 0.29) {
+            observed_point point{
+                    .vertical_angle = static_cast<storage_scalar_t>(vertical),
+                    .horizontal_angle = static_cast<storage_scalar_t>(horizontal),
+            };
+            EXPECT_NEAR(kernel(point), rcs_gaussian(point, options), 1e-4 * peak);
+        }
+    }
+}
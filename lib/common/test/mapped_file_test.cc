@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "utils/types.h"
+#include "utils/mapped_file.h"
+
+#include "test_paths.h"
+
+using rcsop::common::utils::io::MappedFile;
+using rcsop::common::utils::io::MappedFileReader;
+
+static auto write_counts(const path& file_path, const vector<uint64_t>& values) {
+    std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(values.data()),
+               static_cast<std::streamsize>(values.size() * sizeof(uint64_t)));
+}
+
+TEST(MappedFileTest, SkipsElementsWithinTheFile) {
+    const path file_path = unique_temp_path("elements.bin");
+    write_counts(file_path, {2, 10, 11, 12});
+    {
+        const MappedFile file(file_path);
+        MappedFileReader reader(file);
+        reader.skip_elements(reader.read<uint64_t>(), sizeof(uint64_t));
+        EXPECT_EQ(reader.read<uint64_t>(), 12);
+        EXPECT_THROW(reader.skip_elements(1, sizeof(uint64_t)), std::runtime_error);
+    }
+    std::filesystem::remove(file_path);
+}
+
+TEST(MappedFileTest, RejectsCountsThatWrapAround) {
+    const path file_path = unique_temp_path("wrapping.bin");
+    // 2^61 elements of 8 bytes wrap to 0 bytes
+    write_counts(file_path, {uint64_t{1} << 61, 1});
+    {
+        const MappedFile file(file_path);
+        MappedFileReader reader(file);
+        EXPECT_THROW(reader.skip_elements(reader.read<uint64_t>(), 8), std::runtime_error);
+    }
+    std::filesystem::remove(file_path);
+}
@@ -18,6 +18,8 @@ using rcsop::common::Observer;
 using rcsop::common::ScoredPoint;
 using rcsop::common::SimplePoint;
 using rcsop::common::observed_point;
+using rcsop::common::utils::points::stored_vec3;
+using rcsop::common::utils::points::storage_scalar_t;
 
 using rcsop::common::ObserverPosition;
 using rcsop::common::ObserverCamera;
@@ -232,11 +234,11 @@ protected:
         return map_vec<observation, observed_point>(
                 observations, [](const observation& observation) {
                     return observed_point{
-                            .position = vec3::Zero(),
+                            .position = stored_vec3::Zero(),
                             .id = 42,
-                            .distance_in_world = observation.distance,
-                            .vertical_angle = observation.vertical_angle,
-                            .horizontal_angle = observation.horizontal_angle};
+                            .distance_in_world = static_cast<storage_scalar_t>(observation.distance),
+                            .vertical_angle = static_cast<storage_scalar_t>(observation.vertical_angle),
+                            .horizontal_angle = static_cast<storage_scalar_t>(observation.horizontal_angle)};
                 });
     }
 
@@ -496,3 +498,25 @@ TEST_F(ObserverShould, ConvertCartesianToSphericalToCartesian) {
         EXPECT_NEAR(input.z(), result.z(), STANDARD_ERROR);
     }
 }
+
+TEST_F(ObserverShould, ObserveCameraLocalPointsLikeRolledClones) {
+    point_id_t id{};
+    const auto input = map_vec<vec3, SimplePoint>(ALL_POINTS, [this, &id](const vec3& point) {
+        return SimplePoint(id++, point + this->_observer_position);
+    });
+    const auto local_points = _sut->to_camera_local(input);
+
+    for (const double roll: {0., 45., 90., 135.}) {
+        const auto rolled_observer = _sut->clone_with_data({.roll = roll});
+        const auto expected = rolled_observer.observe_points(input);
+        const auto result = rolled_observer.observe_camera_local(*local_points);
+
+        ASSERT_EQ(result->size(), expected->size());
+        for (size_t i = 0; i < result->size(); i++) {
+            EXPECT_EQ(result->at(i).id, expected->at(i).id);
+            EXPECT_DOUBLE_EQ(result->at(i).distance_in_world, expected->at(i).distance_in_world);
+            EXPECT_DOUBLE_EQ(result->at(i).vertical_angle, expected->at(i).vertical_angle);
+            EXPECT_DOUBLE_EQ(result->at(i).horizontal_angle, expected->at(i).horizontal_angle);
+        }
+    }
+}
@@ -0,0 +1,142 @@
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "utils/types.h"
+#include "point_source.h"
+
+#include "test_paths.h"
+
+using rcsop::common::SimplePoint;
+using rcsop::common::PointSource;
+using rcsop::common::VectorPointSource;
+using rcsop::common::PlyVertexSource;
+using rcsop::common::ChainedPointSource;
+using rcsop::common::get_bounds;
+using rcsop::common::utils::points::vec3;
+
+static auto numbered_points(size_t count) -> shared_ptr<vector<SimplePoint>> {
+    auto points = make_shared<vector<SimplePoint>>();
+    for (size_t i = 0; i < count; i++) {
+        points->emplace_back(i, vec3(static_cast<double>(i), -static_cast<double>(i), 0.5));
+    }
+    return points;
+}
+
+static auto read_all(const PointSource& source) -> vector<SimplePoint> {
+    vector<SimplePoint> result;
+    vector<SimplePoint> buffer;
+    for (size_t chunk_index = 0; chunk_index < source.chunk_count(); chunk_index++) {
+        const auto chunk = source.read_chunk(chunk_index, buffer);
+        result.insert(result.end(), chunk.begin(), chunk.end());
+    }
+    return result;
+}
+
+TEST(PointSourceTest, SplitsVectorIntoChunks) {
+    const auto points = numbered_points(10);
+    const VectorPointSource source(points, 4);
+    ASSERT_EQ(source.chunk_count(), 3);
+
+    vector<SimplePoint> buffer;
+    EXPECT_EQ(source.read_chunk(0, buffer).size(), 4);
+    EXPECT_EQ(source.read_chunk(2, buffer).size(), 2);
+    EXPECT_EQ(source.read_chunk(2, buffer).front().id(), 8);
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_THROW(static_cast<void>(source.read_chunk(3, buffer)), invalid_argument);
+
+    EXPECT_EQ(VectorPointSource(points, 0).chunk_count(), 1);
+    EXPECT_EQ(VectorPointSource(make_shared<vector<SimplePoint>>(), 4).chunk_count(), 0);
+}
+
+TEST(PointSourceTest, ChainsSourcesInOrder) {
+    const ChainedPointSource source({
+            make_shared<VectorPointSource>(numbered_points(3), 2),
+            make_shared<VectorPointSource>(make_shared<vector<SimplePoint>>(), 2),
+            make_shared<VectorPointSource>(numbered_points(5), 2),
+    });
+    ASSERT_EQ(source.chunk_count(), 5);
+
+    const auto points = read_all(source);
+    ASSERT_EQ(points.size(), 8);
+    EXPECT_EQ(points[2].id(), 2);
+    EXPECT_EQ(points[3].id(), 0);
+    EXPECT_EQ(points[7].id(), 4);
+}
+
+TEST(PointSourceTest, DecodesPlyVerticesByChunk) {
+    const path file_path = unique_temp_path("vertices.ply");
+    {
+        std::ofstream file(file_path, std::ios::binary);
+        file << "ply\nformat binary_little_endian 1.0\nelement vertex 5\n"
+             << "property float x\nproperty uchar red\nproperty double y\nproperty float z\n"
+             << "element face 0\nproperty list uchar int vertex_indices\nend_header\n";
+        for (int i = 0; i < 5; i++) {
+            const float x = static_cast<float>(i);
+            const unsigned char red = 255;
+            const double y = 2. * i;
+            const float z = -1.f;
+            file.write(reinterpret_cast<const char*>(&x), sizeof(x));
+            file.write(reinterpret_cast<const char*>(&red), sizeof(red));
+            file.write(reinterpret_cast<const char*>(&y), sizeof(y));
+            file.write(reinterpret_cast<const char*>(&z), sizeof(z));
+        }
+    }
+
+    const auto source = PlyVertexSource::open(file_path, 2, 100);
+    ASSERT_NE(source, nullptr);
+    EXPECT_EQ(source->vertex_count(), 5);
+    ASSERT_EQ(source->chunk_count(), 3);
+
+    vector<SimplePoint> buffer;
+    const auto last_chunk = source->read_chunk(2, buffer);
+    ASSERT_EQ(last_chunk.size(), 1);
+    EXPECT_EQ(last_chunk.front().id(), 104);
+    EXPECT_EQ(last_chunk.front().position(), vec3(4., 8., -1.));
+
+    const auto points = read_all(*source);
+    ASSERT_EQ(points.size(), 5);
+    for (size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(points[i].id(), 100 + i);
+    }
+
+    const auto bounds = get_bounds(*source);
+    ASSERT_TRUE(bounds.has_value());
+    EXPECT_EQ(bounds->first, vec3(0., 0., -1.));
+    EXPECT_EQ(bounds->second, vec3(4., 8., -1.));
+
+    std::filesystem::remove(file_path);
+}
+
+TEST(PointSourceTest, RejectsPlyVertexCountBeyondTheFile) {
+    const path file_path = unique_temp_path("vertices.ply");
+    {
+        // 2^62 vertices of 16 bytes overflow to zero bytes when multiplied
+        std::ofstream file(file_path, std::ios::binary);
+        file << "ply\nformat binary_little_endian 1.0\nelement vertex 4611686018427387904\n"
+             << "property float x\nproperty float y\nproperty float z\nproperty float w\nend_header\n";
+        const float vertex[4] = {1.f, 2.f, 3.f, 4.f};
+        file.write(reinterpret_cast<const char*>(vertex), sizeof(vertex));
+    }
+
+    EXPECT_THROW(static_cast<void>(PlyVertexSource::open(file_path, 2)), runtime_error);
+
+    std::filesystem::remove(file_path);
+}
+
+TEST(PointSourceTest, LeavesIntegerCoordinatesToTheGenericReader) {
+    const path file_path = unique_temp_path("vertices.ply");
+    {
+        std::ofstream file(file_path, std::ios::binary);
+        file << "ply\nformat binary_little_endian 1.0\nelement vertex 1\n"
+             << "property int32 x\nproperty float y\nproperty float z\nend_header\n";
+        const int32_t x = 1;
+        const float yz[2] = {2.f, 3.f};
+        file.write(reinterpret_cast<const char*>(&x), sizeof(x));
+        file.write(reinterpret_cast<const char*>(yz), sizeof(yz));
+    }
+
+    EXPECT_EQ(PlyVertexSource::open(file_path, 2), nullptr);
+
+    std::filesystem::remove(file_path);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "utils/types.h"
+#include "scored_cloud_file.h"
+
+#include "test_paths.h"
+
+using rcsop::common::ScoredPoint;
+using rcsop::common::ScoredCloudFile;
+using rcsop::common::ObserverPosition;
+using rcsop::common::write_scored_cloud;
+using rcsop::common::utils::points::vec3;
+
+TEST(ScoredCloudFileTest, ReadsWrittenPoints) {
+    const path file_path = unique_temp_path("cloud.rcsc");
+    const vector<ScoredPoint> points{
+            ScoredPoint(vec3(1., 2., 3.), 7, 0.5),
+            ScoredPoint(vec3(-4., 0.25, 6.), 42, 2e-3),
+            ScoredPoint(vec3(0., 0., -1.), 3, 10.),
+    };
+    write_scored_cloud(file_path, ObserverPosition{.height = 40, .azimuth = 90}, points);
+
+    const ScoredCloudFile file(file_path);
+    EXPECT_EQ(file.position().height, 40);
+    EXPECT_EQ(file.position().azimuth, 90);
+    ASSERT_EQ(file.point_count(), points.size());
+
+    const auto read_points = file.points();
+    ASSERT_EQ(read_points->size(), points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(read_points->at(i).id(), points[i].id());
+        EXPECT_EQ(read_points->at(i).position(), points[i].position());
+        EXPECT_EQ(read_points->at(i).score(), points[i].score());
+    }
+
+    std::filesystem::remove(file_path);
+}
+
+TEST(ScoredCloudFileTest, DropsPointsBelowLowerBound) {
+    const path file_path = unique_temp_path("cloud.rcsc");
+    const vector<ScoredPoint> points{
+            ScoredPoint(vec3(1., 2., 3.), 1, 1.),
+            ScoredPoint(vec3(1., 2., 3.), 2, 1e-4),
+            ScoredPoint(vec3(1., 2., 3.), 3, 1e-1),
+    };
+    write_scored_cloud(file_path, ObserverPosition{.height = 120, .azimuth = 5}, points);
+
+    const auto read_points = ScoredCloudFile(file_path).points(points[2].score_to_dB());
+    ASSERT_EQ(read_points->size(), 2);
+    EXPECT_EQ(read_points->at(0).id(), 1);
+    EXPECT_EQ(read_points->at(1).id(), 3);
+    EXPECT_EQ(ScoredCloudFile::file_name(ObserverPosition{.height = 120, .azimuth = 5}), "120cm_005.rcsc");
+
+    std::filesystem::remove(file_path);
+}
+
+TEST(ScoredCloudFileTest, RejectsPointCountsThatWrapAround) {
+    const path file_path = unique_temp_path("wrapping.rcsc");
+    write_scored_cloud(file_path, ObserverPosition{.height = 40, .azimuth = 0}, {ScoredPoint(vec3(1., 2., 3.), 1, 1.)});
+    {
+        // 2^60 + 1 points of 48 bytes wrap around to the size of the single point in the file
+        std::fstream file(file_path, std::ios::binary | std::ios::in | std::ios::out);
+        const uint64_t point_count = (uint64_t{1} << 60) + 1;
+        file.seekp(32);
+        file.write(reinterpret_cast<const char*>(&point_count), sizeof(point_count));
+    }
+    EXPECT_THROW(ScoredCloudFile{file_path}, std::runtime_error);
+
+    std::filesystem::remove(file_path);
+}
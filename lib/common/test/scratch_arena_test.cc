@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include "utils/types.h"
+#include "utils/scratch_arena.h"
+
+using rcsop::common::utils::memory::ScratchArena;
+using rcsop::common::utils::memory::ScopedScratch;
+using rcsop::common::utils::memory::scratch_vector;
+
+TEST(ScratchArenaTest, GrowsToTheLargestUnitOfWork) {
+    ScratchArena arena(1024);
+    {
+        scratch_vector<double> values(arena.resource());
+        values.resize(4096);
+    }
+    arena.reset();
+    EXPECT_GE(arena.capacity(), 4096 * sizeof(double));
+
+    const auto capacity = arena.capacity();
+    {
+        scratch_vector<double> values(arena.resource());
+        values.resize(4096);
+    }
+    arena.reset();
+    EXPECT_EQ(arena.capacity(), capacity);
+}
+
+TEST(ScratchArenaTest, NestedScopesShareTheThreadArena) {
+    ScopedScratch outer;
+    auto outer_values = outer.make_vector<int>(16);
+    {
+        ScopedScratch inner;
+        EXPECT_EQ(inner.resource(), outer.resource());
+        auto inner_values = inner.make_vector<int>(16);
+        inner_values[0] = 1;
+    }
+    // the inner scope must not reset the arena under the outer one
+    outer_values[15] = 2;
+    EXPECT_EQ(outer_values.size(), 16);
+    EXPECT_EQ(outer_values[15], 2);
+}
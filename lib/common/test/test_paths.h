@@ -0,0 +1,24 @@
+#ifndef RCSOP_COMMON_TEST_PATHS_H
+#define RCSOP_COMMON_TEST_PATHS_H
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <unistd.h>
+
+#include "utils/types.h"
+
+/**
+ * Path in the temp directory no other test or test process uses, ending in name.
+ */
+inline auto unique_temp_path(const string& name) -> path {
+    static std::atomic<size_t> counter{0};
+    const auto* test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+    const string test_name = test_info != nullptr
+                             ? string(test_info->test_suite_name()) + "_" + test_info->name()
+                             : "test";
+    return std::filesystem::temp_directory_path()
+           / ("rcsop_" + test_name + "_" + std::to_string(getpid()) + "_" + std::to_string(counter++) + "_" + name);
+}
+
+#endif //RCSOP_COMMON_TEST_PATHS_H
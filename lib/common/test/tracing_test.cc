@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+
+#include "utils/types.h"
+#include "utils/tracing.h"
+
+using rcsop::common::utils::tracing::ScopedSpan;
+using rcsop::common::utils::tracing::enable_tracing;
+using rcsop::common::utils::tracing::collect_events;
+
+TEST(TracingTest, LazyDetailIsOnlyBuiltWhileTracing) {
+    size_t detail_calls = 0;
+    const auto detail = [&detail_calls]() {
+        detail_calls++;
+        return string("lazy");
+    };
+    {
+        ScopedSpan span("lazy_span", detail);
+    }
+    EXPECT_EQ(detail_calls, 0);
+
+    enable_tracing();
+    {
+        ScopedSpan span("lazy_span", detail);
+    }
+    EXPECT_EQ(detail_calls, 1);
+    const auto events = collect_events();
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ(events.back().detail, "lazy");
+}
@@ -18,18 +18,39 @@ namespace rcsop::data {
     using rcsop::common::utils::rcs::rcs_distance_t;
     using rcsop::common::utils::rcs::rcs_angle_t;
 
+    /**
+     * Value of the same cell in the raw and in the peak filtered table.
+     */
+    struct raw_and_filtered_value {
+        rcs_value_t raw;
+        rcs_value_t filtered;
+    };
+
     class AbstractDataSet {
     public:
         [[nodiscard]] virtual auto map_to_nearest(const observed_point& point) const -> rcs_value_t = 0;
 
         [[nodiscard]] virtual auto map_exact(rcs_distance_t distance, rcs_angle_t angle) const -> rcs_value_t = 0;
 
+        /**
+         * Like map_to_nearest, but resolves the cell once and reads both tables regardless of use_filtered_peaks.
+         */
+        [[nodiscard]] virtual auto map_to_nearest_both(const observed_point& point) const -> raw_and_filtered_value = 0;
+
+        [[nodiscard]] virtual auto map_exact_both(rcs_distance_t distance,
+                                                  rcs_angle_t angle) const -> raw_and_filtered_value = 0;
+
         [[nodiscard]] virtual auto distances() const -> vector<rcs_distance_t> = 0;
 
         [[nodiscard]] virtual auto distance_step() const -> rcs_distance_t = 0;
 
         [[nodiscard]] virtual auto angles() const -> vector<rcs_angle_t> = 0;
 
+        /**
+         * File the data set was read from.
+         */
+        [[nodiscard]] virtual auto source_path() const -> path = 0;
+
         virtual ~AbstractDataSet() = default;
     };
 
@@ -21,21 +21,31 @@ namespace rcsop::data {
 
     class AzimuthRcsDataSet : public AbstractDataSet {
     private:
+        path _source_path;
+
         vector<rcs_distance_t> _ranges;
         size_t _last_range_index;
         rcs_distance_t _last_range_step;
 
         vector<rcs_angle_t> _angles;
 
-        az_value_map_t _raw_values;
-        az_value_map_t _filtered_values;
+        // the tables are shared between copies, only the table selection belongs to each copy
+        shared_ptr<const az_value_map_t> _raw_values;
+        shared_ptr<const az_value_map_t> _filtered_values;
         bool use_filtered = false;
 
         [[nodiscard]] az_value_map_t reconstruct_value_table(const vector<double>& raw_values);
 
-        void filter_peaks();
+        [[nodiscard]] az_value_map_t filter_peaks() const;
 
         [[nodiscard]] rcs_value_t resolve_value(rcs_angle_t angle, size_t range_index) const;
+
+        [[nodiscard]] raw_and_filtered_value resolve_both(rcs_angle_t angle, size_t range_index) const;
+
+        /**
+         * Nearest angle and range index of the point, empty if it lies beyond the last range.
+         */
+        [[nodiscard]] optional<pair<rcs_angle_t, size_t>> find_nearest_cell(const observed_point& point) const;
     public:
         AzimuthRcsDataSet(const path& filename,
                           const ObserverPosition& position);
@@ -44,12 +54,19 @@ namespace rcsop::data {
 
         [[nodiscard]] rcs_value_t map_exact(rcs_distance_t distance, rcs_angle_t angle) const override;
 
+        [[nodiscard]] raw_and_filtered_value map_to_nearest_both(const observed_point& point) const override;
+
+        [[nodiscard]] raw_and_filtered_value map_exact_both(rcs_distance_t distance,
+                                                            rcs_angle_t angle) const override;
+
         [[nodiscard]] vector<rcs_distance_t> distances() const override;
 
         [[nodiscard]] rcs_distance_t distance_step() const override;
 
         [[nodiscard]] vector<rcs_angle_t> angles() const override;
 
+        [[nodiscard]] path source_path() const override;
+
         void use_filtered_peaks();
     };
 }
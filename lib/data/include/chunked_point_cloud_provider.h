@@ -0,0 +1,77 @@
+#ifndef RCSOP_DATA_CHUNKED_POINT_CLOUD_PROVIDER_H
+#define RCSOP_DATA_CHUNKED_POINT_CLOUD_PROVIDER_H
+
+#include "utils/points.h"
+#include "point_source.h"
+
+#include "input_data_collector.h"
+#include "point_cloud_provider.h"
+
+namespace rcsop::data {
+    using rcsop::common::PointSource;
+    using rcsop::common::point_chunk;
+
+    /**
+     * Jittered lattice inside a sphere around the origin like PointCloudProvider::generate_homogenous_cloud,
+     * generated chunk by chunk. A chunk covers a fixed range of lattice cells and seeds its jitter with its index,
+     * so reading it again yields the same points. The ids are the lattice indices.
+     */
+    class HomogenousPointSource : public PointSource {
+    private:
+        vec3 _begin;
+        size_t _cells[3];
+        double _step_size;
+        double _radius_limit;
+        size_t _chunk_size;
+        unsigned int _seed;
+
+    public:
+        HomogenousPointSource(const vec3& begin,
+                              const vec3& end,
+                              double step_size,
+                              double radius_limit,
+                              size_t chunk_size);
+
+        [[nodiscard]] size_t cell_count() const;
+
+        [[nodiscard]] size_t chunk_count() const override;
+
+        [[nodiscard]] point_chunk read_chunk(size_t chunk_index, vector<SimplePoint>& buffer) const override;
+    };
+
+    /**
+     * Counterpart of PointCloudProvider for clouds larger than the memory, the points are handed out in chunks.
+     * Binary PLY meshes are mapped and decoded chunk by chunk, other meshes are loaded as a whole. The sparse
+     * points stay in memory, COLMAP reads them at once anyway. The ids of the model points match those of
+     * PointCloudProvider, the generated homogenous cloud is numbered by lattice cell instead of one after the other.
+     */
+    class ChunkedPointCloudProvider {
+    private:
+        size_t _chunk_size;
+        shared_ptr<vector<SimplePoint>> _sparse_cloud_points = make_shared<vector<SimplePoint>>();
+        point_id_t _max_sparse_point_id = 0;
+        optional<path> _dense_mesh_path;
+        shared_ptr<DenseCloud> _dense_mesh = nullptr;
+
+        double _distance_to_origin = 1.;
+        double _units_per_centimeter = 1.;
+
+        [[nodiscard]] auto dense_points() const -> shared_ptr<PointSource>;
+
+    public:
+        ChunkedPointCloudProvider(const InputDataCollector& input,
+                                  const camera_options& camera_options,
+                                  size_t chunk_size);
+
+        [[nodiscard]] auto get_base_points(
+                ReconstructionType cloud_selection = ReconstructionType::COMPLETE) const -> shared_ptr<PointSource>;
+
+        /**
+         * The lattice is limited by the bounds of the complete model, which are found by reading it chunk by chunk.
+         * The ids are lattice cell indices, cells outside of the sphere leave gaps.
+         */
+        [[nodiscard]] auto generate_homogenous_cloud(size_t points_per_meter) const -> shared_ptr<PointSource>;
+    };
+}
+
+#endif //RCSOP_DATA_CHUNKED_POINT_CLOUD_PROVIDER_H
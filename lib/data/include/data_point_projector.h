@@ -4,32 +4,59 @@
 #include "utils/types.h"
 #include "abstract_rcs_map.h"
 #include "observed_point.h"
+#include "utils/gauss.h"
 
 namespace rcsop::data {
     using rcsop::common::Observer;
     using rcsop::common::data_observer_translation;
     using rcsop::common::camera_options;
     using rcsop::common::ScoredPoint;
-    using rcsop::common::observed_factor_func;
+    using rcsop::common::utils::gauss::VerticalGaussKernel;
     using rcsop::common::utils::points::vec3;
 
     struct projection_options {
         function<bool(double)> db_filter;
-        observed_factor_func& factor_func;
+        const VerticalGaussKernel& vertical_weights;
         double vertical_angle_limit;
         size_t steps_per_angle;
     };
 
+    struct raw_and_filtered_points {
+        shared_ptr<vector<ScoredPoint>> raw;
+        shared_ptr<vector<ScoredPoint>> filtered;
+    };
+
     class DataPointProjector {
     private:
+        /**
+         * Buffers of one cell, reused for all cells of a projection.
+         */
+        struct cell_samples {
+            vector<double> angles;
+            vector<double> distances;
+            vector<observed_point> points;
+        };
+
+        /**
+         * Randomly distributed samples within the angle and range cell around the given indices,
+         * replaces the points of the samples.
+         */
+        void sample_cell(const vector<rcs_angle_t>& angles,
+                         const vector<rcs_distance_t>& distances,
+                         size_t angle_index,
+                         size_t distance_index,
+                         double distance_step,
+                         const projection_options& projection_params,
+                         cell_samples& samples) const;
 
         template<typename ValueType>
-        [[nodiscard]] auto get_range(const vector<ValueType>& source_values,
-                                     const size_t index,
-                                     double step_size) const -> vector<double> {
+        void get_range(const vector<ValueType>& source_values,
+                       const size_t index,
+                       double step_size,
+                       vector<double>& result) const {
             assert(source_values.size() > 2);
 
-            vector<double> result;
+            result.clear();
             const double first = source_values.at(0);
             const double last = source_values.at(source_values.size() - 1);
 
@@ -57,7 +84,6 @@ namespace rcsop::data {
                 result.push_back(value);
                 value += step_size;
             }
-            return result;
         }
 
     public:
@@ -65,6 +91,14 @@ namespace rcsop::data {
                           const Observer& observer,
                           const projection_options& projection_params) const -> shared_ptr<vector<ScoredPoint>>;
 
+        /**
+         * Projects the raw and the peak filtered values in one pass. A sample is emitted into each table in
+         * which its cell passes the filter, with the same position and id in both.
+         */
+        auto project_data_both(const AbstractDataSet* data,
+                               const Observer& observer,
+                               const projection_options& projection_params) const -> raw_and_filtered_points;
+
     };
 
 } // data
@@ -1,9 +1,12 @@
 #ifndef RCSOP_DATA_INPUT_DATA_COLLECTOR_H
 #define RCSOP_DATA_INPUT_DATA_COLLECTOR_H
 
+#include <mutex>
+
 #include "utils/types.h"
 
 #include "sparse_cloud.h"
+#include "sparse_cloud_reader.h"
 #include "dense_cloud.h"
 #include "basic_rcs_map.h"
 #include "azimuth_rcs_data_collection.h"
@@ -23,14 +26,28 @@ namespace rcsop::data {
         SIMPLE_RCS_MAT = 2,
         AZIMUTH_RCS_MAT = 3,
         AZIMUTH_RCS_MINIMAP = 4,
+        SPARSE_POINTS_COLMAP = 5,
     };
 
-    static const char* inputAssetTypeDescriptions[5] = {
+    static const char* inputAssetTypeDescriptions[6] = {
             "Sparse cloud (COLMAP)",
             "Dense mesh (.ply)",
             "RCS sums (rcs.mat)",
             "Azimuth RCS values",
             "Azimuth RCS preview minimaps",
+            "Sparse cloud points and cameras (COLMAP, read-only)",
+    };
+
+    /**
+     * How a loaded asset may be kept in memory while assets are resident.
+     */
+    enum AssetResidency {
+        // modified by its users (e.g. points added by a ModelWriter), loaded on every access
+        LOAD_ON_ACCESS = 0,
+        // read-only, every access shares the same instance
+        SHARED = 1,
+        // settings of the instance are changed by its users, every access gets a (cheap) copy
+        COPIED = 2,
     };
 
     template<InputAssetType T>
@@ -40,26 +57,37 @@ namespace rcsop::data {
     template<>
     struct InputAssetTrait<SPARSE_CLOUD_COLMAP> {
         using type = rcsop::common::SparseCloud;
+        static constexpr AssetResidency residency = LOAD_ON_ACCESS;
+    };
+
+    template<>
+    struct InputAssetTrait<SPARSE_POINTS_COLMAP> {
+        using type = rcsop::common::SparseCloudReader;
+        static constexpr AssetResidency residency = SHARED;
     };
 
     template<>
     struct InputAssetTrait<DENSE_MESH_PLY> {
         using type = rcsop::common::DenseCloud;
+        static constexpr AssetResidency residency = SHARED;
     };
 
     template<>
     struct InputAssetTrait<SIMPLE_RCS_MAT> {
         using type = rcsop::data::BasicRcsMap;
+        static constexpr AssetResidency residency = SHARED;
     };
 
     template<>
     struct InputAssetTrait<AZIMUTH_RCS_MAT> {
         using type = rcsop::data::AzimuthRcsDataCollection;
+        static constexpr AssetResidency residency = COPIED;
     };
 
     template<>
     struct InputAssetTrait<AZIMUTH_RCS_MINIMAP> {
         using type = rcsop::data::AzimuthMinimapProvider;
+        static constexpr AssetResidency residency = SHARED;
     };
 
     template<InputAssetType T>
@@ -76,6 +104,7 @@ namespace rcsop::data {
                 {InputAssetType::SIMPLE_RCS_MAT,      vector<path>{}},
                 {InputAssetType::AZIMUTH_RCS_MAT,     vector<path>{}},
                 {InputAssetType::AZIMUTH_RCS_MINIMAP, vector<path>{}},
+                {InputAssetType::SPARSE_POINTS_COLMAP, vector<path>{}},
         };
 
         void collect_images(const camera_options& options);
@@ -84,11 +113,83 @@ namespace rcsop::data {
 
         void collect_rcs_data();
 
+        struct resident_value {
+            std::mutex lock;
+            shared_ptr<void> value;
+        };
+
+        struct resident_storage {
+            std::mutex lock;
+            map<string, shared_ptr<resident_value>> values;
+        };
+
+        // only set while assets are kept resident, shared by all copies of the collector
+        shared_ptr<resident_storage> _resident = nullptr;
+
+        template<InputAssetType AssetType>
+        [[nodiscard]] auto load_asset(const path& asset_path) const -> shared_ptr<InputAssetDataType<AssetType>> {
+            using ReturnAssetType = InputAssetDataType<AssetType>;
+            constexpr auto residency = InputAssetTrait<AssetType>::residency;
+            if constexpr (residency == LOAD_ON_ACCESS) {
+                return make_shared<ReturnAssetType>(asset_path);
+            } else {
+                auto asset = resident<ReturnAssetType>(
+                        "asset:" + std::to_string(AssetType) + ":" + asset_path.string(),
+                        [&asset_path]() {
+                            return make_shared<ReturnAssetType>(asset_path);
+                        });
+                if constexpr (residency == COPIED) {
+                    return make_shared<ReturnAssetType>(*asset);
+                } else {
+                    return asset;
+                }
+            }
+        }
+
     public:
         InputDataCollector(const path& root_path, const camera_options& options);
 
         [[nodiscard]] vector<CameraInputImage> images() const;
 
+        /**
+         * Keeps loaded assets and the values passed to resident() in memory for all later accesses,
+         * used while serving many jobs on the same inputs.
+         */
+        void keep_resident();
+
+        /**
+         * Creates the value on the first access with the key, later accesses share it while the collector
+         * keeps values resident. Otherwise the value is created on every access.
+         * Concurrent first accesses with the same key wait for a single creation, other keys are not blocked.
+         */
+        template<typename ValueType>
+        [[nodiscard]] auto resident(const string& key,
+                                    const std::function<shared_ptr<ValueType>()>& create) const
+        -> shared_ptr<ValueType> {
+            if (_resident == nullptr) {
+                return create();
+            }
+            shared_ptr<resident_value> entry;
+            {
+                std::lock_guard guard(_resident->lock);
+                auto& stored_entry = _resident->values[key];
+                if (stored_entry == nullptr) {
+                    stored_entry = make_shared<resident_value>();
+                }
+                entry = stored_entry;
+            }
+            std::lock_guard guard(entry->lock);
+            if (entry->value == nullptr) {
+                entry->value = create();
+            }
+            return std::static_pointer_cast<ValueType>(entry->value);
+        }
+
+        /**
+         * Files or folders collected for an asset type, without reading them.
+         */
+        [[nodiscard]] vector<path> asset_paths(InputAssetType asset_type) const;
+
         template<InputAssetType AssetType, bool Multiple = false>
         [[nodiscard]] auto data() const {
             using ReturnAssetType = InputAssetDataType<AssetType>;
@@ -102,14 +203,14 @@ namespace rcsop::data {
                 map<string, shared_ptr<ReturnAssetType>> labeled_assets;
                 for (const auto& asset_path : asset_paths) {
                     string path_suffix = asset_path.filename().string();
-                    labeled_assets.insert(make_pair(path_suffix, make_shared<ReturnAssetType>(asset_path)));
+                    labeled_assets.insert(make_pair(path_suffix, load_asset<AssetType>(asset_path)));
                 }
                 return labeled_assets;
             } else {
                 vector<shared_ptr<ReturnAssetType>> result;
                 for (const auto& path : asset_paths) {
                     if (ReturnAssetType::is_available_at(path)) {
-                        result.push_back(make_shared<ReturnAssetType>(path));
+                        result.push_back(load_asset<AssetType>(path));
                     }
                 }
                 if (result.size() > 1) {
@@ -0,0 +1,38 @@
+#ifndef RCSOP_DATA_PLY_POINT_CLOUD_WRITER_H
+#define RCSOP_DATA_PLY_POINT_CLOUD_WRITER_H
+
+#include "scored_cloud.h"
+#include "output_data_writer.h"
+
+namespace rcsop::data {
+    using rcsop::common::scored_cloud_payload;
+    using rcsop::common::OutputDataWriter;
+    using rcsop::common::ScoredPoint;
+    using rcsop::common::Observer;
+    using rcsop::common::height_t;
+    using rcsop::common::coloring::global_colormap_func;
+
+    /**
+     * Streams a scored point cloud into a binary little-endian PLY file with position, color, raw score and dB.
+     * Points are encoded in fixed-size chunks, so the memory needed on top of the payload stays constant.
+     */
+    class PlyPointCloudWriter : public OutputDataWriter {
+    private:
+        Observer _observer;
+        shared_ptr<vector<ScoredPoint>> _points;
+        global_colormap_func _color_map;
+
+    public:
+        explicit PlyPointCloudWriter(const scored_cloud_payload& payload);
+
+        void write(const path& output_path, const string& log_prefix) override;
+
+        [[nodiscard]] bool observer_has_position() const override;
+
+        [[nodiscard]] height_t observer_height() const override;
+
+        [[nodiscard]] string path_prefix() const override;
+    };
+}
+
+#endif //RCSOP_DATA_PLY_POINT_CLOUD_WRITER_H
@@ -14,7 +14,7 @@ namespace rcsop::data {
     using rcsop::common::utils::points::point_id_t;
     using rcsop::common::utils::points::vec3;
 
-    using rcsop::common::SparseCloud;
+    using rcsop::common::SparseCloudReader;
     using rcsop::common::SimplePoint;
     using rcsop::common::DenseCloud;
     using rcsop::common::camera_options;
@@ -27,7 +27,7 @@ namespace rcsop::data {
 
     class PointCloudProvider {
     private:
-        shared_ptr<SparseCloud> sparse_cloud = nullptr;
+        shared_ptr<SparseCloudReader> sparse_cloud = nullptr;
         shared_ptr<vector<SimplePoint>> sparse_cloud_points = make_shared<vector<SimplePoint>>();
         point_id_t max_sparse_point_id = 0;
 
@@ -44,8 +44,17 @@ namespace rcsop::data {
         explicit PointCloudProvider(const InputDataCollector& input,
                                     const camera_options& camera_options);
 
+        /**
+         * Points of the selected reconstructions, thinned to the given minimum spacing in centimeters (if positive).
+         */
         [[nodiscard]] auto get_base_points(ReconstructionType cloud_selection = ReconstructionType::COMPLETE,
-                                           size_t take_every_nth = 1) const -> shared_ptr<vector<SimplePoint>>;
+                                           double spacing_centimeters = 0) const -> shared_ptr<vector<SimplePoint>>;
+
+        /**
+         * Voxel-grid downsampling with a cell size in centimeters, returns the points unchanged if it is not positive.
+         */
+        [[nodiscard]] auto downsample(shared_ptr<vector<SimplePoint>> points,
+                                      double spacing_centimeters) const -> shared_ptr<vector<SimplePoint>>;
 
         [[nodiscard]] auto generate_homogenous_cloud(size_t points_per_meter) const -> shared_ptr<vector<SimplePoint>>;
 
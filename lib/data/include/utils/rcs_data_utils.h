@@ -2,11 +2,11 @@
 #define RCSOP_DATA_RCS_DATA_UTILS_H
 
 #include <regex>
-#include <execution>
 #include <mutex>
 
 #include "utils/types.h"
 #include "utils/chronometer.h"
+#include "utils/executor.h"
 
 #include "observer_position.h"
 #include "az_data.h"
@@ -82,19 +82,20 @@ namespace rcsop::data::utils {
 
         auto file_paths = find_mat_files_in_folder(height_folder.folder_path, data_file_regex, filename_azimuth_index);
         std::mutex map_mutex;
-        std::for_each(std::execution::par_unseq,
-                      begin(file_paths), end(file_paths),
-                      [&map_mutex, &azimuth_to_data, &height](const mat_path_with_azimuth& mat_file_entry) {
-                          auto data = AT(
-                                  mat_file_entry.file_path,
-                                  ObserverPosition{
-                                          .height = height,
-                                          .azimuth = mat_file_entry.azimuth,
-                                  });
-
-                          const std::lock_guard<std::mutex> lock(map_mutex);
-                          azimuth_to_data.insert(make_pair(mat_file_entry.azimuth, data));
-                      });
+        // the map is guarded by a lock, so the loop must not be vectorized
+        rcsop::common::utils::parallel::for_each<false>(
+                begin(file_paths), end(file_paths),
+                [&map_mutex, &azimuth_to_data, &height](const mat_path_with_azimuth& mat_file_entry) {
+                    auto data = AT(
+                            mat_file_entry.file_path,
+                            ObserverPosition{
+                                    .height = height,
+                                    .azimuth = mat_file_entry.azimuth,
+                            });
+
+                    const std::lock_guard<std::mutex> lock(map_mutex);
+                    azimuth_to_data.insert(make_pair(mat_file_entry.azimuth, data));
+                });
         return azimuth_to_data;
     }
 
@@ -65,8 +65,9 @@ namespace rcsop::data {
         return result;
     }
 
-    void AzimuthRcsDataSet::filter_peaks() {
-        for (const auto& [angle, raw_column]: _raw_values) {
+    az_value_map_t AzimuthRcsDataSet::filter_peaks() const {
+        az_value_map_t result;
+        for (const auto& [angle, raw_column]: *_raw_values) {
             double max_value = rcsop::common::utils::max_value(raw_column);
 
             vector<double> filtered_column = map_vec<double, double>(raw_column, [&max_value]
@@ -76,12 +77,14 @@ namespace rcsop::data {
                 }
                 return value;
             });
-            _filtered_values.insert(make_pair(angle, filtered_column));
+            result.insert(make_pair(angle, filtered_column));
         }
+        return result;
     }
 
     AzimuthRcsDataSet::AzimuthRcsDataSet(const path& filename,
-                                         const ObserverPosition& position) {
+                                         const ObserverPosition& position)
+            : _source_path(filename) {
         mat_t* mat_file_handle = Mat_Open(filename.c_str(), MAT_ACC_RDONLY);
         if (nullptr == mat_file_handle) {
             throw runtime_error("Could not open .mat file");
@@ -93,7 +96,7 @@ namespace rcsop::data {
 
         _angles = get_raw_values(TABLE_ANGLES, table);
         auto raw_azimuth = get_raw_values(TABLE_AZIMUTH_VALUES, table);
-        _raw_values = reconstruct_value_table(raw_azimuth);
+        _raw_values = make_shared<const az_value_map_t>(reconstruct_value_table(raw_azimuth));
 
         Mat_VarFree(table);
         Mat_Close(mat_file_handle);
@@ -101,27 +104,51 @@ namespace rcsop::data {
         _ranges.erase(_ranges.begin()); // first row contains only NaN
         _last_range_index = _ranges.size() - 1;
         _last_range_step = abs(_ranges[_last_range_index] - _ranges[_last_range_index - 1]);
-        filter_peaks();
+        _filtered_values = make_shared<const az_value_map_t>(filter_peaks());
     }
 
     rcs_value_t AzimuthRcsDataSet::resolve_value(rcs_angle_t angle,
                                                  size_t range_index) const {
-        const auto& value_map = (use_filtered) ? _filtered_values : _raw_values;
+        const auto& value_map = (use_filtered) ? *_filtered_values : *_raw_values;
         const auto& range_to_values = value_map.at(angle);
         return range_to_values[range_index];
     }
 
-    double AzimuthRcsDataSet::map_to_nearest(const observed_point& point) const {
+    raw_and_filtered_value AzimuthRcsDataSet::resolve_both(rcs_angle_t angle,
+                                                           size_t range_index) const {
+        return {
+                .raw = _raw_values->at(angle)[range_index],
+                .filtered = _filtered_values->at(angle)[range_index],
+        };
+    }
+
+    optional<pair<rcs_angle_t, size_t>> AzimuthRcsDataSet::find_nearest_cell(const observed_point& point) const {
         const long range_distance = lround(point.distance_in_world);
 
-        const rcs_angle_t nearest_angle = find_nearest(point.horizontal_angle, _angles);
+        const rcs_angle_t nearest_angle = find_nearest<rcs_angle_t>(point.horizontal_angle, _angles);
         const size_t nearest_range_index = find_nearest_index(range_distance, _ranges);
 
         const auto is_last = nearest_range_index == _last_range_index;
         const auto last_range = _ranges[_last_range_index];
         const auto out_of_range = (is_last && abs(last_range - range_distance) > _last_range_step);
+        if (out_of_range) {
+            return {};
+        }
+        return make_pair(nearest_angle, nearest_range_index);
+    }
+
+    double AzimuthRcsDataSet::map_to_nearest(const observed_point& point) const {
+        const auto cell = find_nearest_cell(point);
+        return cell.has_value() ? resolve_value(cell->first, cell->second) : nanf("Distance out of range.");
+    }
 
-        return out_of_range ? nanf("Distance out of range.") : resolve_value(nearest_angle, nearest_range_index);
+    raw_and_filtered_value AzimuthRcsDataSet::map_to_nearest_both(const observed_point& point) const {
+        const auto cell = find_nearest_cell(point);
+        if (!cell.has_value()) {
+            const rcs_value_t out_of_range = nanf("Distance out of range.");
+            return {.raw = out_of_range, .filtered = out_of_range};
+        }
+        return resolve_both(cell->first, cell->second);
     }
 
     void AzimuthRcsDataSet::use_filtered_peaks() {
@@ -133,6 +160,11 @@ namespace rcsop::data {
         return resolve_value(angle, nearest_range_index);
     }
 
+    raw_and_filtered_value AzimuthRcsDataSet::map_exact_both(rcs_distance_t distance, rcs_angle_t angle) const {
+        const size_t nearest_range_index = find_nearest_index(distance, _ranges);
+        return resolve_both(angle, nearest_range_index);
+    }
+
     vector<rcs_distance_t> AzimuthRcsDataSet::distances() const {
         return this->_ranges;
     }
@@ -141,6 +173,10 @@ namespace rcsop::data {
         return this->_angles;
     }
 
+    path AzimuthRcsDataSet::source_path() const {
+        return this->_source_path;
+    }
+
     rcs_distance_t AzimuthRcsDataSet::distance_step() const {
         return this->_last_range_step;
     }
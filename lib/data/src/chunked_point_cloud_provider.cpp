@@ -0,0 +1,157 @@
+#include "chunked_point_cloud_provider.h"
+
+#include <random>
+
+#include "utils/chronometer.h"
+#include "observer_provider.h"
+
+namespace rcsop::data {
+    using rcsop::common::utils::time::start_time;
+    using rcsop::common::utils::time::log_and_start_next;
+    using rcsop::common::VectorPointSource;
+    using rcsop::common::PlyVertexSource;
+    using rcsop::common::ChainedPointSource;
+    using rcsop::common::get_bounds;
+
+    static auto count_cells(double begin, double end, double step_size) -> size_t {
+        if (end <= begin) {
+            return 0;
+        }
+        return static_cast<size_t>(std::ceil((end - begin) / step_size));
+    }
+
+    HomogenousPointSource::HomogenousPointSource(const vec3& begin,
+                                                 const vec3& end,
+                                                 double step_size,
+                                                 double radius_limit,
+                                                 size_t chunk_size)
+            : _begin(begin),
+              _cells{count_cells(begin.x(), end.x(), step_size),
+                     count_cells(begin.y(), end.y(), step_size),
+                     count_cells(begin.z(), end.z(), step_size)},
+              _step_size(step_size),
+              _radius_limit(radius_limit),
+              _chunk_size(chunk_size),
+              _seed(std::random_device()()) {}
+
+    size_t HomogenousPointSource::cell_count() const {
+        return _cells[0] * _cells[1] * _cells[2];
+    }
+
+    size_t HomogenousPointSource::chunk_count() const {
+        const auto cells = cell_count();
+        if (cells == 0) {
+            return 0;
+        }
+        return _chunk_size == 0 ? 1 : (cells + _chunk_size - 1) / _chunk_size;
+    }
+
+    point_chunk HomogenousPointSource::read_chunk(size_t chunk_index, vector<SimplePoint>& buffer) const {
+        if (chunk_index >= chunk_count()) {
+            throw invalid_argument("Chunk " + std::to_string(chunk_index) + " of "
+                                   + std::to_string(chunk_count()) + " requested.");
+        }
+        const size_t first_cell = _chunk_size == 0 ? 0 : chunk_index * _chunk_size;
+        const size_t end_cell = _chunk_size == 0 ? cell_count() : std::min(first_cell + _chunk_size, cell_count());
+
+        std::seed_seq chunk_seed{_seed, static_cast<unsigned int>(chunk_index),
+                                 static_cast<unsigned int>(chunk_index >> 32)};
+        std::mt19937 generator(chunk_seed);
+        std::uniform_real_distribution<double> jitter(-_step_size, _step_size);
+
+        buffer.clear();
+        for (size_t cell = first_cell; cell < end_cell; cell++) {
+            const auto x = static_cast<double>(cell / (_cells[1] * _cells[2]));
+            const auto y = static_cast<double>((cell / _cells[2]) % _cells[1]);
+            const auto z = static_cast<double>(cell % _cells[2]);
+            const vec3 lattice_point = _begin + vec3(x, y, z) * _step_size;
+            const vec3 point_vector = lattice_point + vec3(jitter(generator), jitter(generator), jitter(generator));
+            if (point_vector.norm() <= _radius_limit) {
+                buffer.emplace_back(static_cast<point_id_t>(cell), point_vector);
+            }
+        }
+        return buffer;
+    }
+
+    ChunkedPointCloudProvider::ChunkedPointCloudProvider(const InputDataCollector& input,
+                                                         const camera_options& camera_options,
+                                                         size_t chunk_size)
+            : _chunk_size(chunk_size),
+              _distance_to_origin(camera_options.distance_to_origin) {
+        if (input.data_available<SPARSE_POINTS_COLMAP>()) {
+            _sparse_cloud_points = input.data<SPARSE_POINTS_COLMAP>()->get_points();
+            for (const auto& point: *_sparse_cloud_points) {
+                _max_sparse_point_id = std::max(_max_sparse_point_id, point.id());
+            }
+
+            auto observer_provider = ObserverProvider(input, camera_options, false);
+            _units_per_centimeter = observer_provider.get_units_per_centimeter();
+        }
+        vector<path> mesh_paths;
+        for (const auto& mesh_path: input.asset_paths(InputAssetType::DENSE_MESH_PLY)) {
+            if (DenseCloud::is_available_at(mesh_path)) {
+                mesh_paths.push_back(mesh_path);
+            }
+        }
+        if (mesh_paths.size() > 1) {
+            throw domain_error(string("More than one set of data: ") + inputAssetTypeDescriptions[DENSE_MESH_PLY]);
+        }
+        if (!mesh_paths.empty()) {
+            _dense_mesh_path = mesh_paths.front();
+        }
+    }
+
+    auto ChunkedPointCloudProvider::dense_points() const -> shared_ptr<PointSource> {
+        const point_id_t first_id = _max_sparse_point_id + 1;
+        if (auto vertices = PlyVertexSource::open(*_dense_mesh_path, _chunk_size, first_id)) {
+            std::clog << "Streaming " << vertices->vertex_count() << " vertices of "
+                      << _dense_mesh_path->filename().string() << " in " << vertices->chunk_count()
+                      << " chunks" << std::endl;
+            return vertices;
+        }
+        // only binary PLY files can be decoded in parts, the others have to be read through CGAL
+        std::clog << "Warning: " << _dense_mesh_path->filename().string()
+                  << " is not a binary PLY file, reading all vertices at once." << std::endl;
+        const auto mesh_points = DenseCloud(*_dense_mesh_path).get_points();
+        auto renumbered_points = make_shared<vector<SimplePoint>>();
+        renumbered_points->reserve(mesh_points->size());
+        auto dense_point_id = first_id;
+        for (const auto& point: *mesh_points) {
+            renumbered_points->emplace_back(dense_point_id++, point.position());
+        }
+        return make_shared<VectorPointSource>(renumbered_points, _chunk_size);
+    }
+
+    auto ChunkedPointCloudProvider::get_base_points(
+            ReconstructionType cloud_selection) const -> shared_ptr<PointSource> {
+        vector<shared_ptr<const PointSource>> sources;
+        if ((cloud_selection & ReconstructionType::SPARSE_CLOUD) != 0) {
+            sources.push_back(make_shared<VectorPointSource>(_sparse_cloud_points, _chunk_size));
+        }
+        if ((cloud_selection & ReconstructionType::DENSE_CLOUD) != 0 && _dense_mesh_path.has_value()) {
+            sources.push_back(dense_points());
+        }
+        return make_shared<ChainedPointSource>(sources);
+    }
+
+    auto ChunkedPointCloudProvider::generate_homogenous_cloud(
+            size_t points_per_meter) const -> shared_ptr<PointSource> {
+        const double units_per_meter = _units_per_centimeter * 100;
+        const double step_size_meters = 1. / static_cast<double>(points_per_meter);
+        const double step_size = step_size_meters * units_per_meter;
+        const double radius_limit = _distance_to_origin * _units_per_centimeter * 1.5;
+
+        auto time = start_time();
+        const auto model_bounds = get_bounds(*get_base_points());
+        if (!model_bounds.has_value()) {
+            throw runtime_error("No model points to limit the generated cloud.");
+        }
+        const vec3 limit = vec3::Constant(radius_limit);
+        const vec3 begin = model_bounds->first.cwiseMax(-limit);
+        const vec3 end = model_bounds->second.cwiseMin(limit);
+        auto result = make_shared<HomogenousPointSource>(begin, end, step_size, radius_limit, _chunk_size);
+        log_and_start_next(time, "Prepared a lattice of " + std::to_string(result->cell_count()) + " cells in "
+                                 + std::to_string(result->chunk_count()) + " chunks");
+        return result;
+    }
+}
@@ -4,20 +4,24 @@
 
 namespace rcsop::data {
     using rcsop::common::utils::points::point_id_t;
+    using rcsop::common::utils::points::stored_vec3;
+    using rcsop::common::utils::points::storage_scalar_t;
+    using rcsop::common::utils::points::to_storage;
     using rcsop::common::utils::rcs::raw_rcs_to_dB;
     using rcsop::common::utils::get_uniform_distribution;
 
-    static auto combine_ranges(const vector<double>& angles,
+    static void combine_ranges(const vector<double>& angles,
                                const vector<double>& distances,
                                const double angle_step,
                                const double distance_epsilon,
-                               const double secondary_angle_limit) -> vector<observed_point> {
+                               const double secondary_angle_limit,
+                               vector<observed_point>& points) {
 
         auto half_step{angle_step / 2.};
         auto angle_noise = get_uniform_distribution(half_step, true);
         auto distance_noise = get_uniform_distribution(distance_epsilon, true);
 
-        vector<observed_point> points;
+        points.clear();
         for (auto primary_angle: angles) {
             for (auto ranged_distance: distances) {
                 double secondary_angle{-secondary_angle_limit};
@@ -31,17 +35,34 @@ namespace rcsop::data {
                         continue;
                     }
                     observed_point point{
-                            .position = common::utils::points::vec3::Zero(),
+                            .position = stored_vec3::Zero(),
                             .id = 0,
-                            .distance_in_world = distance,
-                            .vertical_angle = vertical_angle,
-                            .horizontal_angle = horizontal_angle,
+                            .distance_in_world = static_cast<storage_scalar_t>(distance),
+                            .vertical_angle = static_cast<storage_scalar_t>(vertical_angle),
+                            .horizontal_angle = static_cast<storage_scalar_t>(horizontal_angle),
                     };
                     points.push_back(point);
                 }
             }
         }
-        return points;
+    }
+
+    void DataPointProjector::sample_cell(const vector<rcs_angle_t>& angles,
+                                         const vector<rcs_distance_t>& distances,
+                                         size_t angle_index,
+                                         size_t distance_index,
+                                         double distance_step,
+                                         const projection_options& projection_params,
+                                         cell_samples& samples) const {
+        const auto angle_step = 1. / static_cast<double>(projection_params.steps_per_angle);
+        get_range(distances, distance_index, distance_step, samples.distances);
+        get_range(angles, angle_index, angle_step, samples.angles);
+        combine_ranges(samples.angles,
+                       samples.distances,
+                       angle_step,
+                       distance_step / 2 - STANDARD_ERROR,
+                       projection_params.vertical_angle_limit,
+                       samples.points);
     }
 
     auto DataPointProjector::project_data(const AbstractDataSet* data,
@@ -49,10 +70,10 @@ namespace rcsop::data {
                                           const projection_options& projection_params) const
     -> shared_ptr<vector<ScoredPoint>> {
         const auto angles = data->angles();
-        const auto angle_step = 1. / static_cast<double>(projection_params.steps_per_angle);
         const auto distances = data->distances();
         const auto distance_step = static_cast<double>(data->distance_step());
         const auto& db_filter = projection_params.db_filter;
+        const auto& vertical_weights = projection_params.vertical_weights;
 
         auto data_filter = [&db_filter](rcs_value_t rcs_value) -> bool {
             const auto db_value = raw_rcs_to_dB(rcs_value);
@@ -60,6 +81,7 @@ namespace rcsop::data {
         };
 
         auto points = make_shared<vector<ScoredPoint>>();
+        cell_samples samples;
         point_id_t id{0};
         for (size_t angle_idx{0}; angle_idx < angles.size(); angle_idx++) {
             const auto angle = angles.at(angle_idx);
@@ -71,23 +93,70 @@ namespace rcsop::data {
                     continue;
                 }
 
-                auto distance_range = get_range(distances, distance_idx, distance_step);
-                auto angle_range = get_range(angles, angle_idx, angle_step);
-                auto points_in_ranges = combine_ranges(angle_range,
-                                                       distance_range,
-                                                       angle_step,
-                                                       distance_step / 2 - STANDARD_ERROR,
-                                                       projection_params.vertical_angle_limit);
-                for (auto& point: points_in_ranges) {
+                sample_cell(angles, distances, angle_idx, distance_idx, distance_step, projection_params, samples);
+                for (auto& point: samples.points) {
                     point.id = id++;
-                    point.position = observer.project_position(point);
+                    const auto position = observer.project_position(point);
+                    point.position = to_storage(position);
 
-                    auto score = data_point * projection_params.factor_func(point);
-                    auto scored_point = ScoredPoint(point.position, point.id, score);
+                    auto score = data_point * vertical_weights(point);
+                    auto scored_point = ScoredPoint(position, point.id, score);
                     points->push_back(scored_point);
                 }
             }
         }
         return points;
     }
+
+    auto DataPointProjector::project_data_both(const AbstractDataSet* data,
+                                               const Observer& observer,
+                                               const projection_options& projection_params) const
+    -> raw_and_filtered_points {
+        const auto angles = data->angles();
+        const auto distances = data->distances();
+        const auto distance_step = static_cast<double>(data->distance_step());
+        const auto& db_filter = projection_params.db_filter;
+        const auto& vertical_weights = projection_params.vertical_weights;
+
+        auto data_filter = [&db_filter](rcs_value_t rcs_value) -> bool {
+            const auto db_value = raw_rcs_to_dB(rcs_value);
+            return db_filter(db_value);
+        };
+
+        raw_and_filtered_points result{
+                .raw = make_shared<vector<ScoredPoint>>(),
+                .filtered = make_shared<vector<ScoredPoint>>(),
+        };
+        cell_samples samples;
+        point_id_t id{0};
+        for (size_t angle_idx{0}; angle_idx < angles.size(); angle_idx++) {
+            const auto angle = angles.at(angle_idx);
+            for (size_t distance_idx{0}; distance_idx < distances.size(); distance_idx++) {
+                auto distance = distances.at(distance_idx);
+
+                const auto [raw_value, filtered_value] = data->map_exact_both(distance, angle);
+                const bool use_raw = data_filter(raw_value);
+                const bool use_filtered = data_filter(filtered_value);
+                if (!use_raw && !use_filtered) {
+                    continue;
+                }
+
+                sample_cell(angles, distances, angle_idx, distance_idx, distance_step, projection_params, samples);
+                for (auto& point: samples.points) {
+                    point.id = id++;
+                    const auto position = observer.project_position(point);
+                    point.position = to_storage(position);
+
+                    const auto weight = vertical_weights(point);
+                    if (use_raw) {
+                        result.raw->emplace_back(position, point.id, raw_value * weight);
+                    }
+                    if (use_filtered) {
+                        result.filtered->emplace_back(position, point.id, filtered_value * weight);
+                    }
+                }
+            }
+        }
+        return result;
+    }
 }
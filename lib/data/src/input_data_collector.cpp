@@ -41,6 +41,7 @@ namespace rcsop::data {
             const path& entry_path = dir_entry.path();
             if (is_directory(entry_path)) {
                 this->_asset_paths.at(InputAssetType::SPARSE_CLOUD_COLMAP).push_back(entry_path);
+                this->_asset_paths.at(InputAssetType::SPARSE_POINTS_COLMAP).push_back(entry_path);
             }
             if (is_regular_file(entry_path) && entry_path.extension().string() == ".ply") {
                 this->_asset_paths.at(InputAssetType::DENSE_MESH_PLY).push_back(entry_path);
@@ -69,4 +70,14 @@ namespace rcsop::data {
     auto InputDataCollector::images() const -> vector<CameraInputImage> {
         return this->_images;
     }
+
+    void InputDataCollector::keep_resident() {
+        if (this->_resident == nullptr) {
+            this->_resident = make_shared<resident_storage>();
+        }
+    }
+
+    auto InputDataCollector::asset_paths(InputAssetType asset_type) const -> vector<path> {
+        return this->_asset_paths.at(asset_type);
+    }
 }
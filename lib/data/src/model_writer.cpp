@@ -6,6 +6,8 @@
 namespace rcsop::data {
     using rcsop::common::utils::time::start_time;
     using rcsop::common::utils::time::log_and_start_next;
+    using rcsop::common::utils::map_vec;
+    using rcsop::common::ScoredPoint;
 
     ModelWriter::ModelWriter(shared_ptr<BasePointCloud> target)
             : _target_model(std::move(target)) {
@@ -13,11 +15,11 @@ namespace rcsop::data {
     }
 
     void ModelWriter::add_points(const scored_cloud_payload& payload) {
-        for (const auto& point: *(payload.point_cloud.points())) {
-            _target_model->add_point(
-                    &point,
-                    payload.color_map(point.score_to_dB())
-            );
+        const auto& points = *(payload.point_cloud.points());
+        const auto dB_values = map_vec<ScoredPoint, double>(points, &ScoredPoint::score_to_dB);
+        const auto colors = payload.color_map.map_values(dB_values);
+        for (size_t index = 0; index < points.size(); index++) {
+            _target_model->add_point(&points[index], colors[index]);
         }
 
         _point_count = _target_model->point_count();
@@ -219,10 +219,10 @@ namespace rcsop::data {
     ObserverProvider::ObserverProvider(const InputDataCollector& input,
                                        const camera_options& camera_options,
                                        bool fill_in_missing_observers) {
-        if (!input.data_available<SPARSE_CLOUD_COLMAP>()) {
+        if (!input.data_available<SPARSE_POINTS_COLMAP>()) {
             throw invalid_argument("No COLMAP model");
         }
-        auto model = input.data<SPARSE_CLOUD_COLMAP>();
+        auto model = input.data<SPARSE_POINTS_COLMAP>();
         auto cameras = model->get_cameras();
 
         this->_units_per_centimeter = calculate_units_per_centimeter(camera_options, cameras);
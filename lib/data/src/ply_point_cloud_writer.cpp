@@ -0,0 +1,127 @@
+#include "ply_point_cloud_writer.h"
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+#include "utils/chronometer.h"
+#include "utils/mapping.h"
+
+namespace rcsop::data {
+    namespace parallel = rcsop::common::utils::parallel;
+
+    using rcsop::common::utils::time::start_time;
+    using rcsop::common::utils::time::log_and_start_next;
+    using rcsop::common::utils::sparse::color_vec;
+
+    static_assert(std::endian::native == std::endian::little,
+                  "PLY output is written as binary_little_endian straight from memory");
+
+    const static size_t POINTS_PER_CHUNK = 1 << 16;
+
+    // x, y, z, red, green, blue, alpha, score, dB
+    const static size_t VERTEX_BYTES = 3 * sizeof(float) + 4 * sizeof(uint8_t) + 2 * sizeof(float);
+
+    static auto construct_header(size_t vertex_count) -> string {
+        std::stringstream header;
+        header << "ply\n"
+               << "format binary_little_endian 1.0\n"
+               << "comment RCSOP scored point cloud\n"
+               << "element vertex " << vertex_count << "\n"
+               << "property float x\n"
+               << "property float y\n"
+               << "property float z\n"
+               << "property uchar red\n"
+               << "property uchar green\n"
+               << "property uchar blue\n"
+               << "property uchar alpha\n"
+               << "property float score\n"
+               << "property float db\n"
+               << "end_header\n";
+        return header.str();
+    }
+
+    static inline void encode_vertex(const ScoredPoint& point,
+                                     const global_colormap_func& color_map,
+                                     char* target) {
+        const auto position = point.position();
+        const auto dB = point.score_to_dB();
+        const color_vec color = color_map(dB);
+
+        const float values[3] = {
+                static_cast<float>(position.x()),
+                static_cast<float>(position.y()),
+                static_cast<float>(position.z()),
+        };
+        const uint8_t color_values[4] = {color.x(), color.y(), color.z(), color.w()};
+        const float scores[2] = {
+                static_cast<float>(point.score()),
+                static_cast<float>(dB),
+        };
+        std::memcpy(target, values, sizeof(values));
+        std::memcpy(target + sizeof(values), color_values, sizeof(color_values));
+        std::memcpy(target + sizeof(values) + sizeof(color_values), scores, sizeof(scores));
+    }
+
+    PlyPointCloudWriter::PlyPointCloudWriter(const scored_cloud_payload& payload)
+            : _observer(payload.point_cloud.observer()),
+              _points(payload.point_cloud.points()),
+              _color_map(payload.color_map) {}
+
+    void PlyPointCloudWriter::write(const path& output_path,
+                                    const string& log_prefix) {
+        auto time_measure = start_time();
+
+        if (!observer_has_position()) {
+            throw std::domain_error("Observer position needed for the output file name");
+        }
+        const string file_name = "data-" + _observer.position().str() + ".ply";
+        const path output_file_path{output_path / file_name};
+
+        std::ofstream output(output_file_path, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            throw runtime_error("Could not open " + output_file_path.string() + " for writing");
+        }
+        const auto& points = *_points;
+        const auto header = construct_header(points.size());
+        output.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+        const auto chunk_capacity = std::min(POINTS_PER_CHUNK, points.size());
+        vector<char> chunk_buffer(chunk_capacity * VERTEX_BYTES);
+        vector<size_t> chunk_indices(chunk_capacity);
+        std::iota(chunk_indices.begin(), chunk_indices.end(), 0);
+
+        for (size_t chunk_begin = 0; chunk_begin < points.size(); chunk_begin += chunk_capacity) {
+            const auto chunk_size = std::min(chunk_capacity, points.size() - chunk_begin);
+            parallel::for_each<false>(
+                    chunk_indices.cbegin(), chunk_indices.cbegin() + static_cast<long>(chunk_size),
+                    [this, &points, &chunk_buffer, chunk_begin](const size_t index) {
+                        encode_vertex(points[chunk_begin + index], _color_map,
+                                      chunk_buffer.data() + index * VERTEX_BYTES);
+                    });
+            output.write(chunk_buffer.data(), static_cast<std::streamsize>(chunk_size * VERTEX_BYTES));
+        }
+        if (!output) {
+            throw runtime_error("Could not write " + output_file_path.string());
+        }
+
+        log_and_start_next(time_measure, log_prefix + "\tOutput point cloud " + file_name
+                                         + " with " + std::to_string(points.size()) + " points");
+    }
+
+    bool PlyPointCloudWriter::observer_has_position() const {
+        return _observer.has_position();
+    }
+
+    height_t PlyPointCloudWriter::observer_height() const {
+        if (!observer_has_position()) {
+            throw std::domain_error("Observer position not set.");
+        }
+        return _observer.position().height;
+    }
+
+    string PlyPointCloudWriter::path_prefix() const {
+        return "ply";
+    }
+}
@@ -8,11 +8,13 @@
 
 #include "utils/mapping.h"
 #include "utils/chronometer.h"
+#include "utils/downsampling.h"
 #include "observer_provider.h"
 #include "utils/random.h"
 
 namespace rcsop::data {
     using rcsop::common::utils::points::point_pair;
+    using rcsop::common::utils::points::voxel_downsample;
     using rcsop::common::utils::time::start_time;
     using rcsop::common::utils::time::log_and_start_next;
     using rcsop::common::utils::map_vec;
@@ -21,8 +23,8 @@ namespace rcsop::data {
     PointCloudProvider::PointCloudProvider(const InputDataCollector& input,
                                            const camera_options& camera_options)
             : _distance_to_origin(camera_options.distance_to_origin) {
-        if (input.data_available<SPARSE_CLOUD_COLMAP>()) {
-            this->sparse_cloud = input.data<SPARSE_CLOUD_COLMAP>();
+        if (input.data_available<SPARSE_POINTS_COLMAP>()) {
+            this->sparse_cloud = input.data<SPARSE_POINTS_COLMAP>();
             this->sparse_cloud_points = sparse_cloud->get_points();
 
             auto point_ids = map_vec<SimplePoint, point_id_t>(*sparse_cloud_points, &SimplePoint::id);
@@ -49,9 +51,7 @@ namespace rcsop::data {
     }
 
     auto PointCloudProvider::get_base_points(ReconstructionType cloud_selection,
-                                             size_t take_every_nth) const -> shared_ptr<vector<SimplePoint>> {
-        assert(take_every_nth >= 1);
-
+                                             double spacing_centimeters) const -> shared_ptr<vector<SimplePoint>> {
         auto result = make_shared<vector<SimplePoint>>();
 
         if ((cloud_selection & ReconstructionType::SPARSE_CLOUD) != 0) {
@@ -65,13 +65,20 @@ namespace rcsop::data {
             }
         }
 
-        if (take_every_nth == 1) return result;
+        return downsample(result, spacing_centimeters);
+    }
 
-        auto filtered_result = make_shared<vector<SimplePoint>>();
-        for (size_t i = 0; i < result->size(); i += take_every_nth) {
-            filtered_result->push_back(result->at(i));
+    auto PointCloudProvider::downsample(shared_ptr<vector<SimplePoint>> points,
+                                        double spacing_centimeters) const -> shared_ptr<vector<SimplePoint>> {
+        if (spacing_centimeters <= 0 || points->empty()) {
+            return points;
         }
-        return filtered_result;
+        auto time = start_time();
+        auto result = voxel_downsample(*points, spacing_centimeters * _units_per_centimeter);
+        log_and_start_next(time, "Downsampled " + std::to_string(points->size()) + " to "
+                                 + std::to_string(result->size()) + " points with a spacing of "
+                                 + std::to_string(spacing_centimeters) + "cm");
+        return result;
     }
 
     auto PointCloudProvider::generate_homogenous_cloud(size_t points_per_meter) const -> shared_ptr<vector<SimplePoint>> {
@@ -9,12 +9,13 @@
 
 namespace rcsop::rendering {
     using rcsop::common::utils::points::vec2;
+    using rcsop::common::utils::points::stored_vec2;
     using rcsop::common::utils::sparse::color_vec;
     using rcsop::common::Observer;
     using rcsop::common::Texture;
 
     struct rendered_point {
-        vec2 coordinates = vec2::Zero();
+        stored_vec2 coordinates = stored_vec2::Zero();
         float size_factor = 1;
         color_vec color = color_vec::Zero();
     };
@@ -24,6 +25,17 @@ namespace rcsop::rendering {
         vec2 size = vec2::Zero();
     };
 
+    /**
+     * Finished image of a context. Encoding and writing it needs none of the resources of the renderer,
+     * so it can happen on any thread.
+     */
+    class BaseRenderedImage {
+    public:
+        virtual void write_to_image(const path& output_path) const = 0;
+
+        virtual ~BaseRenderedImage() = default;
+    };
+
     class BaseRendererContext {
     public:
         virtual void render_point(const rendered_point& point) = 0;
@@ -31,14 +43,37 @@ namespace rcsop::rendering {
         virtual void render_texture(const Texture& texture,
                                     const texture_rendering_options& options) = 0;
 
-        virtual void write_to_image(const path& output_path) = 0;
+        /**
+         * Ends the drawing on the thread of the renderer, the context is not to be used afterwards.
+         */
+        [[nodiscard]] virtual shared_ptr<const BaseRenderedImage> finish() = 0;
+
+        void write_to_image(const path& output_path) {
+            finish()->write_to_image(output_path);
+        }
 
         virtual ~BaseRendererContext() = default;
     };
 
+    /**
+     * Decoded source image of an observer, any number of contexts of the same renderer can be created from it.
+     */
+    class BaseBackground {
+    public:
+        virtual ~BaseBackground() = default;
+    };
+
     class BaseRenderer {
     public:
-        [[nodiscard]] virtual shared_ptr<BaseRendererContext> create_context(const Observer& observer) const = 0;
+        [[nodiscard]] virtual shared_ptr<const BaseBackground> decode_background(const Observer& observer) const = 0;
+
+        [[nodiscard]] virtual shared_ptr<BaseRendererContext> create_context(
+                const Observer& observer,
+                const BaseBackground& background) const = 0;
+
+        [[nodiscard]] shared_ptr<BaseRendererContext> create_context(const Observer& observer) const {
+            return create_context(observer, *decode_background(observer));
+        }
 
         virtual ~BaseRenderer() = default;
     };
@@ -12,7 +12,13 @@ namespace rcsop::rendering {
     public:
         explicit CairoRenderer(const gradient_options& options);
 
-        [[nodiscard]] shared_ptr<BaseRendererContext> create_context(const Observer& observer) const override;
+        using BaseRenderer::create_context;
+
+        [[nodiscard]] shared_ptr<const BaseBackground> decode_background(const Observer& observer) const override;
+
+        [[nodiscard]] shared_ptr<BaseRendererContext> create_context(
+                const Observer& observer,
+                const BaseBackground& background) const override;
     };
 }
 
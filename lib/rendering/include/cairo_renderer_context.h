@@ -11,15 +11,39 @@ namespace rcsop::rendering {
     using rcsop::common::Observer;
     using rcsop::common::Texture;
 
+    /**
+     * The decoded pixels without the surface, whose cairomm 1.0 reference count is not atomic and may not be
+     * copied by the contexts of several threads at once.
+     */
+    struct CairoBackground : public BaseBackground {
+        Cairo::Format format;
+        int width;
+        int height;
+        int stride;
+        vector<unsigned char> pixels;
+
+        explicit CairoBackground(const Cairo::RefPtr<Cairo::ImageSurface>& surface);
+    };
+
+    struct CairoRenderedImage : public BaseRenderedImage {
+        Cairo::RefPtr<Cairo::ImageSurface> surface;
+
+        explicit CairoRenderedImage(Cairo::RefPtr<Cairo::ImageSurface> surface)
+                : surface(std::move(surface)) {}
+
+        void write_to_image(const path& output_path) const override;
+    };
+
     class CairoRendererContext : public BaseRendererContext {
     private:
         const gradient_options _options;
 
-        Cairo::RefPtr<Cairo::Surface> _surface;
+        Cairo::RefPtr<Cairo::ImageSurface> _surface;
         Cairo::RefPtr<Cairo::Context> _cairo_context;
     public:
-        explicit CairoRendererContext(const Observer& observer,
-                                      const gradient_options& options);
+        CairoRendererContext(const Observer& observer,
+                             const CairoBackground& background,
+                             const gradient_options& options);
 
         ~CairoRendererContext() = default;
 
@@ -27,7 +51,7 @@ namespace rcsop::rendering {
 
         void render_texture(const Texture& texture, const texture_rendering_options& options) override;
 
-        void write_to_image(const path& output_path) override;
+        [[nodiscard]] shared_ptr<const BaseRenderedImage> finish() override;
 
     };
 }
@@ -2,6 +2,7 @@
 #define RCSOP_RENDERING_OBSERVER_RENDERER_H
 
 #include "utils/chronometer.h"
+#include "utils/scratch_arena.h"
 
 #include "observer.h"
 #include "colors.h"
@@ -10,6 +11,7 @@
 #include "rendering_options.h"
 #include "base_renderer.h"
 #include "output_data_writer.h"
+#include "pipelined_image_writer.h"
 #include "image_point.h"
 
 namespace rcsop::rendering {
@@ -20,10 +22,12 @@ namespace rcsop::rendering {
     using rcsop::common::OutputDataWriter;
     using rcsop::common::ModelCamera;
     using rcsop::common::ImagePoint;
+    using rcsop::common::utils::memory::ScopedScratch;
+    using rcsop::common::utils::memory::scratch_vector;
 
     using rcsop::common::coloring::global_colormap_func;
 
-    class ObserverRenderer : public OutputDataWriter {
+    class ObserverRenderer : public OutputDataWriter, public PipelinedImageWriter {
     private:
         Observer _observer;
 
@@ -34,17 +38,22 @@ namespace rcsop::rendering {
         global_colormap_func _color_map;
 
         shared_ptr<BaseRenderer> _renderer = nullptr;
+        shared_ptr<const BaseBackground> _background = nullptr;
 
         shared_ptr<vector<pair<texture_rendering_options, Texture>>> _textures;
 
-        [[nodiscard]] vector<rendered_point> project_points() const;
+        /**
+         * Projected and colored points sorted by their distance to the camera, from the scratch memory.
+         */
+        [[nodiscard]] auto project_points(const ScopedScratch& scratch) const -> scratch_vector<rendered_point>;
 
         [[nodiscard]] double get_point_perspective_scale(const common::ImagePoint& point) const;
 
-        [[nodiscard]] vector<rendered_point> project_in_camera_with_color(
-                const vector<ImagePoint>& points,
+        [[nodiscard]] auto project_in_camera_with_color(
+                const scratch_vector<ImagePoint>& points,
                 const ModelCamera& camera,
-                const global_colormap_func& color_map) const;
+                const global_colormap_func& color_map,
+                const ScopedScratch& scratch) const -> scratch_vector<rendered_point>;
 
     public:
         ObserverRenderer(const ScoredCloud& pointsWithObserver,
@@ -54,14 +63,40 @@ namespace rcsop::rendering {
 
         [[nodiscard]] height_t observer_height() const override;
 
+        /**
+         * Rasterizes and then encodes the image, the two steps of write can also run on different threads.
+         */
         void write(const path& output_path, const string& log_prefix) override;
 
+        /**
+         * Draws the points and textures onto the source image, on the thread the renderer belongs to.
+         */
+        [[nodiscard]] auto rasterize() const -> rendered_observer_image override;
+
+        /**
+         * Encodes an image of rasterize into the output folder, on any thread.
+         */
+        void write_image(const rendered_observer_image& rendered,
+                         const path& output_path,
+                         const string& log_prefix) const override;
+
         [[nodiscard]] string path_prefix() const override;
 
         [[nodiscard]] bool observer_has_position() const override;
 
         void add_texture(Texture texture, texture_rendering_options coordinates);
 
+        /**
+         * Decodes the source image of the observer for the renderer in use.
+         */
+        [[nodiscard]] auto decode_background() const -> shared_ptr<const BaseBackground> override;
+
+        /**
+         * Renders on top of an already decoded source image instead of decoding it again while writing,
+         * the background must stem from a renderer of the same kind.
+         */
+        void use_background(shared_ptr<const BaseBackground> background) override;
+
     };
 }
 
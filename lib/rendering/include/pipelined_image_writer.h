@@ -0,0 +1,46 @@
+#ifndef RCSOP_RENDERING_PIPELINED_IMAGE_WRITER_H
+#define RCSOP_RENDERING_PIPELINED_IMAGE_WRITER_H
+
+#include "utils/types.h"
+#include "utils/chronometer.h"
+
+#include "base_renderer.h"
+
+namespace rcsop::rendering {
+    using rcsop::common::utils::time::timer_seconds;
+
+    /**
+     * Drawn image of an observer, waiting to be encoded.
+     */
+    struct rendered_observer_image {
+        shared_ptr<const BaseRenderedImage> image;
+        size_t point_count = 0;
+        timer_seconds render_start;
+    };
+
+    /**
+     * Image output split into the steps the stages of render_pipelined run: decoding the source image,
+     * drawing on top of it and encoding the result.
+     */
+    class PipelinedImageWriter {
+    public:
+        virtual ~PipelinedImageWriter() = default;
+
+        /**
+         * Runs all steps one after the other on the calling thread.
+         */
+        virtual void write(const path& output_path, const string& log_prefix) = 0;
+
+        [[nodiscard]] virtual auto decode_background() const -> shared_ptr<const BaseBackground> = 0;
+
+        virtual void use_background(shared_ptr<const BaseBackground> background) = 0;
+
+        [[nodiscard]] virtual auto rasterize() const -> rendered_observer_image = 0;
+
+        virtual void write_image(const rendered_observer_image& rendered,
+                                 const path& output_path,
+                                 const string& log_prefix) const = 0;
+    };
+}
+
+#endif //RCSOP_RENDERING_PIPELINED_IMAGE_WRITER_H
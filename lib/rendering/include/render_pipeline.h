@@ -0,0 +1,32 @@
+#ifndef RCSOP_RENDERING_RENDER_PIPELINE_H
+#define RCSOP_RENDERING_RENDER_PIPELINE_H
+
+#include "utils/types.h"
+
+#include "pipelined_image_writer.h"
+
+namespace rcsop::rendering {
+    /**
+     * Background images decoded ahead of the rasterizer and drawn images waiting to be encoded.
+     */
+    const static size_t PIPELINE_QUEUE_CAPACITY = 2;
+    const static size_t PIPELINE_ENCODER_THREADS = 2;
+
+    struct render_job {
+        shared_ptr<PipelinedImageWriter> renderer;
+        path output_path;
+        string log_prefix;
+    };
+
+    /**
+     * Writes the images of all jobs in three stages connected by bounded queues: one thread decodes the source
+     * images of the next observers, the calling thread projects and draws the points, and further threads encode
+     * and write the finished images. The throughput is that of the slowest stage instead of the sum of all
+     * stages. All stages together use at most parallel::thread_count() threads including the calling one: with
+     * two the calling thread also encodes, with a single thread the jobs are written one after the other.
+     * The first error of any stage stops all stages and is rethrown.
+     */
+    void render_pipelined(const vector<render_job>& jobs);
+}
+
+#endif //RCSOP_RENDERING_RENDER_PIPELINE_H
@@ -12,6 +12,16 @@ namespace rcsop::rendering {
     using sf::RenderTarget;
     using sf::RenderTexture;
 
+    struct SfmlBackground : public BaseBackground {
+        sf::Image image;
+    };
+
+    struct SfmlRenderedImage : public BaseRenderedImage {
+        sf::Image image;
+
+        void write_to_image(const path& output_path) const override;
+    };
+
     class SfmlRendererContext : public BaseRendererContext {
     private:
         const gradient_options& _options;
@@ -20,16 +30,17 @@ namespace rcsop::rendering {
         unique_ptr<RenderTexture> _render_target;
 
     public:
-        explicit SfmlRendererContext(const Observer& observer,
-                                     shared_ptr<Shader> shader,
-                                     const gradient_options& options);
+        SfmlRendererContext(const Observer& observer,
+                            const SfmlBackground& background,
+                            shared_ptr<Shader> shader,
+                            const gradient_options& options);
 
         void render_point(const rendered_point& point) override;
 
         void render_texture(const Texture& texture,
                             const texture_rendering_options& options) override;
 
-        void write_to_image(const path& output_path) override;
+        [[nodiscard]] shared_ptr<const BaseRenderedImage> finish() override;
     };
 }
 #endif //RCSOP_RENDERING_SFML_RENDERER_CONTEXT_H
@@ -5,7 +5,13 @@ namespace rcsop::rendering {
     CairoRenderer::CairoRenderer(const gradient_options& options)
             : _options(options) {}
 
-    shared_ptr<BaseRendererContext> CairoRenderer::create_context(const Observer& observer) const {
-        return make_shared<CairoRendererContext>(observer, _options);
+    shared_ptr<const BaseBackground> CairoRenderer::decode_background(const Observer& observer) const {
+        return make_shared<CairoBackground>(Cairo::ImageSurface::create_from_png(observer.source_image_path()));
+    }
+
+    shared_ptr<BaseRendererContext> CairoRenderer::create_context(const Observer& observer,
+                                                                  const BaseBackground& background) const {
+        return make_shared<CairoRendererContext>(observer, dynamic_cast<const CairoBackground&>(background),
+                                                 _options);
     }
 }
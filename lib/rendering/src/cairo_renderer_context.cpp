@@ -1,11 +1,31 @@
 #include "cairo_renderer_context.h"
 
+#include <cstring>
+
 namespace rcsop::rendering {
+    CairoBackground::CairoBackground(const Cairo::RefPtr<Cairo::ImageSurface>& surface)
+            : format(surface->get_format()),
+              width(surface->get_width()),
+              height(surface->get_height()),
+              stride(surface->get_stride()) {
+        surface->flush();
+        const unsigned char* data = surface->get_data();
+        pixels.assign(data, data + static_cast<size_t>(stride) * static_cast<size_t>(height));
+    }
+
     CairoRendererContext::CairoRendererContext(
             const Observer& observer,
+            const CairoBackground& background,
             const gradient_options& options)
             : _options(options) {
-        this->_surface = Cairo::ImageSurface::create_from_png(observer.source_image_path());
+        // the decoded background is shared, every context draws on its own copy of its pixels
+        this->_surface = Cairo::ImageSurface::create(background.format, background.width, background.height);
+        if (_surface->get_stride() != background.stride) {
+            throw runtime_error("The background does not match the stride of the rendered surface.");
+        }
+        _surface->flush();
+        std::memcpy(_surface->get_data(), background.pixels.data(), background.pixels.size());
+        _surface->mark_dirty();
         this->_cairo_context = Cairo::Context::create(_surface);
     }
 
@@ -48,7 +68,14 @@ namespace rcsop::rendering {
         _cairo_context->paint();
     }
 
-    void CairoRendererContext::write_to_image(const path& output_path) {
-        _surface->write_to_png(output_path);
+    shared_ptr<const BaseRenderedImage> CairoRendererContext::finish() {
+        // the context holds on to the surface, the image must be its only user once it is handed over
+        _cairo_context = Cairo::RefPtr<Cairo::Context>();
+        _surface->flush();
+        return make_shared<CairoRenderedImage>(std::move(_surface));
+    }
+
+    void CairoRenderedImage::write_to_image(const path& output_path) const {
+        surface->write_to_png(output_path);
     }
 }
@@ -4,14 +4,20 @@
 
 #include <utility>
 
+#include "utils/tracing.h"
+#include "utils/executor.h"
+
 namespace rcsop::rendering {
+    namespace parallel = rcsop::common::utils::parallel;
+
     using std::isnan;
     using std::cerr;
 
     using rcsop::common::utils::time::start_time;
     using rcsop::common::utils::time::log_and_start_next;
-    using rcsop::common::utils::map_vec;
-    using rcsop::common::utils::sort_in_place;
+    using rcsop::common::utils::sparse::color_vec;
+    using rcsop::common::utils::points::to_storage;
+    using rcsop::common::utils::tracing::ScopedSpan;
 
     using rcsop::common::ModelCamera;
 
@@ -22,63 +28,97 @@ namespace rcsop::rendering {
                / atan(point.distance() / _reference_distance);
     }
 
-    vector<rendered_point> ObserverRenderer::project_in_camera_with_color(
-            const vector<ImagePoint>& points,
+    auto ObserverRenderer::project_in_camera_with_color(
+            const scratch_vector<ImagePoint>& points,
             const ModelCamera& camera,
-            const global_colormap_func& color_map) const {
-        return map_vec<ImagePoint, rendered_point>(points, [this, camera, color_map](const ImagePoint& point) {
-            auto camera_coordinates = camera.project_from_image(point.coordinates());
-            auto score = point.score();
-            if (isnan(score)) {
-                throw invalid_argument("Score of point is not a number");
-            }
-            auto color = color_map(point.score());
-            return rendered_point{
-                    .coordinates = camera_coordinates,
-                    .size_factor = static_cast<float>(get_point_perspective_scale(point)),
-                    .color = color
-            };
+            const global_colormap_func& color_map,
+            const ScopedScratch& scratch) const -> scratch_vector<rendered_point> {
+        auto scores = scratch.make_vector<double>(points.size());
+        std::transform(points.cbegin(), points.cend(), scores.begin(), [](const ImagePoint& point) {
+            return point.score();
         });
+        if (std::any_of(scores.cbegin(), scores.cend(), [](double score) { return isnan(score); })) {
+            throw invalid_argument("Score of point is not a number");
+        }
+        auto colors = scratch.make_vector<color_vec>(scores.size());
+        color_map.map_values(std::span<const double>(scores), std::span<color_vec>(colors));
+
+        auto rendered_points = scratch.make_vector<rendered_point>(points.size());
+        parallel::transform(points.cbegin(), points.cend(), colors.cbegin(), rendered_points.begin(),
+                            [this, &camera](const ImagePoint& point, const color_vec& color) {
+                                return rendered_point{
+                                        .coordinates = to_storage(camera.project_from_image(point.coordinates())),
+                                        .size_factor = static_cast<float>(get_point_perspective_scale(point)),
+                                        .color = color
+                                };
+                            });
+        return rendered_points;
     }
 
-    vector<rendered_point> ObserverRenderer::project_points() const {
+    auto ObserverRenderer::project_points(const ScopedScratch& scratch) const -> scratch_vector<rendered_point> {
         const auto& camera = _observer.native_camera();
-        auto img_points = camera.project_to_image(*_points);
-
-        sort_in_place<ImagePoint, double>(img_points, [](const ImagePoint& point) {
-            return point.distance();
-        });
-        auto rendered_points = project_in_camera_with_color(
-                img_points, camera, this->_color_map);
-        return rendered_points;
+        auto img_points = scratch.make_vector<ImagePoint>(_points->size());
+        camera.project_to_image(std::span<const ScoredPoint>(*_points), std::span<ImagePoint>(img_points));
+
+        parallel::sort(img_points.begin(), img_points.end(),
+                       [](const ImagePoint& a, const ImagePoint& b) {
+                           return a.distance() < b.distance();
+                       });
+        return project_in_camera_with_color(img_points, camera, this->_color_map, scratch);
     }
 
     void ObserverRenderer::write(const path& output_path,
                                  const string& log_prefix) {
-        auto time_measure = start_time();
+        ScopedSpan span("render_observer", [this]() {
+            return _observer.position().str();
+        });
+        write_image(rasterize(), output_path, log_prefix);
+    }
 
+    auto ObserverRenderer::rasterize() const -> rendered_observer_image {
+        const auto render_start = start_time();
+        const auto background = this->_background != nullptr ? this->_background : decode_background();
+        shared_ptr<BaseRendererContext> renderer_context = this->_renderer->create_context(_observer, *background);
+
+        // the projected points are released at once after they are drawn
+        const ScopedScratch scratch;
+        const auto rendered_points = [this, &scratch]() {
+            ScopedSpan projection_span("project_points");
+            return this->project_points(scratch);
+        }();
+
+        {
+            ScopedSpan rasterize_span("rasterize");
+            for (const auto& point: rendered_points) {
+                renderer_context->render_point(point);
+            }
+            for (const auto& [rendering_options, texture]: *_textures) {
+                renderer_context->render_texture(texture, rendering_options);
+            }
+        }
+        return {
+                .image = renderer_context->finish(),
+                .point_count = rendered_points.size(),
+                .render_start = render_start,
+        };
+    }
+
+    void ObserverRenderer::write_image(const rendered_observer_image& rendered,
+                                       const path& output_path,
+                                       const string& log_prefix) const {
         const auto& camera = _observer.native_camera();
-        const path input_file_path = _observer.source_image_path();
         const string file_name = "data-" + _observer.position().str() + "__source-" + camera.get_last_name_segment();
         const path output_file_path{output_path / file_name};
         string output_name = output_file_path.filename().string();
 
-        shared_ptr<BaseRendererContext> renderer_context = this->_renderer->create_context(_observer);
-
-        vector<rendered_point> rendered_points = this->project_points();
-
-        for (const auto& point: rendered_points) {
-            renderer_context->render_point(point);
-        }
-        for (const auto& [rendering_options, texture]: *_textures) {
-            renderer_context->render_texture(texture, rendering_options);
-        }
-
         create_directories(output_file_path.parent_path());
-        renderer_context->write_to_image(output_file_path);
+        {
+            ScopedSpan encode_span("encode_png", output_name);
+            rendered.image->write_to_image(output_file_path);
+        }
 
-        log_and_start_next(time_measure, log_prefix + "\tRendered image " + output_name
-                                         + " with " + std::to_string(rendered_points.size()) + " points");
+        log_and_start_next(rendered.render_start, log_prefix + "\tRendered image " + output_name
+                                                  + " with " + std::to_string(rendered.point_count) + " points");
     }
 
     ObserverRenderer::ObserverRenderer(
@@ -106,6 +146,17 @@ namespace rcsop::rendering {
         this->_textures->emplace_back(coordinates, texture);
     }
 
+    auto ObserverRenderer::decode_background() const -> shared_ptr<const BaseBackground> {
+        ScopedSpan span("decode_background", [this]() {
+            return _observer.position().str();
+        });
+        return this->_renderer->decode_background(_observer);
+    }
+
+    void ObserverRenderer::use_background(shared_ptr<const BaseBackground> background) {
+        this->_background = std::move(background);
+    }
+
     bool ObserverRenderer::observer_has_position() const {
         return this->_observer.has_position();
     }
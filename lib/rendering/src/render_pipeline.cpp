@@ -0,0 +1,121 @@
+#include "render_pipeline.h"
+
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "utils/bounded_queue.h"
+#include "utils/executor.h"
+#include "utils/tracing.h"
+
+namespace rcsop::rendering {
+    namespace parallel = rcsop::common::utils::parallel;
+
+    using rcsop::common::utils::BoundedQueue;
+    using rcsop::common::utils::tracing::ScopedSpan;
+
+    struct encode_item {
+        size_t job_index;
+        rendered_observer_image rendered;
+    };
+
+    /**
+     * First error of any stage, the queues are closed on it so all stages come to an end.
+     */
+    class pipeline_failure {
+    private:
+        std::mutex _lock;
+        std::exception_ptr _error = nullptr;
+
+    public:
+        template<typename... Queues>
+        void record(std::exception_ptr error, Queues& ... queues) {
+            {
+                const std::lock_guard guard(_lock);
+                if (_error == nullptr) {
+                    _error = std::move(error);
+                }
+            }
+            (queues.close(), ...);
+        }
+
+        void rethrow() {
+            if (_error != nullptr) {
+                std::rethrow_exception(_error);
+            }
+        }
+    };
+
+    void render_pipelined(const vector<render_job>& jobs) {
+        if (jobs.empty()) {
+            return;
+        }
+        if (parallel::thread_count() < 2) {
+            for (const auto& [renderer, output_path, log_prefix]: jobs) {
+                renderer->write(output_path, log_prefix);
+            }
+            return;
+        }
+
+        ScopedSpan span("render_pipeline");
+        BoundedQueue<size_t> decoded(PIPELINE_QUEUE_CAPACITY);
+        BoundedQueue<encode_item> rasterized(PIPELINE_QUEUE_CAPACITY);
+        pipeline_failure failure;
+
+        std::thread decoder([&jobs, &decoded, &rasterized, &failure]() {
+            try {
+                for (size_t job_index = 0; job_index < jobs.size(); job_index++) {
+                    const auto& renderer = jobs[job_index].renderer;
+                    renderer->use_background(renderer->decode_background());
+                    if (!decoded.push(job_index)) {
+                        return;
+                    }
+                }
+                decoded.close();
+            } catch (...) {
+                failure.record(std::current_exception(), decoded, rasterized);
+            }
+        });
+
+        // the calling thread and the decoder count against the thread limit, without room left the rasterizer
+        // encodes its images itself
+        const size_t encoder_count = std::min(parallel::thread_count() - 2, PIPELINE_ENCODER_THREADS);
+        vector<std::thread> encoders;
+        for (size_t i = 0; i < encoder_count; i++) {
+            encoders.emplace_back([&jobs, &decoded, &rasterized, &failure]() {
+                try {
+                    while (const auto item = rasterized.pop()) {
+                        const auto& job = jobs[item->job_index];
+                        job.renderer->write_image(item->rendered, job.output_path, job.log_prefix);
+                    }
+                } catch (...) {
+                    failure.record(std::current_exception(), decoded, rasterized);
+                }
+            });
+        }
+
+        // the rasterizer stays on the calling thread, the GPU renderer can only draw on the thread it was made on
+        try {
+            while (const auto job_index = decoded.pop()) {
+                const auto& renderer = jobs[*job_index].renderer;
+                auto rendered = renderer->rasterize();
+                renderer->use_background(nullptr);
+                if (encoders.empty()) {
+                    const auto& job = jobs[*job_index];
+                    renderer->write_image(rendered, job.output_path, job.log_prefix);
+                } else if (!rasterized.push({.job_index = *job_index, .rendered = std::move(rendered)})) {
+                    break;
+                }
+            }
+            rasterized.close();
+        } catch (...) {
+            failure.record(std::current_exception(), decoded, rasterized);
+        }
+
+        decoder.join();
+        for (auto& encoder: encoders) {
+            encoder.join();
+        }
+        failure.rethrow();
+    }
+}
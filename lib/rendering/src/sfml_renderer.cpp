@@ -32,7 +32,18 @@ namespace rcsop::rendering {
         }
     }
 
-    shared_ptr<BaseRendererContext> SfmlRenderer::create_context(const Observer& observer) const {
-        return make_shared<SfmlRendererContext>(observer, this->_shader, _options);
+    shared_ptr<const BaseBackground> SfmlRenderer::decode_background(const Observer& observer) const {
+        auto background = make_shared<SfmlBackground>();
+        const path input_file_path = observer.source_image_path();
+        if (!background->image.loadFromFile(input_file_path)) {
+            throw runtime_error("Could not load texture " + input_file_path.string());
+        }
+        return background;
+    }
+
+    shared_ptr<BaseRendererContext> SfmlRenderer::create_context(const Observer& observer,
+                                                                 const BaseBackground& background) const {
+        return make_shared<SfmlRendererContext>(observer, dynamic_cast<const SfmlBackground&>(background),
+                                                this->_shader, _options);
     }
 }
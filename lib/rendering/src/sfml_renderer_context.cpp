@@ -13,10 +13,10 @@ namespace rcsop::rendering {
 
     static inline void fill_background(
             RenderTarget& render_target,
-            const path& input_file_path) {
+            const SfmlBackground& source) {
         SfmlTexture background;
-        if (!background.loadFromFile(input_file_path)) {
-            throw runtime_error("Could not load texture " + input_file_path.string());
+        if (!background.loadFromImage(source.image)) {
+            throw runtime_error("Could not upload background texture.");
         }
 
         Sprite background_sprite;
@@ -27,6 +27,7 @@ namespace rcsop::rendering {
     }
 
     SfmlRendererContext::SfmlRendererContext(const Observer& observer,
+                                             const SfmlBackground& background,
                                              shared_ptr<Shader> shader,
                                              const gradient_options& options)
             : _options(options),
@@ -36,7 +37,7 @@ namespace rcsop::rendering {
         if (!this->_render_target->create(camera.image_width(), camera.image_height())) {
             throw runtime_error("Could not create render texture.");
         }
-        fill_background(*_render_target, observer.source_image_path());
+        fill_background(*_render_target, background);
     }
 
     void SfmlRendererContext::render_point(const rendered_point& point) {
@@ -104,12 +105,18 @@ namespace rcsop::rendering {
         _render_target->draw(shape);
     }
 
-    void SfmlRendererContext::write_to_image(const path& output_path) {
+    shared_ptr<const BaseRenderedImage> SfmlRendererContext::finish() {
         _render_target->display();
 
-        const auto output_texture = _render_target->getTexture();
-        auto output_image = output_texture.copyToImage();
+        // the download from the GPU stays on the thread of the render texture, only the encoding is handed over
+        auto rendered_image = make_shared<SfmlRenderedImage>();
+        rendered_image->image = _render_target->getTexture().copyToImage();
+        return rendered_image;
+    }
 
-        output_image.saveToFile(output_path);
+    void SfmlRenderedImage::write_to_image(const path& output_path) const {
+        if (!image.saveToFile(output_path)) {
+            throw runtime_error("Could not write the image " + output_path.string());
+        }
     }
 }
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+#include "utils/types.h"
+#include "utils/executor.h"
+#include "render_pipeline.h"
+
+using rcsop::rendering::render_job;
+using rcsop::rendering::render_pipelined;
+using rcsop::rendering::rendered_observer_image;
+using rcsop::rendering::PipelinedImageWriter;
+using rcsop::rendering::BaseBackground;
+using rcsop::common::utils::parallel::configure_executor;
+
+enum class failing_step {
+    NONE,
+    DECODE,
+    RASTERIZE,
+    ENCODE,
+};
+
+/**
+ * Events of all jobs of one test, the steps of the jobs run on different threads.
+ */
+struct pipeline_log {
+    std::mutex lock;
+    vector<size_t> rasterized_jobs;
+    vector<std::thread::id> rasterizing_threads;
+    vector<size_t> encoded_jobs;
+    set<std::thread::id> threads;
+};
+
+class FakeImageWriter : public PipelinedImageWriter {
+private:
+    size_t _job_index;
+    failing_step _failing_step;
+    pipeline_log& _log;
+    shared_ptr<const BaseBackground> _background = nullptr;
+
+    void fail_in(failing_step step) const {
+        if (_failing_step == step) {
+            throw runtime_error("job " + std::to_string(_job_index) + " failed");
+        }
+    }
+
+public:
+    FakeImageWriter(size_t job_index, failing_step failing_step, pipeline_log& log)
+            : _job_index(job_index), _failing_step(failing_step), _log(log) {}
+
+    void write(const path& output_path, const string& log_prefix) override {
+        use_background(decode_background());
+        write_image(rasterize(), output_path, log_prefix);
+    }
+
+    [[nodiscard]] auto decode_background() const -> shared_ptr<const BaseBackground> override {
+        {
+            const std::lock_guard guard(_log.lock);
+            _log.threads.insert(std::this_thread::get_id());
+        }
+        fail_in(failing_step::DECODE);
+        return make_shared<BaseBackground>();
+    }
+
+    void use_background(shared_ptr<const BaseBackground> background) override {
+        _background = std::move(background);
+    }
+
+    [[nodiscard]] auto rasterize() const -> rendered_observer_image override {
+        EXPECT_NE(_background, nullptr);
+        fail_in(failing_step::RASTERIZE);
+        const std::lock_guard guard(_log.lock);
+        _log.rasterized_jobs.push_back(_job_index);
+        _log.rasterizing_threads.push_back(std::this_thread::get_id());
+        _log.threads.insert(std::this_thread::get_id());
+        return {.image = nullptr, .point_count = _job_index, .render_start = {}};
+    }
+
+    void write_image(const rendered_observer_image& rendered,
+                     const path& output_path,
+                     const string& log_prefix) const override {
+        fail_in(failing_step::ENCODE);
+        // the image and the destination of the same job
+        EXPECT_EQ(rendered.point_count, _job_index);
+        EXPECT_EQ(output_path, path{"job-" + std::to_string(_job_index)});
+        const std::lock_guard guard(_log.lock);
+        _log.encoded_jobs.push_back(_job_index);
+        _log.threads.insert(std::this_thread::get_id());
+    }
+};
+
+class RenderPipelineTest : public ::testing::TestWithParam<size_t> {
+protected:
+    pipeline_log _log;
+
+    void SetUp() override {
+        configure_executor({.threads = GetParam()});
+    }
+
+    void TearDown() override {
+        configure_executor({});
+    }
+
+    auto jobs(size_t count, size_t failing_job = 0, failing_step step = failing_step::NONE) -> vector<render_job> {
+        vector<render_job> result;
+        for (size_t index = 0; index < count; index++) {
+            result.push_back({
+                    .renderer = make_shared<FakeImageWriter>(index, index == failing_job ? step : failing_step::NONE,
+                                                             _log),
+                    .output_path = path{"job-" + std::to_string(index)},
+                    .log_prefix = "",
+            });
+        }
+        return result;
+    }
+};
+
+TEST_P(RenderPipelineTest, RasterizesInOrderOnTheCallingThreadAndEncodesEveryJobOnce) {
+    const size_t job_count = 25;
+    render_pipelined(jobs(job_count));
+
+    vector<size_t> expected(job_count);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(_log.rasterized_jobs, expected);
+    for (const auto& thread: _log.rasterizing_threads) {
+        EXPECT_EQ(thread, std::this_thread::get_id());
+    }
+    // the encoders may finish in another order
+    std::sort(_log.encoded_jobs.begin(), _log.encoded_jobs.end());
+    EXPECT_EQ(_log.encoded_jobs, expected);
+    // the stages stay within the thread limit of the executor
+    EXPECT_LE(_log.threads.size(), GetParam());
+}
+
+TEST_P(RenderPipelineTest, RethrowsTheErrorOfEveryStage) {
+    for (const auto step: {failing_step::DECODE, failing_step::RASTERIZE, failing_step::ENCODE}) {
+        _log.rasterized_jobs.clear();
+        _log.encoded_jobs.clear();
+        const size_t failing_job = 7;
+        try {
+            render_pipelined(jobs(25, failing_job, step));
+            ADD_FAILURE() << "no error for step " << static_cast<int>(step);
+        } catch (const runtime_error& error) {
+            EXPECT_EQ(string(error.what()), "job 7 failed");
+        }
+        // the stages stop at the error instead of drawing all remaining jobs
+        EXPECT_LT(_log.rasterized_jobs.size(), 25);
+        EXPECT_TRUE(std::find(_log.encoded_jobs.cbegin(), _log.encoded_jobs.cend(), failing_job)
+                    == _log.encoded_jobs.cend());
+    }
+}
+
+TEST_P(RenderPipelineTest, AcceptsNoJobs) {
+    render_pipelined({});
+    EXPECT_TRUE(_log.rasterized_jobs.empty());
+}
+
+// one thread writes the jobs one after the other, two decode ahead of the calling thread, more also encode apart
+INSTANTIATE_TEST_SUITE_P(Threads, RenderPipelineTest, ::testing::Values(1, 2, 4));